@@ -0,0 +1,72 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <utility>
+
+namespace helpers {
+/// Cache holding at most N values. If full, the least recently used value is evicted on insertion.
+template<typename T_Key, typename T_Value, class T_Hash = boost::hash<T_Key>>
+class LRUCache
+{
+    using Entry = std::pair<T_Key, T_Value>;
+    using EntryList = std::list<Entry>;
+
+    size_t maxSize_;
+    /// Entries in order of usage, most recently used first
+    EntryList entries_;
+    boost::unordered_map<T_Key, typename EntryList::iterator, T_Hash> lookup_;
+
+public:
+    explicit LRUCache(size_t maxSize) : maxSize_(maxSize) { lookup_.reserve(maxSize); }
+
+    /// Return the value for the key or nullptr if not found. Marks the entry as most recently used
+    T_Value* find(const T_Key& key) { return find(key, lookup_.hash_function(), std::equal_to<T_Key>()); }
+
+    /// Find using a key of a different type which must hash equal to the corresponding T_Key, e.g. a view.
+    /// Avoids constructing a T_Key on lookup
+    template<class T_CompatibleKey, class T_CompatibleHash, class T_CompatibleEqual>
+    T_Value* find(const T_CompatibleKey& key, const T_CompatibleHash& hash, const T_CompatibleEqual& equal)
+    {
+        const auto it = lookup_.find(key, hash, equal);
+        if(it == lookup_.end())
+            return nullptr;
+        // Move to front, iterators stay valid
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return &it->second->second;
+    }
+
+    /// Add a new value for the key and return a reference to it. The key must not exist yet.
+    /// Memory of an evicted entry is reused if possible.
+    T_Value& insert(const T_Key& key, T_Value value)
+    {
+        if(!entries_.empty() && entries_.size() >= maxSize_)
+        {
+            auto itLast = std::prev(entries_.end());
+            lookup_.erase(itLast->first);
+            itLast->first = key;
+            itLast->second = std::move(value);
+            entries_.splice(entries_.begin(), entries_, itLast);
+        } else
+            entries_.emplace_front(key, std::move(value));
+        lookup_[key] = entries_.begin();
+        return entries_.front().second;
+    }
+
+    void clear()
+    {
+        lookup_.clear();
+        entries_.clear();
+    }
+    size_t size() const { return entries_.size(); }
+    size_t max_size() const { return maxSize_; }
+};
+} // namespace helpers
@@ -0,0 +1,89 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "helpers/ThreadPool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace helpers {
+
+/// Return the number of threads to use for parallel work by default
+inline unsigned getDefaultNumThreads()
+{
+    return ThreadPool::getDefault().getNumThreads() + 1u;
+}
+
+/// Call func(i) for each i in [begin, end). Consecutive chunks of the range are processed by up to numThreads threads
+/// (0: use the default) with at least minItemsPerThread items each. The calling thread processes the first chunk, the
+/// others are executed by the threads of the default ThreadPool, so no threads are created per call.
+/// func must be safe to be called concurrently for different values of i.
+/// The first exception thrown in any thread is rethrown after all threads finished.
+template<typename T, class T_Func>
+void parallelFor(const T begin, const T end, T_Func&& func, unsigned numThreads = 0, unsigned minItemsPerThread = 1)
+{
+    if(!(begin < end))
+        return;
+    const auto numItems = static_cast<unsigned>(end - begin);
+    if(numThreads == 0)
+        numThreads = getDefaultNumThreads();
+    numThreads = std::max(1u, std::min(numThreads, numItems / std::max(1u, minItemsPerThread)));
+    const unsigned chunkSize = (numItems + numThreads - 1) / numThreads;
+
+    const auto processChunk = [&func, begin, end, chunkSize](unsigned chunk) {
+        const T chunkBegin = begin + static_cast<T>(chunk * chunkSize);
+        const T chunkEnd = std::min<T>(end, chunkBegin + static_cast<T>(chunkSize));
+        for(T i = chunkBegin; i < chunkEnd; ++i)
+            func(i);
+    };
+    if(numThreads == 1)
+    {
+        processChunk(0);
+        return;
+    }
+
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    std::mutex mutex;
+    std::condition_variable chunkDone;
+    unsigned numPendingChunks = numThreads - 1;
+    ThreadPool& pool = ThreadPool::getDefault();
+    for(unsigned chunk = 1; chunk < numThreads; ++chunk)
+    {
+        pool.push([&processChunk, &exceptions, &mutex, &chunkDone, &numPendingChunks, chunk]() {
+            try
+            {
+                processChunk(chunk);
+            } catch(...)
+            {
+                exceptions[chunk] = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if(--numPendingChunks == 0)
+                chunkDone.notify_all();
+        });
+    }
+    try
+    {
+        processChunk(0);
+    } catch(...)
+    {
+        exceptions[0] = std::current_exception();
+    }
+    // Help with the remaining chunks (also required if the pool has no threads)
+    while(pool.runPendingTask()) {}
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        chunkDone.wait(lock, [&numPendingChunks]() { return numPendingChunks == 0; });
+    }
+    for(const std::exception_ptr& e : exceptions)
+    {
+        if(e)
+            std::rethrow_exception(e);
+    }
+}
+} // namespace helpers
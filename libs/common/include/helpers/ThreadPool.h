@@ -0,0 +1,44 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace helpers {
+
+/// Set of worker threads which are started once and then execute the pushed tasks.
+/// Avoids creating threads for each parallel operation
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned numThreads);
+    /// Finishes all pending tasks
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Pool with one thread less than the hardware supports as the calling thread works too. Created on first use
+    static ThreadPool& getDefault();
+
+    unsigned getNumThreads() const { return static_cast<unsigned>(threads_.size()); }
+    void push(std::function<void()> task);
+    /// Execute one pending task in the calling thread. Return false if there was none
+    bool runPendingTask();
+
+private:
+    void run();
+
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable taskAdded_;
+    bool stop_ = false;
+};
+} // namespace helpers
@@ -0,0 +1,73 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/ThreadPool.h"
+#include <algorithm>
+#include <utility>
+
+namespace helpers {
+ThreadPool::ThreadPool(unsigned numThreads)
+{
+    threads_.reserve(numThreads);
+    for(unsigned i = 0; i < numThreads; i++)
+        threads_.emplace_back([this]() { run(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    taskAdded_.notify_all();
+    for(std::thread& thread : threads_)
+        thread.join();
+}
+
+ThreadPool& ThreadPool::getDefault()
+{
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1u);
+    return pool;
+}
+
+void ThreadPool::push(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    taskAdded_.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(tasks_.empty())
+            return false;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::run()
+{
+    while(true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskAdded_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if(tasks_.empty())
+                return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+} // namespace helpers
@@ -79,12 +79,15 @@ bool LuaInterfaceBase::loadScriptString(const std::string& script, bool rethrowE
         return false;
     try
     {
-        if(!lua.dostring(script))
+        const bool success = lua.dostring(script);
+        onScriptLoaded();
+        if(!success)
             return false;
         else
             script_ = script;
     } catch(LuaExecutionError&)
     {
+        onScriptLoaded();
         if(rethrowError)
             throw;
         return false;
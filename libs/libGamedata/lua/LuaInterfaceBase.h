@@ -46,6 +46,8 @@ protected:
     std::string script_;
 
     bool validateUTF8(const std::string& scriptTxt);
+    /// Called after a script was executed (even if it failed) as it might have changed global functions
+    virtual void onScriptLoaded() {}
 
     /// Write a string to log and stdout
     void log(const std::string& msg);
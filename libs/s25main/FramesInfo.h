@@ -4,13 +4,15 @@
 
 #pragma once
 
+#include "Clock.h"
 #include <chrono>
 
 /// Struct that stores information about the frames, like GF status...
 struct FramesInfo
 {
     using milliseconds32_t = std::chrono::duration<uint32_t, std::milli>; //-V:milliseconds32_t:813
-    using UsedClock = std::chrono::steady_clock;
+    /// Mockable for tests
+    using UsedClock = Clock;
 
     FramesInfo();
     void Clear();
@@ -0,0 +1,25 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GFTimeBudget.h"
+#include <algorithm>
+
+GFTimeBudget::GFTimeBudget(Clock::duration maxTime)
+    : maxTime_(maxTime), maxGFTime_(Clock::duration::zero()), startTime_(Clock::now()), lastGFStartTime_(startTime_),
+      numGFs_(0)
+{}
+
+bool GFTimeBudget::startGF()
+{
+    const Clock::time_point now = Clock::now();
+    if(numGFs_ > 0)
+    {
+        maxGFTime_ = std::max(maxGFTime_, now - lastGFStartTime_);
+        if(now - startTime_ + maxGFTime_ > maxTime_)
+            return false;
+    }
+    lastGFStartTime_ = now;
+    ++numGFs_;
+    return true;
+}
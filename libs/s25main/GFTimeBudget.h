@@ -0,0 +1,32 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Clock.h"
+
+/// Limits the time spent executing due GFs in one call (e.g. per drawn frame) when the game has to catch up.
+/// A GF is only started if it is expected to finish within the budget using the longest GF of this call as estimate.
+/// The first GF is always allowed so the game progresses even when a single GF takes longer than the budget.
+/// Hence the budget is only exceeded by a GF taking longer than all GFs before it in the same call.
+class GFTimeBudget
+{
+public:
+    /// Start measuring the time from now on
+    explicit GFTimeBudget(Clock::duration maxTime);
+
+    /// Return true if the next GF may be executed. Must be called right before executing it
+    bool startGF();
+    /// Number of GFs started so far
+    unsigned getNumGFs() const { return numGFs_; }
+    /// Longest GF measured so far
+    Clock::duration getMaxGFTime() const { return maxGFTime_; }
+
+private:
+    const Clock::duration maxTime_;
+    Clock::duration maxGFTime_;
+    const Clock::time_point startTime_;
+    Clock::time_point lastGFStartTime_;
+    unsigned numGFs_;
+};
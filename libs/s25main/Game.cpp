@@ -88,7 +88,10 @@ void Game::RunGF()
     }
 
     if(world_.HasLua())
+    {
         world_.GetLua().EventGameFrame(em_->GetCurrentGF());
+        world_.GetLua().SendBatchedEvents();
+    }
     // Update statistic every 30 seconds
     constexpr unsigned GFsIn30s = std::chrono::duration<unsigned>(30) / SPEED_GF_LENGTHS[referenceSpeed];
     if(em_->GetCurrentGF() % GFsIn30s == 0)
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "ObjectPool.h"
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 #include <RTTR_Assert.h>
 #include <cstdint>
@@ -60,7 +61,8 @@ constexpr auto maxEnumValue(GCType)
     return GCType::NotifyAlliesOfLocation;
 }
 
-class GameCommand
+/// Base class of all game commands. Allocated from the ObjectPool as many are created (and destroyed) every NWF
+class GameCommand : public PoolAllocated
 {
 private:
     /// Type of this command
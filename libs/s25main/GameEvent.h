@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include "ObjectPool.h"
+
 class GameObject;
 class SerializedGameData;
 
-class GameEvent
+class GameEvent : public PoolAllocated
 {
     const unsigned instanceId; /// unique ID
 public:
@@ -22,6 +22,7 @@
 #include "helpers/mathFuncs.h"
 #include "lua/LuaInterfaceGame.h"
 #include "notifications/ToolNote.h"
+#include "pathfinding/RoadNetworkComponents.h"
 #include "pathfinding/RoadPathFinder.h"
 #include "postSystem/DiplomacyPostQuestion.h"
 #include "postSystem/PostManager.h"
@@ -43,9 +44,18 @@
 #include "gameData/ShieldConsts.h"
 #include "gameData/ToolConsts.h"
 #include "s25util/Log.h"
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
+namespace {
+/// Wares get registered on creation, so this is their order in the ware list
+bool isCreatedBefore(const Ware* lhs, const Ware* rhs)
+{
+    return lhs->GetObjId() < rhs->GetObjId();
+}
+} // namespace
+
 GamePlayer::GamePlayer(unsigned playerId, const PlayerInfo& playerInfo, GameWorld& world)
     : GamePlayerInfo(playerId, playerInfo), world(world), hqPos(MapPoint::Invalid()), emergency(false)
 {
@@ -250,6 +260,13 @@ void GamePlayer::Deserialize(SerializedGameData& sgd)
         buildings.Deserialize2(sgd);
 
     sgd.PopObjectContainer(ware_list, GO_Type::Ware);
+    for(auto& wares : lostWares)
+        wares.clear();
+    for(Ware* ware : ware_list)
+    {
+        if(ware->IsLostWare())
+            AddLostWare(*ware);
+    }
     sgd.PopObjectContainer(flagworkers);
     sgd.PopObjectContainer(ships, GO_Type::Ship);
 
@@ -392,6 +409,7 @@ void GamePlayer::AddBuilding(noBuilding* bld, BuildingType bldType)
 
     if(bldType == BuildingType::HarborBuilding)
     {
+        InvalidateShipConnections();
         // Schiff durchgehen und denen Bescheid sagen
         for(noShip* ship : ships)
             ship->NewHarborBuilt(static_cast<nobHarborBuilding*>(bld));
@@ -412,7 +430,9 @@ void GamePlayer::RemoveBuilding(noBuilding* bld, BuildingType bldType)
     buildings.Remove(bld, bldType);
     ChangeStatisticValue(StatisticType::Buildings, -1);
     if(bldType == BuildingType::HarborBuilding)
-    { // Schiffen Bescheid sagen
+    {
+        InvalidateShipConnections();
+        // Schiffen Bescheid sagen
         for(noShip* ship : ships)
             ship->HarborDestroyed(static_cast<nobHarborBuilding*>(bld));
     } else if(bldType == BuildingType::Headquarters)
@@ -476,7 +496,12 @@ void GamePlayer::DeleteRoad(RoadSegment* rs)
 void GamePlayer::FindClientForLostWares()
 {
     // Alle Lost-Wares müssen gucken, ob sie ein Lagerhaus finden
-    for(Ware* ware : ware_list)
+    // Checked in the order of ware_list as the found warehouses depend on the wares handled before
+    std::vector<Ware*> wares;
+    for(const std::vector<Ware*>& curLostWares : lostWares)
+        wares.insert(wares.end(), curLostWares.begin(), curLostWares.end());
+    std::sort(wares.begin(), wares.end(), isCreatedBefore);
+    for(Ware* ware : wares)
     {
         if(ware->IsLostWare())
         {
@@ -484,19 +509,25 @@ void GamePlayer::FindClientForLostWares()
                 ware->CallCarrier();
         }
     }
+    for(std::vector<Ware*>& curLostWares : lostWares)
+        helpers::erase_if(curLostWares, [](const Ware* ware) { return !ware->IsLostWare(); });
 }
 
 void GamePlayer::RoadDestroyed()
 {
     // Alle Waren, die an Flagge liegen und in Lagerhäusern, müssen gucken, ob sie ihr Ziel noch erreichen können, jetzt
     // wo eine Straße fehlt
+    // Wares in other parts of the road network can't reach their goal, so we can avoid the (expensive, failing) path
+    // search. Successful searches are still done per ware as the costs depend on the wares rerouted before.
+    RoadNetworkComponents roadComponents;
     for(auto it = ware_list.begin(); it != ware_list.end();)
     {
         Ware* ware = *it;
         if(ware->IsWaitingAtFlag()) // Liegt die Flagge an einer Flagge, muss ihr Weg neu berechnet werden
         {
             RoadPathDirection last_next_dir = ware->GetNextDir();
-            ware->RecalcRoute();
+            const noBaseBuilding* goal = ware->GetGoal();
+            ware->RecalcRoute(goal && roadComponents.isUnreachable(*ware->GetLocation(), *goal));
             // special case: ware was lost some time ago and the new goal is at this flag and not a warehouse,hq,harbor
             // and the "flip-route" picked so a carrier would pick up the ware carry it away from goal then back and
             // drop  it off at the goal was just destroyed?
@@ -542,13 +573,22 @@ void GamePlayer::RoadDestroyed()
             }
         } else if(ware->IsWaitingInWarehouse())
         {
-            if(!ware->IsRouteToGoal())
+            const noBaseBuilding* goal = ware->GetGoal();
+            bool hasRoute;
+            if(!goal || goal == ware->GetLocation())
+                hasRoute = ware->IsRouteToGoal();
+            else if(roadComponents.isUnreachable(*ware->GetLocation(), *goal))
+                hasRoute = false;
+            else
+                hasRoute = roadComponents.isReachable(*ware->GetLocation(), *goal) || ware->IsRouteToGoal();
+            if(!hasRoute)
             {
                 // Das Ziel wird nun nich mehr beliefert
                 ware->NotifyGoalAboutLostWare();
                 // Ware aus der Warteliste des Lagerhauses entfernen
                 static_cast<nobBaseWarehouse*>(ware->GetLocation())->CancelWare(ware);
                 // Ware aus der Liste raus
+                helpers::erase(lostWares[ware->type], ware);
                 it = ware_list.erase(it);
                 continue;
             }
@@ -813,19 +853,41 @@ Ware* GamePlayer::OrderWare(const GoodType ware, noBaseBuilding* goal)
         }
     } else // no warehouse can deliver the ware -> check all our wares for lost wares that might match the order
     {
+        // Candidates are lost wares at flags. The path length is at least the distance to the goal, so check the
+        // candidates by increasing distance and stop when no better one can be found.
+        // Ties are resolved by the order in the ware list to get the same ware as checking all of them.
+        struct Candidate
+        {
+            unsigned minLength, idx;
+            Ware* ware;
+        };
+        std::vector<Candidate> candidates;
+        const std::vector<Ware*>& wares = lostWares[ware];
+        const MapPoint goalFlagPos = goal->GetFlagPos();
+        for(unsigned i = 0; i < wares.size(); i++)
+        {
+            Ware* curWare = wares[i];
+            if(curWare->IsLostWare() && curWare->IsWaitingAtFlag())
+                candidates.push_back({world.CalcDistance(curWare->GetLocation()->GetPos(), goalFlagPos), i, curWare});
+        }
+        std::stable_sort(candidates.begin(), candidates.end(),
+                         [](const Candidate& lhs, const Candidate& rhs) { return lhs.minLength < rhs.minLength; });
+
         unsigned bestLength = std::numeric_limits<unsigned>::max();
+        unsigned bestIdx = 0;
         Ware* bestWare = nullptr;
-        for(Ware* curWare : ware_list)
+        for(const Candidate& candidate : candidates)
         {
-            if(curWare->IsLostWare() && curWare->type == ware)
+            if(bestWare
+               && (candidate.minLength > bestLength || (candidate.minLength == bestLength && candidate.idx > bestIdx)))
+                break;
+            // got a lost ware with a road to goal -> find best
+            const unsigned curLength = candidate.ware->CheckNewGoalForLostWare(*goal);
+            if(curLength < bestLength || (bestWare && curLength == bestLength && candidate.idx < bestIdx))
             {
-                // got a lost ware with a road to goal -> find best
-                unsigned curLength = curWare->CheckNewGoalForLostWare(*goal);
-                if(curLength < bestLength)
-                {
-                    bestLength = curLength;
-                    bestWare = curWare;
-                }
+                bestLength = curLength;
+                bestIdx = candidate.idx;
+                bestWare = candidate.ware;
             }
         }
         if(bestWare)
@@ -1722,6 +1784,26 @@ void GamePlayer::MakeStartPacts()
     }
 }
 
+void GamePlayer::RegisterWare(Ware& ware)
+{
+    ware_list.push_back(&ware);
+}
+
+void GamePlayer::RemoveWare(Ware& ware)
+{
+    RTTR_Assert(IsWareRegistred(ware));
+    ware_list.remove(&ware);
+    helpers::erase(lostWares[ware.type], &ware);
+}
+
+void GamePlayer::AddLostWare(Ware& ware)
+{
+    std::vector<Ware*>& wares = lostWares[ware.type];
+    const auto it = std::lower_bound(wares.begin(), wares.end(), &ware, isCreatedBefore);
+    if(it == wares.end() || *it != &ware)
+        wares.insert(it, &ware);
+}
+
 bool GamePlayer::IsWareRegistred(const Ware& ware)
 {
     return helpers::contains(ware_list, &ware);
@@ -1945,6 +2027,12 @@ void GamePlayer::GetHarborsAtSea(std::vector<nobHarborBuilding*>& harbor_buildin
     }
 }
 
+void GamePlayer::InvalidateShipConnections()
+{
+    for(nobHarborBuilding* harbor : buildings.GetHarbors())
+        harbor->InvalidateShipConnections();
+}
+
 /// Gibt die Anzahl der Schiffe, die einen bestimmten Hafen ansteuern, zurück
 unsigned GamePlayer::GetShipsToHarbor(const nobHarborBuilding& hb) const
 {
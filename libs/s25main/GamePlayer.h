@@ -19,6 +19,7 @@
 #include <array>
 #include <list>
 #include <memory>
+#include <vector>
 
 enum class Direction : uint8_t;
 class GameWorld;
@@ -166,12 +167,10 @@ public:
     void ConvertTransportData(const TransportOrders& transport_data);
 
     /// Ware zur globalen Warenliste hinzufügen und entfernen
-    void RegisterWare(Ware& ware) { ware_list.push_back(&ware); }
-    void RemoveWare(Ware& ware)
-    {
-        RTTR_Assert(IsWareRegistred(ware));
-        ware_list.remove(&ware);
-    }
+    void RegisterWare(Ware& ware);
+    void RemoveWare(Ware& ware);
+    /// Remembers a ware which has no goal (anymore), so it is checked by FindClientForLostWares and OrderWare
+    void AddLostWare(Ware& ware);
     bool IsWareRegistred(const Ware& ware);
     bool IsWareDependent(const Ware& ware);
 
@@ -245,6 +244,8 @@ public:
     const std::vector<noShip*>& GetShips() const { return ships; }
     /// Gibt eine Liste mit allen Häfen dieses Spieler zurück, die an ein bestimmtes Meer angrenzen
     void GetHarborsAtSea(std::vector<nobHarborBuilding*>& harbor_buildings, unsigned short seaId) const;
+    /// Make all harbors recalculate their ship connections, e.g. when a harbor was built or destroyed
+    void InvalidateShipConnections();
     /// Gibt die Anzahl der Schiffe, die einen bestimmten Hafen ansteuern, zurück
     unsigned GetShipsToHarbor(const nobHarborBuilding& hb) const;
     /// Sucht einen Hafen in der Nähe, wo dieses Schiff seine Waren abladen kann
@@ -354,6 +355,8 @@ private:
 
     /// Liste von sämtlichen Waren, die herumgetragen werden und an Fahnen liegen
     std::list<Ware*> ware_list;
+    /// Lost wares by their type (in the order of ware_list). May contain wares which got a goal since the last check
+    helpers::EnumArray<std::vector<Ware*>, GoodType> lostWares;
     /// Liste von Geologen und Spähern, die an eine Flagge gebunden sind
     std::list<nofFlagWorker*> flagworkers;
     /// Liste von Schiffen dieses Spielers
@@ -6,11 +6,13 @@
 #include "FOWObjects.h"
 #include "GamePlayer.h"
 #include "RttrForeachPt.h"
+#include "helpers/ParallelFor.h"
 #include "world/GameWorldBase.h"
 #include "world/GameWorldViewer.h"
 #include "gameData/MinimapConsts.h"
 #include "gameData/TerrainDesc.h"
 #include "libsiedler2/ColorBGRA.h"
+#include <array>
 
 IngameMinimap::IngameMinimap(const GameWorldViewer& gwv)
     : Minimap(gwv.GetWorld().GetSize()), gwv(gwv), nodes_updated(GetMapSize().x * GetMapSize().y, false),
@@ -56,7 +58,7 @@ unsigned IngameMinimap::CalcPixelColor(const MapPoint pt, const unsigned t)
         // Baum an dieser Stelle?
         if((!fow && noType == NodalObjectType::Tree) || (fow && fot == FoW_Type::Tree)) //-V807
         {
-            color = VaryBrightness(TREE_COLOR, VARY_TREE_COLOR);
+            color = VaryBrightness(TREE_COLOR, VARY_TREE_COLOR, pt, t);
             drawn_object = DrawnObject::Terrain;
             // Ggf. mit Spielerfarbe
             if(owner)
@@ -69,7 +71,7 @@ unsigned IngameMinimap::CalcPixelColor(const MapPoint pt, const unsigned t)
         // Granit an dieser Stelle?
         else if((!fow && noType == NodalObjectType::Granite) || (fow && fot == FoW_Type::Granite))
         {
-            color = VaryBrightness(GRANITE_COLOR, VARY_GRANITE_COLOR);
+            color = VaryBrightness(GRANITE_COLOR, VARY_GRANITE_COLOR, pt, t);
             drawn_object = DrawnObject::Terrain;
             // Ggf. mit Spielerfarbe
             if(owner)
@@ -199,6 +201,8 @@ void IngameMinimap::BeforeDrawing()
 {
     // Ab welcher Knotenanzahl (Teil der Gesamtknotenanzahl) die Textur komplett neu erstellt werden soll
     static const unsigned MAX_NODES_UPDATE_DENOMINATOR = 2; // (2 = 1/2, 3 = 1/3 usw.)
+    // Don't start threads for only a few nodes
+    static const unsigned MIN_NODES_PER_THREAD = 512;
 
     if(!nodesToUpdate.empty())
     {
@@ -210,17 +214,24 @@ void IngameMinimap::BeforeDrawing()
             std::fill(nodes_updated.begin(), nodes_updated.end(), false);
         } else
         {
+            // Calculate the colors in parallel, as each node is only contained once
+            std::vector<std::array<unsigned, 2>> colors(nodesToUpdate.size());
+            helpers::parallelFor(
+              size_t(0), nodesToUpdate.size(),
+              [this, &colors](size_t i) {
+                  for(unsigned t = 0; t < 2; ++t)
+                      colors[i][t] = CalcPixelColor(nodesToUpdate[i], t);
+              },
+              0, MIN_NODES_PER_THREAD);
+
             map.beginUpdate();
             // Entsprechende Pixel updaten
-            for(auto& it : nodesToUpdate)
+            for(unsigned i = 0; i < nodesToUpdate.size(); ++i)
             {
+                const MapPoint pt = nodesToUpdate[i];
                 for(unsigned t = 0; t < 2; ++t)
-                {
-                    unsigned color = CalcPixelColor(it, t);
-                    DrawPoint texPos((it.x * 2 + t + (it.y & 1)) % (GetMapSize().x * 2), it.y);
-                    map.updatePixel(texPos, libsiedler2::ColorBGRA(color));
-                }
-                nodes_updated[GetMMIdx(it)] = false;
+                    map.updatePixel(GetTexPos(pt, t), libsiedler2::ColorBGRA(colors[i][t]));
+                nodes_updated[GetMMIdx(pt)] = false;
             }
             map.endUpdate();
         }
@@ -243,22 +254,40 @@ void IngameMinimap::UpdateAll()
  */
 void IngameMinimap::UpdateAll(const DrawnObject drawn_object)
 {
+    const MapExtent size = GetMapSize();
+    // Gesamte Karte neu berechnen. Rows are calculated in parallel and 0 marks unchanged pixels.
+    std::vector<unsigned> colors(size.x * size.y * 2u, 0);
+    // Small maps are not worth the synchronization overhead
+    static const unsigned MIN_ROWS_PER_THREAD = 32;
+    helpers::parallelFor(
+      0u, static_cast<unsigned>(size.y),
+      [this, drawn_object, size, &colors](unsigned y) {
+          for(MapPoint pt(0, static_cast<MapCoord>(y)); pt.x < size.x; ++pt.x)
+          {
+              for(unsigned t = 0; t < 2; ++t)
+              {
+                  const DrawnObject curDO = dos[GetMMIdx(pt)];
+                  if(curDO == drawn_object
+                     || (drawn_object == DrawnObject::Player && // for DrawnObject::Player check for not drawn buildings
+                                                                // or roads as there is only the player territory visible
+                         ((curDO == DrawnObject::Buidling && !houses) || (curDO == DrawnObject::Road && !roads))))
+                  {
+                      // Alpha is always set, so 0 is never a valid color
+                      colors[GetMMIdx(pt) * 2u + t] = CalcPixelColor(pt, t);
+                  }
+              }
+          }
+      },
+      0, MIN_ROWS_PER_THREAD);
+
     map.beginUpdate();
-    // Gesamte Karte neu berechnen
-    RTTR_FOREACH_PT(MapPoint, GetMapSize())
+    RTTR_FOREACH_PT(MapPoint, size)
     {
         for(unsigned t = 0; t < 2; ++t)
         {
-            if(dos[GetMMIdx(pt)] == drawn_object
-               || (drawn_object == DrawnObject::Player && // for DrawnObject::Player check for not drawn buildings or
-                                                          // roads as there is only the player territory visible
-                   ((dos[GetMMIdx(pt)] == DrawnObject::Buidling && !houses)
-                    || (dos[GetMMIdx(pt)] == DrawnObject::Road && !roads))))
-            {
-                unsigned color = CalcPixelColor(pt, t);
-                DrawPoint texPos((pt.x * 2 + t + (pt.y & 1)) % (GetMapSize().x * 2), pt.y);
-                map.updatePixel(texPos, libsiedler2::ColorBGRA(color));
-            }
+            const unsigned color = colors[GetMMIdx(pt) * 2u + t];
+            if(color != 0)
+                map.updatePixel(GetTexPos(pt, t), libsiedler2::ColorBGRA(color));
         }
     }
     map.endUpdate();
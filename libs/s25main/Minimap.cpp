@@ -3,8 +3,14 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "Minimap.h"
-#include "RttrForeachPt.h"
+#include "helpers/ParallelFor.h"
 #include "libsiedler2/PixelBufferBGRA.h"
+#include <cstdint>
+
+namespace {
+/// Small maps are not worth the synchronization overhead
+constexpr unsigned MIN_ROWS_PER_THREAD = 32;
+} // namespace
 
 Minimap::Minimap(const MapExtent& mapSize) : mapSize(mapSize) {}
 
@@ -14,22 +20,32 @@ void Minimap::CreateMapTexture()
 
     /// Buffer für die Daten erzeugen
     libsiedler2::PixelBufferBGRA buffer(mapSize.x * 2, mapSize.y);
-
-    RTTR_FOREACH_PT(MapPoint, mapSize)
-    {
-        // Die 2. Terraindreiecke durchgehen
-        for(unsigned t = 0; t < 2; ++t)
-        {
-            libsiedler2::ColorBGRA color(CalcPixelColor(pt, t));
-            unsigned xCoord = (pt.x * 2 + t + (pt.y & 1)) % buffer.getWidth();
-            buffer.set(xCoord, pt.y, color);
-        }
-    }
+    CalcMapColors(buffer);
 
     map.setInterpolateTexture(false);
     map.create(buffer);
 }
 
+void Minimap::CalcMapColors(libsiedler2::PixelBufferBGRA& buffer, unsigned numThreads)
+{
+    RTTR_Assert(buffer.getWidth() == mapSize.x * 2u && buffer.getHeight() == mapSize.y);
+    // Each row writes only to its own part of the buffer
+    helpers::parallelFor(
+      0u, static_cast<unsigned>(mapSize.y),
+      [this, &buffer](unsigned y) {
+          for(MapPoint pt(0, static_cast<MapCoord>(y)); pt.x < mapSize.x; ++pt.x)
+          {
+              // Die 2. Terraindreiecke durchgehen
+              for(unsigned t = 0; t < 2; ++t)
+              {
+                  const DrawPoint texPos = GetTexPos(pt, t);
+                  buffer.set(texPos.x, texPos.y, libsiedler2::ColorBGRA(CalcPixelColor(pt, t)));
+              }
+          }
+      },
+      numThreads, MIN_ROWS_PER_THREAD);
+}
+
 void Minimap::Draw(const Rect& rect)
 {
     BeforeDrawing();
@@ -40,11 +56,16 @@ void Minimap::Draw(const Rect& rect)
 void Minimap::BeforeDrawing() {}
 
 /**
- *  Variiert die übergebene Farbe zufällig in der Helligkeit
+ *  Variiert die übergebene Farbe in der Helligkeit.
+ *  Uses a hash of the position instead of a random number so the result does not depend on the order of calculation
  */
-unsigned Minimap::VaryBrightness(const unsigned color, const int range)
+unsigned Minimap::VaryBrightness(const unsigned color, const int range, const MapPoint pt, const unsigned t)
 {
-    int add = 100 - rand() % (2 * range);
+    uint32_t hash = (static_cast<uint32_t>(pt.y) << 17) ^ (static_cast<uint32_t>(pt.x) << 1) ^ t;
+    hash = ((hash >> 16) ^ hash) * 0x45d9f3bu;
+    hash = ((hash >> 16) ^ hash) * 0x45d9f3bu;
+    hash = (hash >> 16) ^ hash;
+    int add = 100 - static_cast<int>(hash % static_cast<uint32_t>(2 * range));
 
     int red = GetRed(color) * add / 100;
     if(red < 0)
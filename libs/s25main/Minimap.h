@@ -8,6 +8,10 @@
 #include "ogl/glArchivItem_Bitmap_Direct.h"
 #include "gameTypes/MapCoordinates.h"
 
+namespace libsiedler2 {
+class PixelBufferBGRA;
+}
+
 class Minimap
 {
 protected:
@@ -33,10 +37,20 @@ protected:
     {
         return static_cast<unsigned>(pt.y) * mapSize.x + static_cast<unsigned>(pt.x);
     }
-    /// Variiert die übergebene Farbe zufällig in der Helligkeit
-    static unsigned VaryBrightness(unsigned color, int range);
+    /// Position of the pixel for the given point and triangle in the texture
+    DrawPoint GetTexPos(const MapPoint pt, unsigned t) const
+    {
+        return DrawPoint((pt.x * 2 + t + (pt.y & 1)) % (mapSize.x * 2), pt.y);
+    }
+    /// Variiert die übergebene Farbe in der Helligkeit. The variation is pseudo-random but fixed for each pixel
+    static unsigned VaryBrightness(unsigned color, int range, MapPoint pt, unsigned t);
     /// Erstellt die Textur
     void CreateMapTexture();
+    /// Calculate the colors of all pixels into the buffer (size: 2*width x height).
+    /// Rows are distributed over numThreads threads (0 = default)
+    void CalcMapColors(libsiedler2::PixelBufferBGRA& buffer, unsigned numThreads = 0);
+    /// Calculate the color of the pixel for the given point and triangle.
+    /// Must be safe to be called concurrently for different points
     virtual unsigned CalcPixelColor(MapPoint pt, unsigned t) = 0;
     /// Zusätzliche Dinge, die die einzelnen Maps vor dem Zeichenvorgang zu tun haben
     virtual void BeforeDrawing();
@@ -0,0 +1,135 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ObjectPool.h"
+#include "RTTR_Assert.h"
+#include "helpers/LSANUtils.h"
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+
+namespace {
+constexpr size_t NUM_SIZE_CLASSES = ObjectPool::MAX_SIZE / ObjectPool::GRANULARITY;
+/// Approximate size of a slab. Contains at least MIN_OBJS_PER_SLAB objects
+constexpr size_t SLAB_SIZE = 16 * 1024;
+constexpr size_t MIN_OBJS_PER_SLAB = 16;
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+struct SizeClass
+{
+    FreeBlock* freeList = nullptr;
+    std::vector<std::unique_ptr<char[]>> slabs;
+    size_t numAllocs = 0, numFrees = 0, numLive = 0, maxLive = 0;
+
+    void addSlab(const size_t blockSize)
+    {
+        const size_t numBlocks = std::max(MIN_OBJS_PER_SLAB, SLAB_SIZE / blockSize);
+        slabs.emplace_back(new char[numBlocks * blockSize]);
+        char* const slab = slabs.back().get();
+        // Link in reverse so the blocks get used in address order
+        for(size_t i = numBlocks; i-- > 0;)
+        {
+            auto* block = reinterpret_cast<FreeBlock*>(slab + i * blockSize);
+            block->next = freeList;
+            freeList = block;
+        }
+    }
+};
+
+using SizeClasses = std::array<SizeClass, NUM_SIZE_CLASSES>;
+
+SizeClasses& getSizeClasses()
+{
+    // Never destroyed as objects might be freed during static destruction (e.g. by global game instances)
+    static auto* sizeClasses = new SizeClasses;
+    return *sizeClasses;
+}
+
+constexpr size_t getSizeClassIdx(size_t size)
+{
+    return (size + ObjectPool::GRANULARITY - 1) / ObjectPool::GRANULARITY - 1;
+}
+
+// Keep detection of use-after-free etc. by sanitizers
+#if RTTR_HAS_ASAN
+constexpr bool POOL_ENABLED = false;
+#else
+constexpr bool POOL_ENABLED = true;
+#endif
+
+constexpr bool usePool(size_t size)
+{
+    return POOL_ENABLED && size > 0 && size <= ObjectPool::MAX_SIZE;
+}
+} // namespace
+
+constexpr size_t ObjectPool::GRANULARITY;
+constexpr size_t ObjectPool::MAX_SIZE;
+
+void* ObjectPool::allocate(size_t size)
+{
+    if(!usePool(size))
+        return ::operator new(size);
+    const size_t idx = getSizeClassIdx(size);
+    SizeClass& sizeClass = getSizeClasses()[idx];
+    if(!sizeClass.freeList)
+        sizeClass.addSlab((idx + 1) * GRANULARITY);
+    FreeBlock* result = sizeClass.freeList;
+    sizeClass.freeList = result->next;
+    ++sizeClass.numAllocs;
+    sizeClass.maxLive = std::max(sizeClass.maxLive, ++sizeClass.numLive);
+    return result;
+}
+
+void ObjectPool::deallocate(void* ptr, size_t size) noexcept
+{
+    if(!ptr)
+        return;
+    if(!usePool(size))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    SizeClass& sizeClass = getSizeClasses()[getSizeClassIdx(size)];
+    RTTR_Assert(sizeClass.numLive > 0u);
+    auto* block = static_cast<FreeBlock*>(ptr);
+    block->next = sizeClass.freeList;
+    sizeClass.freeList = block;
+    ++sizeClass.numFrees;
+    --sizeClass.numLive;
+}
+
+std::vector<ObjectPool::SizeClassStats> ObjectPool::getStats()
+{
+    std::vector<SizeClassStats> result;
+    const SizeClasses& sizeClasses = getSizeClasses();
+    for(size_t i = 0; i < sizeClasses.size(); i++)
+    {
+        const SizeClass& sizeClass = sizeClasses[i];
+        if(sizeClass.numAllocs == 0u)
+            continue;
+        result.push_back(SizeClassStats{(i + 1) * GRANULARITY, sizeClass.numAllocs, sizeClass.numFrees,
+                                        sizeClass.numLive, sizeClass.maxLive, sizeClass.slabs.size()});
+    }
+    return result;
+}
+
+void ObjectPool::printStats(std::ostream& os)
+{
+    os << "Object pool statistics:\n";
+    os << std::setw(6) << "Size" << std::setw(12) << "Allocs" << std::setw(12) << "Frees" << std::setw(10) << "Live"
+       << std::setw(10) << "MaxLive" << std::setw(8) << "Slabs" << '\n';
+    for(const SizeClassStats& stats : getStats())
+    {
+        os << std::setw(6) << stats.size << std::setw(12) << stats.numAllocs << std::setw(12) << stats.numFrees
+           << std::setw(10) << stats.numLive << std::setw(10) << stats.maxLive << std::setw(8) << stats.numSlabs
+           << '\n';
+    }
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+/// Pool for small, frequently allocated and freed game objects.
+/// Memory is taken from slabs per size class (multiples of GRANULARITY bytes) and kept in free lists after release.
+/// Slabs are never returned, so memory usage is bounded by the peak usage.
+/// Not thread safe: Only used for game objects which are created and destroyed by the game thread.
+class ObjectPool
+{
+public:
+    /// All sizes are rounded up to a multiple of this
+    static constexpr size_t GRANULARITY = 16;
+    /// Largest size handled by the pool, larger objects use the global allocator
+    static constexpr size_t MAX_SIZE = 1024;
+
+    struct SizeClassStats
+    {
+        size_t size;
+        /// Total number of allocations/deallocations
+        size_t numAllocs, numFrees;
+        /// Number of objects currently alive and maximum of that
+        size_t numLive, maxLive;
+        /// Number of slabs allocated from the system
+        size_t numSlabs;
+    };
+
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size) noexcept;
+    /// Return the statistics of all used size classes
+    static std::vector<SizeClassStats> getStats();
+    /// Write the statistics to the stream in a human readable form
+    static void printStats(std::ostream& os);
+};
+
+/// Base class to allocate objects of all derived classes from the ObjectPool.
+/// Polymorphic classes must have a virtual destructor so the correct size is passed on deletion.
+class PoolAllocated
+{
+public:
+    static void* operator new(size_t size) { return ObjectPool::allocate(size); }
+    static void operator delete(void* ptr, size_t size) noexcept { ObjectPool::deallocate(ptr, size); }
+};
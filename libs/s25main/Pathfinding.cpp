@@ -10,6 +10,7 @@
 #include "pathfinding/PathConditionShip.h"
 #include "pathfinding/PathConditionTrade.h"
 #include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/WalkableComponents.h"
 #include "world/GameWorld.h"
 #include "gameTypes/ShipDirection.h"
 #include "gameData/GameConsts.h"
@@ -19,6 +20,9 @@ helpers::OptionalEnum<Direction> GameWorldBase::FindHumanPath(const MapPoint sta
                                                               const unsigned max_route, const bool random_route,
                                                               unsigned* length, std::vector<Direction>* route) const
 {
+    // Avoid a full search when there can't be any path, e.g. to another island
+    if(!walkableComponents->mayBeReachable(start, dest))
+        return boost::none;
     Direction first_dir{};
     if(GetFreePathFinder().FindPath(start, dest, random_route, max_route, route, length, &first_dir,
                                     PathConditionHuman(*this)))
@@ -98,6 +102,9 @@ helpers::OptionalEnum<Direction> GameWorld::FindTradePath(const MapPoint start,
     if(!PathConditionHuman(*this).IsNodeOk(dest))
         return boost::none;
 
+    // Avoid a full search when there can't be any path, e.g. to another island
+    if(!walkableComponents->mayBeReachable(start, dest))
+        return boost::none;
     Direction first_dir{};
     if(GetFreePathFinder().FindPath(start, dest, random_route, max_route, route, length, &first_dir,
                                     PathConditionTrade(*this, player)))
@@ -67,10 +67,10 @@ unsigned PreviewMinimap::CalcPixelColor(const MapPoint pt, const unsigned t)
     // Baum an dieser Stelle?
     unsigned char landscape_obj = objects[GetMMIdx(pt)];
     if(landscape_obj >= 0xC4 && landscape_obj <= 0xC6)
-        color = VaryBrightness(TREE_COLOR, VARY_TREE_COLOR);
+        color = VaryBrightness(TREE_COLOR, VARY_TREE_COLOR, pt, t);
     // Granit an dieser Stelle?
     else if(landscape_obj == 0xCC || landscape_obj == 0xCD)
-        color = VaryBrightness(GRANITE_COLOR, VARY_GRANITE_COLOR);
+        color = VaryBrightness(GRANITE_COLOR, VARY_GRANITE_COLOR, pt, t);
     // Ansonsten die jeweilige Terrainfarbe nehmen
     else
     {
@@ -9,8 +9,24 @@
 #include <s25util/tmpFile.h>
 #include <boost/filesystem.hpp>
 #include <memory>
+#include <stdexcept>
 #include <mygettext/mygettext.h>
 
+namespace {
+/// Value of the compressed flag
+enum class ReplayCompression : uint8_t
+{
+    /// Old replays: Uncompressed (not or not properly stopped)
+    None,
+    /// Old replays: Everything after the flag compressed at once
+    Whole,
+    /// Only the commands compressed in chunks, using GF deltas and elided repeated checksums
+    Chunked
+};
+/// First version storing the commands in chunks. Older versions use only the old compression values
+constexpr uint16_t FIRST_CHUNKED_VERSION = 9;
+} // namespace
+
 std::string Replay::GetSignature() const
 {
     return "RTTRRP2";
@@ -20,19 +36,37 @@ uint16_t Replay::GetVersion() const
 {
     /// Version des Replay-Formates
     /// Search for "TODO(Replay)" when increasing this (breaking Replay compatibility)
+    return 9;
+}
+
+uint16_t Replay::GetMinReadableVersion() const
+{
+    // Replays with commands stored uncompressed or compressed as a whole can still be played
     return 8;
 }
 
 //////////////////////////////////////////////////////////////////////////
 
-Replay::Replay() : random_init(0), isRecording_(false), lastGF_(0), lastGfFilePos_(0), mapType_(MapType::OldMap) {}
+Replay::Replay()
+    : random_init(0), chunkStartGF_(0), isChunked_(false), lastCmdGF_(0), hasLastChecksum_(false), isRecording_(false),
+      lastGF_(0), lastGfFilePos_(0), mapType_(MapType::OldMap)
+{}
 
-Replay::~Replay() = default;
+Replay::~Replay()
+{
+    // Don't lose the buffered commands e.g. on an exception
+    if(IsRecording())
+        WriteChunk();
+}
 
 void Replay::Close()
 {
+    if(IsRecording())
+        WriteChunk();
     file_.Close();
     uncompressedDataFile_.reset();
+    chunkData_.Clear();
+    isChunked_ = false;
     isRecording_ = false;
     filepath_.clear();
     ClearPlayers();
@@ -42,54 +76,53 @@ bool Replay::StopRecording()
 {
     if(!isRecording_)
         return true;
-    const unsigned replayDataSize = file_.Tell();
+    bool result = WriteChunk();
+    if(result)
+    {
+        try
+        {
+            // End marker: A chunk without data
+            file_.WriteUnsignedInt(lastGF_);
+            file_.WriteUnsignedInt(0);
+            file_.WriteUnsignedInt(0);
+        } catch(const std::exception& e)
+        {
+            lastErrorMsg = e.what();
+            result = false;
+        }
+    }
     isRecording_ = false;
     file_.Close();
+    return result;
+}
 
-    BinaryFile file;
-    if(!file.Open(filepath_, OpenFileMode::OFM_READ))
-        return false;
+bool Replay::WriteChunk()
+{
+    RTTR_Assert(IsRecording());
     try
     {
-        TmpFile tmpReplayFile(".rpl");
-        file.Seek(0, SEEK_SET);
-        tmpReplayFile.close();
-        BinaryFile compressedReplay;
-        compressedReplay.Open(tmpReplayFile.filePath, OpenFileMode::OFM_WRITE);
-
-        // Copy header data uncompressed
-        std::vector<char> data(lastGfFilePos_);
-        file.ReadRawData(data.data(), data.size());
-        compressedReplay.WriteRawData(data.data(), data.size());
-        const auto lastGF = file.ReadUnsignedInt();
-        RTTR_Assert(lastGF == lastGF_);
-        compressedReplay.WriteUnsignedInt(lastGF);
-        file.ReadUnsignedChar(); // Ignore compressed flag
-        compressedReplay.WriteUnsignedChar(1);
-
-        // Read and compress remaining data
-        const auto uncompressedSize = replayDataSize - file.Tell();
-        data.resize(uncompressedSize);
-        file.ReadRawData(data.data(), data.size());
-        data = CompressedData::compress(data);
-        // If the compressed data turns out to be larger than the uncompressed one, bail out
-        // This can happen for very short replays
-        if(data.size() >= uncompressedSize)
-            return true;
-        compressedReplay.WriteUnsignedInt(uncompressedSize);
-        compressedReplay.WriteUnsignedInt(data.size());
-        compressedReplay.WriteRawData(data.data(), data.size());
-
-        // All done. Replace uncompressed replay
-        compressedReplay.Close();
-        file.Close();
-        boost::filesystem::rename(tmpReplayFile.filePath, filepath_);
-        return true;
+        if(chunkData_.GetLength() > 0)
+        {
+            const auto* data = reinterpret_cast<const char*>(chunkData_.GetData());
+            const std::vector<char> compressedData =
+              CompressedData::compress(std::vector<char>(data, data + chunkData_.GetLength()));
+            file_.WriteUnsignedInt(chunkStartGF_);
+            file_.WriteUnsignedInt(chunkData_.GetLength());
+            file_.WriteUnsignedInt(compressedData.size());
+            file_.WriteRawData(compressedData.data(), compressedData.size());
+            chunkData_.Clear();
+        }
+        // Update the last GF only together with the commands so both match
+        file_.Seek(lastGfFilePos_, SEEK_SET);
+        file_.WriteUnsignedInt(lastGF_);
+        file_.Seek(0, SEEK_END);
+        file_.Flush();
     } catch(const std::exception& e)
     {
         lastErrorMsg = e.what();
         return false;
     }
+    return true;
 }
 
 bool Replay::StartRecording(const boost::filesystem::path& filepath, const MapInfo& mapInfo)
@@ -118,7 +151,7 @@ bool Replay::StartRecording(const boost::filesystem::path& filepath, const MapIn
     // Position merken für End-GF
     lastGfFilePos_ = file_.Tell();
     file_.WriteUnsignedInt(lastGF_);
-    file_.WriteUnsignedChar(0); // Compressed flag
+    file_.WriteUnsignedChar(static_cast<uint8_t>(ReplayCompression::Chunked));
 
     WritePlayerData(file_);
     WriteGGS(file_);
@@ -145,6 +178,9 @@ bool Replay::StartRecording(const boost::filesystem::path& filepath, const MapIn
     }
     // Alles sofort reinschreiben
     file_.Flush();
+    isChunked_ = true;
+    chunkData_.Clear();
+    chunkStartGF_ = 0;
 
     return true;
 }
@@ -197,8 +233,18 @@ bool Replay::LoadGameData(MapInfo& mapInfo)
 {
     try
     {
-        const bool isCompressed = file_.ReadUnsignedChar() != 0;
-        if(isCompressed)
+        const auto compression = static_cast<ReplayCompression>(file_.ReadUnsignedChar());
+        const bool isValidCompression = (GetFileVersion() < FIRST_CHUNKED_VERSION) ?
+                                          compression <= ReplayCompression::Whole :
+                                          compression == ReplayCompression::Chunked;
+        if(!isValidCompression)
+        {
+            lastErrorMsg = _("File is not in a valid format!");
+            return false;
+        }
+        isChunked_ = compression == ReplayCompression::Chunked;
+        chunkData_.Clear();
+        if(compression == ReplayCompression::Whole)
         {
             const auto uncompressedSize = file_.ReadUnsignedInt();
             const auto compressedSize = file_.ReadUnsignedInt();
@@ -257,15 +303,10 @@ void Replay::AddChatCommand(unsigned gf, uint8_t player, ChatDestination dest, c
     if(!file_.IsValid())
         return;
 
-    file_.WriteUnsignedInt(gf);
-
-    file_.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Chat));
-    file_.WriteUnsignedChar(player);
-    file_.WriteUnsignedChar(static_cast<uint8_t>(dest));
-    file_.WriteLongString(str);
-
-    // Sofort rein damit
-    file_.Flush();
+    StartCommand(gf, ReplayCommand::Chat);
+    chunkData_.PushUnsignedChar(player);
+    chunkData_.PushUnsignedChar(static_cast<uint8_t>(dest));
+    chunkData_.PushLongString(str);
 }
 
 void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommands& cmds)
@@ -274,21 +315,88 @@ void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommand
     if(!file_.IsValid())
         return;
 
-    file_.WriteUnsignedInt(gf);
+    StartCommand(gf, ReplayCommand::Game);
+    chunkData_.PushUnsignedChar(player);
+    const bool writeChecksum = StoresChecksum(gf, cmds.checksum);
+    chunkData_.PushBool(writeChecksum);
+    if(writeChecksum)
+    {
+        cmds.checksum.Serialize(chunkData_);
+        lastChecksum_ = cmds.checksum;
+        hasLastChecksum_ = true;
+    }
+    chunkData_.PushVarSize(cmds.gcs.size());
+    for(const gc::GameCommandPtr& gc : cmds.gcs)
+        gc->Serialize(chunkData_);
+}
 
-    file_.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Game));
-    Serializer ser;
-    ser.PushUnsignedChar(player);
-    cmds.Serialize(ser);
-    ser.WriteToFile(file_);
+void Replay::StartCommand(unsigned gf, ReplayCommand type)
+{
+    if(StartsChunk(gf))
+    {
+        // Only write to the file when a chunk is full instead of after every command
+        if(chunkData_.GetLength() > 0)
+            WriteChunk();
+        chunkStartGF_ = lastCmdGF_ = gf;
+        hasLastChecksum_ = false;
+    }
+    RTTR_Assert(gf >= lastCmdGF_);
+    chunkData_.PushVarSize(gf - lastCmdGF_);
+    lastCmdGF_ = gf;
+    chunkData_.PushUnsignedChar(static_cast<uint8_t>(type));
+}
 
-    // Sofort rein damit
-    file_.Flush();
+bool Replay::StartsChunk(unsigned gf) const
+{
+    return chunkData_.GetLength() == 0 || gf >= chunkStartGF_ + GFS_PER_CHUNK;
+}
+
+bool Replay::StoresChecksum(unsigned gf, const AsyncChecksum& checksum) const
+{
+    return StartsChunk(gf) || !hasLastChecksum_ || checksum != lastChecksum_;
+}
+
+bool Replay::ReadChunk()
+{
+    try
+    {
+        const auto firstGF = file_.ReadUnsignedInt();
+        const auto uncompressedSize = file_.ReadUnsignedInt();
+        const auto compressedSize = file_.ReadUnsignedInt();
+        // End marker
+        if(uncompressedSize == 0)
+            return false;
+        std::vector<char> compressedData(compressedSize);
+        file_.ReadRawData(compressedData.data(), compressedSize);
+        const std::vector<char> data = CompressedData::decompress(compressedData, uncompressedSize);
+        chunkData_.Clear();
+        chunkData_.PushRawData(data.data(), data.size());
+        chunkStartGF_ = lastCmdGF_ = firstGF;
+        hasLastChecksum_ = false;
+    } catch(std::runtime_error&)
+    {
+        // Recording was not stopped properly
+        if(file_.EndOfFile())
+            return false;
+        throw;
+    }
+    return true;
 }
 
 bool Replay::ReadGF(unsigned* gf)
 {
     RTTR_Assert(IsReplaying());
+    if(isChunked_)
+    {
+        if(chunkData_.GetBytesLeft() == 0 && !ReadChunk())
+        {
+            *gf = 0xFFFFFFFF;
+            return false;
+        }
+        lastCmdGF_ += chunkData_.PopVarSize();
+        *gf = lastCmdGF_;
+        return true;
+    }
     try
     {
         *gf = file_.ReadUnsignedInt();
@@ -306,12 +414,19 @@ ReplayCommand Replay::ReadRCType()
 {
     RTTR_Assert(IsReplaying());
     // Type auslesen
-    return ReplayCommand(file_.ReadUnsignedChar());
+    return ReplayCommand(isChunked_ ? chunkData_.PopUnsignedChar() : file_.ReadUnsignedChar());
 }
 
 void Replay::ReadChatCommand(uint8_t& player, uint8_t& dest, std::string& str)
 {
     RTTR_Assert(IsReplaying());
+    if(isChunked_)
+    {
+        player = chunkData_.PopUnsignedChar();
+        dest = chunkData_.PopUnsignedChar();
+        str = chunkData_.PopLongString();
+        return;
+    }
     player = file_.ReadUnsignedChar();
     dest = file_.ReadUnsignedChar();
     str = file_.ReadLongString();
@@ -320,6 +435,21 @@ void Replay::ReadChatCommand(uint8_t& player, uint8_t& dest, std::string& str)
 void Replay::ReadGameCommand(uint8_t& player, PlayerGameCommands& cmds)
 {
     RTTR_Assert(IsReplaying());
+    if(isChunked_)
+    {
+        player = chunkData_.PopUnsignedChar();
+        if(chunkData_.PopBool())
+        {
+            lastChecksum_.Deserialize(chunkData_);
+            hasLastChecksum_ = true;
+        } else if(!hasLastChecksum_)
+            throw std::runtime_error("Missing checksum of replay command");
+        cmds.checksum = lastChecksum_;
+        cmds.gcs.resize(chunkData_.PopVarSize());
+        for(gc::GameCommandPtr& gc : cmds.gcs)
+            gc = gc::GameCommand::Deserialize(chunkData_);
+        return;
+    }
     Serializer ser;
     ser.ReadFromFile(file_);
     player = ser.PopUnsignedChar();
@@ -329,14 +459,6 @@ void Replay::ReadGameCommand(uint8_t& player, PlayerGameCommands& cmds)
 void Replay::UpdateLastGF(unsigned last_gf)
 {
     RTTR_Assert(IsRecording());
-    if(!file_.IsValid())
-        return;
-
-    // An die Stelle springen
-    file_.Seek(lastGfFilePos_, SEEK_SET);
-    // Dorthin schreiben
-    file_.WriteUnsignedInt(last_gf);
-    // Wieder ans Ende springen
-    file_.Seek(0, SEEK_END);
+    // Written to the file together with the next chunk
     lastGF_ = last_gf;
 }
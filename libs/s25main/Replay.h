@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include "AsyncChecksum.h"
 #include "SavedFile.h"
 #include "gameTypes/ChatDestination.h"
 #include "gameTypes/MapType.h"
 #include "s25util/BinaryFile.h"
+#include "s25util/Serializer.h"
 #include <memory>
 #include <string>
 
@@ -27,7 +29,12 @@ enum class ReplayCommand
 /// It has a header that holds minimal information:
 ///     File header (version etc.), record time, map name, player names, length (last GF), savegame header (if
 ///     applicable)
-/// All game relevant data is stored afterwards
+/// All game relevant data is stored afterwards.
+/// The commands are stored in independently compressed chunks of (at most) GFS_PER_CHUNK GFs, each prefixed with its
+/// first GF and sizes. So they can be written and read incrementally without holding the whole replay in memory.
+/// Inside a chunk the GF of each command is stored as the difference to the previous one and the checksum of a game
+/// command is only stored if it differs from the previous one, which is the common case for multiple (AI) players in
+/// the same NWF. The first game command of each chunk always contains its checksum so chunks stay independent.
 class Replay : public SavedFile
 {
 public:
@@ -38,6 +45,7 @@ public:
 
     std::string GetSignature() const override;
     uint16_t GetVersion() const override;
+    uint16_t GetMinReadableVersion() const override;
 
     /// Beginnt die Save-Datei und schreibt den Header
     bool StartRecording(const boost::filesystem::path& filepath, const MapInfo& mapInfo);
@@ -75,9 +83,34 @@ public:
     /// Zufallsgeneratorinitialisierung
     unsigned random_init;
 
+    /// Number of GFs stored in one chunk of commands
+    static constexpr unsigned GFS_PER_CHUNK = 1000;
+
 protected:
+    /// Compress and write the buffered commands and the last GF. Returns false on error
+    bool WriteChunk();
+    /// Write the GF and type of a new command to the current chunk, writing the previous chunk if it is full
+    void StartCommand(unsigned gf, ReplayCommand type);
+    /// Read the next chunk into chunkData_. Returns false if there is none
+    bool ReadChunk();
+    /// Return true if a command at the given GF is the first of a (new) chunk
+    bool StartsChunk(unsigned gf) const;
+    /// Return true if the checksum of a game command at the given GF has to be stored, i.e. it is not elided
+    bool StoresChecksum(unsigned gf, const AsyncChecksum& checksum) const;
+
     BinaryFile file_;
-    std::unique_ptr<TmpFile> uncompressedDataFile_; /// Used when reading a compressed replay
+    std::unique_ptr<TmpFile> uncompressedDataFile_; /// Used when reading a replay compressed as a whole (old format)
+    /// Commands of the current chunk: Buffered when recording, decompressed when replaying a chunked replay
+    Serializer chunkData_;
+    /// First GF of the current chunk
+    unsigned chunkStartGF_;
+    /// True if the commands are stored in chunks, false for old replays
+    bool isChunked_;
+    /// GF of the previous command in the current chunk
+    unsigned lastCmdGF_;
+    /// Checksum of the previous game command in the current chunk, if any
+    AsyncChecksum lastChecksum_;
+    bool hasLastChecksum_;
     boost::filesystem::path filepath_;              /// Path to current file
 
     bool isRecording_;
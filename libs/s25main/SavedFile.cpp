@@ -14,7 +14,7 @@
 #include <mygettext/mygettext.h>
 #include <stdexcept>
 
-SavedFile::SavedFile() : saveTime_(0)
+SavedFile::SavedFile() : fileVersion_(0), saveTime_(0)
 {
     const std::string rev = rttr::version::GetRevision();
     std::copy(rev.begin(), rev.begin() + revision.size(), revision.begin());
@@ -68,7 +68,7 @@ bool SavedFile::ReadFileHeader(BinaryFile& file)
 
         // Version überprüfen
         uint16_t read_version = file.ReadUnsignedShort();
-        if(read_version != GetVersion())
+        if(read_version < GetMinReadableVersion() || read_version > GetVersion())
         {
             boost::format fmt = boost::format(
               (read_version < GetVersion()) ?
@@ -77,6 +77,7 @@ bool SavedFile::ReadFileHeader(BinaryFile& file)
             lastErrorMsg = (fmt % read_version % GetVersion()).str();
             return false;
         }
+        fileVersion_ = read_version;
     } catch(std::runtime_error& e)
     {
         lastErrorMsg = e.what();
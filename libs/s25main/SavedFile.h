@@ -24,6 +24,10 @@ public:
     virtual std::string GetSignature() const = 0;
     /// Return the file format version
     virtual uint16_t GetVersion() const = 0;
+    /// Return the oldest file format version that can still be read
+    virtual uint16_t GetMinReadableVersion() const { return GetVersion(); }
+    /// Return the format version of the file read last
+    uint16_t GetFileVersion() const { return fileVersion_; }
 
     /// Schreibt Signatur und Version der Datei
     void WriteFileHeader(BinaryFile& file) const;
@@ -64,6 +68,8 @@ public:
 protected:
     /// Last error message during loading
     std::string lastErrorMsg;
+    /// Format version of the file read last
+    uint16_t fileVersion_;
 
 private:
     std::vector<BasePlayerInfo> players;
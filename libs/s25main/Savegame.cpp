@@ -105,29 +105,26 @@ void Savegame::WriteGameData(BinaryFile& file)
 
 bool Savegame::ReadGameData(BinaryFile& file)
 {
-    std::vector<char> data;
+    sgd.Clear();
     const auto compressedFlagOrSize = file.ReadUnsignedInt();
     if(compressedFlagOrSize == 1u)
     {
         const auto uncompressedLength = file.ReadUnsignedInt();
         const auto compressedLength = file.ReadUnsignedInt();
-        data.resize(compressedLength);
-        file.ReadRawData(data.data(), data.size());
-        data = CompressedData::decompress(data, uncompressedLength);
+        // Decompress while reading, so neither the compressed nor the uncompressed data is held in an extra buffer
+        CompressedData::decompress(file, compressedLength, uncompressedLength, sgd);
 #ifndef NDEBUG
         // In debug builds write uncompressed game data to temporary file
         const auto gameDataPath = boost::filesystem::temp_directory_path() / "rttrGameData.raw";
         boost::nowide::ofstream f(gameDataPath, std::ios::binary);
-        f.write(data.data(), data.size());
+        f.write(reinterpret_cast<const char*>(sgd.GetData()), sgd.GetLength());
 #endif
     } else
     { // Old savegames have a size here which is always bigger than 1
         RTTR_Assert(compressedFlagOrSize > 1u);
-        data.resize(compressedFlagOrSize);
+        std::vector<char> data(compressedFlagOrSize);
         file.ReadRawData(data.data(), data.size());
+        sgd.PushRawData(data.data(), data.size());
     }
-
-    sgd.Clear();
-    sgd.PushRawData(data.data(), data.size());
     return true;
 }
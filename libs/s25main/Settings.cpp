@@ -11,6 +11,7 @@
 #include "files.h"
 #include "helpers/strUtils.h"
 #include "languages.h"
+#include "network/GameProtocol.h"
 #include "gameData/const_gui_ids.h"
 #include "libsiedler2/ArchivItem_Ini.h"
 #include "libsiedler2/ArchivItem_Text.h"
@@ -19,6 +20,7 @@
 #include "s25util/System.h"
 #include "s25util/error.h"
 #include <boost/filesystem/operations.hpp>
+#include <algorithm>
 
 const int Settings::VERSION = 13;
 const std::array<std::string, 10> Settings::SECTION_NAMES = {
@@ -130,6 +132,8 @@ void Settings::LoadDefaults()
     server.last_ip.clear();
     server.localPort = 3665;
     server.ipv6 = false;
+    server.maxQueuedMsgs = MAX_QUEUED_MSGS;
+    server.maxMsgsPerSecond = MAX_MSGS_PER_SECOND;
     // }
 
     proxy = ProxySettings();
@@ -272,6 +276,11 @@ void Settings::Load()
         boost::optional<uint16_t> port = validate::checkPort(iniServer->getValue("local_port"));
         server.localPort = port.value_or(3665);
         server.ipv6 = iniServer->getBoolValue("ipv6");
+        // Optional, at least 1 message
+        server.maxQueuedMsgs = static_cast<unsigned>(
+          std::max(1, iniServer->getValue("max_queued_msgs", static_cast<int>(MAX_QUEUED_MSGS))));
+        server.maxMsgsPerSecond = static_cast<unsigned>(
+          std::max(1, iniServer->getValue("max_msgs_per_second", static_cast<int>(MAX_MSGS_PER_SECOND))));
         // }
 
         // proxy
@@ -446,6 +455,8 @@ void Settings::Save()
     iniServer->setValue("last_ip", server.last_ip);
     iniServer->setValue("local_port", server.localPort);
     iniServer->setValue("ipv6", server.ipv6);
+    iniServer->setValue("max_queued_msgs", static_cast<int>(server.maxQueuedMsgs));
+    iniServer->setValue("max_msgs_per_second", static_cast<int>(server.maxMsgsPerSecond));
     // }
 
     // proxy
@@ -97,6 +97,9 @@ public:
         std::string last_ip; /// last entered ip or hostname
         uint16_t localPort;
         bool ipv6; /// listen/connect on ipv6 as default or not
+        /// Limits for the messages a hosted server accepts from each player (see PlayerMsgLimits)
+        unsigned maxQueuedMsgs;
+        unsigned maxMsgsPerSecond;
     } server;
 
     ProxySettings proxy;
@@ -32,6 +32,8 @@ Ware::Ware(const GoodType type, noBaseBuilding* goal, noRoadNode* location)
     world->GetPlayer(location->GetPlayer()).RegisterWare(*this);
     if(goal)
         goal->TakeWare(this);
+    else
+        AddToLostWares();
 }
 
 Ware::~Ware() = default;
@@ -86,15 +88,23 @@ void Ware::SetGoal(noBaseBuilding* newGoal)
     goal = newGoal;
     if(goal)
         goal->TakeWare(this);
+    else
+        AddToLostWares();
+}
+
+void Ware::AddToLostWares()
+{
+    if(location && IsLostWare())
+        world->GetPlayer(location->GetPlayer()).AddLostWare(*this);
 }
 
-void Ware::RecalcRoute()
+void Ware::RecalcRoute(const bool goalUnreachable)
 {
     // Nächste Richtung nehmen
-    if(location && goal)
-        next_dir = world->FindPathForWareOnRoads(*location, *goal, nullptr, &next_harbor);
+    if(location && goal && !goalUnreachable)
+        SetNextDir(world->FindPathForWareOnRoads(*location, *goal, nullptr, &next_harbor));
     else
-        next_dir = RoadPathDirection::None;
+        SetNextDir(RoadPathDirection::None);
 
     // Evtl gibts keinen Weg mehr? Dann wieder zurück ins Lagerhaus (wenns vorher überhaupt zu nem Ziel ging)
     if(next_dir == RoadPathDirection::None && goal)
@@ -128,21 +138,32 @@ void Ware::RecalcRoute()
     }
 }
 
+void Ware::SetNextDir(const RoadPathDirection newNextDir)
+{
+    if(newNextDir == next_dir)
+        return;
+    const RoadPathDirection oldNextDir = next_dir;
+    next_dir = newNextDir;
+    // The flag keeps track of the directions of its wares
+    if(state == State::WaitAtFlag && location)
+        static_cast<noFlag*>(location)->WareNextDirChanged(*this, oldNextDir);
+}
+
 void Ware::GoalDestroyed()
 {
     if(state == State::WaitInWarehouse)
     {
         // Ware ist noch im Lagerhaus auf der Warteliste
         RTTR_Assert(false); // Should not happen. noBaseBuilding::WareNotNeeded handles this case!
-        goal = nullptr; // just in case: avoid corruption although the ware itself might be lost (won't ever be carried
-                        // again)
+        // just in case: avoid corruption although the ware itself might be lost (won't ever be carried again)
+        SetGoal(nullptr);
     }
     // Ist sie evtl. gerade mit dem Schiff unterwegs?
     else if(state == State::OnShip)
     {
         // Ziel zunächst auf nullptr setzen, was dann vom Zielhafen erkannt wird,
         // woraufhin dieser die Ware gleich in sein Inventar mit übernimmt
-        goal = nullptr;
+        SetGoal(nullptr);
     }
     // Oder wartet sie im Hafen noch auf ein Schiff
     else if(state == State::WaitForShip)
@@ -173,14 +194,14 @@ void Ware::GoalDestroyed()
             } else // at the goal (which was just destroyed) and get carried out right now? -> we are about to get
                    // destroyed...
             {
-                goal = nullptr;
-                next_dir = RoadPathDirection::None;
+                SetGoal(nullptr);
+                SetNextDir(RoadPathDirection::None);
             }
         }
         // Wenn sie an einer Flagge liegt, muss der Weg neu berechnet werden und dem Träger Bescheid gesagt werden
         else if(state == State::WaitAtFlag)
         {
-            goal = nullptr;
+            SetGoal(nullptr);
             const auto oldNextDir = next_dir;
             FindRouteToWarehouse();
             if(oldNextDir != next_dir)
@@ -213,14 +234,14 @@ void Ware::GoalDestroyed()
                     SetGoal(static_cast<noBaseBuilding*>(location));
                 } else
                 {
-                    goal = nullptr;
+                    SetGoal(nullptr);
                     FindRouteToWarehouse();
                 }
             } else
             {
                 // too late to do anything our road will be removed and ware destroyed when the carrier starts walking
                 // about
-                goal = nullptr;
+                SetGoal(nullptr);
             }
         }
     }
@@ -254,8 +275,8 @@ void Ware::NotifyGoalAboutLostWare()
     if(goal)
     {
         goal->WareLost(*this);
-        goal = nullptr;
-        next_dir = RoadPathDirection::None;
+        SetGoal(nullptr);
+        SetNextDir(RoadPathDirection::None);
     }
 }
 
@@ -314,15 +335,15 @@ bool Ware::FindRouteToWarehouse()
         if(state != State::Carried)
         {
             if(location == goal)
-                next_dir = RoadPathDirection::None; // Warehouse will detect this
+                SetNextDir(RoadPathDirection::None); // Warehouse will detect this
             else
             {
-                next_dir = world->FindPathForWareOnRoads(*location, *goal, nullptr, &next_harbor);
+                SetNextDir(world->FindPathForWareOnRoads(*location, *goal, nullptr, &next_harbor));
                 RTTR_Assert(next_dir != RoadPathDirection::None);
             }
         }
     } else
-        next_dir = RoadPathDirection::None; // Make sure we are not going anywhere
+        SetNextDir(RoadPathDirection::None); // Make sure we are not going anywhere
     return goal != nullptr;
 }
 
@@ -371,7 +392,7 @@ void Ware::SetNewGoalForLostWare(noBaseBuilding* newgoal)
     const auto newDir = CalcPathToGoal(*newgoal).dir;
     if(newDir != RoadPathDirection::None) // there is a valid path to the goal? -> ordered!
     {
-        next_dir = newDir;
+        SetNextDir(newDir);
         SetGoal(newgoal);
         CallCarrier();
     }
@@ -400,6 +421,8 @@ void Ware::ShipJorneyEnded(nobHarborBuilding* hb)
     RTTR_Assert(hb);
     state = State::WaitInWarehouse;
     location = hb;
+    // Wares whose goal was destroyed during the journey are lost now
+    AddToLostWares();
 }
 
 /// Beginnt damit auf ein Schiff im Hafen zu warten
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "GameObject.h"
+#include "ObjectPool.h"
 #include "RTTR_Assert.h"
 #include "gameTypes/GoodTypes.h"
 #include "gameTypes/MapCoordinates.h"
@@ -18,7 +19,7 @@ class noFlag;
 class SerializedGameData;
 
 // Die Klasse Ware kennzeichnet eine Ware, die von einem Träger transportiert wird bzw gerade an einer Flagge liegt
-class Ware : public GameObject
+class Ware : public GameObject, public PoolAllocated
 {
     /// Die Richtung von der Fahne auf dem Weg, auf dem die Ware transportiert werden will als nächstes
     RoadPathDirection next_dir;
@@ -64,10 +65,11 @@ public:
     /// Sets the new goal and notifies it
     void SetGoal(noBaseBuilding* newGoal);
     /// Berechnet den Weg neu zu ihrem Ziel
-    void RecalcRoute();
+    /// If it is already known that the goal is unreachable (goalUnreachable=true) the path search is skipped
+    void RecalcRoute(bool goalUnreachable = false);
     /// set new next dir
-    void SetNextDir(RoadPathDirection newNextDir) { next_dir = newNextDir; }
-    void SetNextDir(Direction newNextDir) { next_dir = toRoadPathDirection(newNextDir); }
+    void SetNextDir(RoadPathDirection newNextDir);
+    void SetNextDir(Direction newNextDir) { SetNextDir(toRoadPathDirection(newNextDir)); }
     /// Wird aufgerufen, wenn es das Ziel der Ware nicht mehr gibt und sie wieder "nach Hause" getragen werden muss
     void GoalDestroyed();
     /// Changes the state of the ware
@@ -160,4 +162,6 @@ private:
         RoadPathDirection dir;
     };
     RouteParams CalcPathToGoal(const noBaseBuilding& newgoal) const;
+    /// Tells the player about the ware if it is lost, so it can be ordered or sent to a warehouse
+    void AddToLostWares();
 };
@@ -226,6 +226,7 @@ int AIInterface::CalcResourceValue(const MapPoint pt, AIResource res, helpers::O
 bool AIInterface::FindFreePathForNewRoad(MapPoint start, MapPoint target, std::vector<Direction>* route /*= nullptr*/,
                                          unsigned* length /*= nullptr*/) const
 {
+    ++numFreePathSearches_;
     bool boat = false;
     return gwb.GetFreePathFinder().FindPathAlternatingConditions(start, target, false, 100, route, length, nullptr,
                                                                  IsPointOK_RoadPath, IsPointOK_RoadPathEvenStep,
@@ -249,6 +250,7 @@ BuildingQuality AIInterface::GetBuildingQualityAnyOwner(const MapPoint pt) const
 
 bool AIInterface::FindPathOnRoads(const noRoadNode& start, const noRoadNode& target, unsigned* length) const
 {
+    ++numRoadPathSearches_;
     if(length)
         return gwb.GetRoadPathFinder().FindPath(start, target, false, std::numeric_limits<unsigned>::max(), nullptr,
                                                 length);
@@ -89,6 +89,9 @@ public:
                                 unsigned* length = nullptr) const;
     /// Tries to find a route from start to target, returning length of that route if it exists
     bool FindPathOnRoads(const noRoadNode& start, const noRoadNode& target, unsigned* length = nullptr) const;
+    /// Number of free path (new road) and road path searches done so far (statistics only)
+    unsigned GetNumFreePathSearches() const { return numFreePathSearches_; }
+    unsigned GetNumRoadPathSearches() const { return numRoadPathSearches_; }
     /// Checks if it is allowed to build catapults
     bool CanBuildCatapult() const { return player_.CanBuildCatapult(); }
     /// checks if the player is allowed to build the building type (lua maybe later addon?)
@@ -213,4 +216,5 @@ private:
     const unsigned char playerID_;
     /// Harbor ids which have at least one other harbor at the same sea
     std::vector<unsigned> usableHarbors_;
+    mutable unsigned numFreePathSearches_ = 0, numRoadPathSearches_ = 0;
 };
@@ -4,6 +4,7 @@
 
 #include "AIConstruction.h"
 #include "BuildingPlanner.h"
+#include "EventManager.h"
 #include "GlobalGameSettings.h"
 #include "Jobs.h"
 #include "Point.h"
@@ -88,22 +89,23 @@ void AIConstruction::ExecuteJobs(unsigned limit)
     unsigned i = 0; // count up to limit
     unsigned initconjobs = std::min<unsigned>(connectJobs.size(), 5);
     unsigned initbuildjobs = std::min<unsigned>(buildJobs.size(), 5);
-    for(; i < limit && !connectJobs.empty() && i < initconjobs;
-        i++) // go through list, until limit is reached or list empty or when every entry has been checked
+    AIWorkBudget& budget = aijh.GetWorkBudget();
+    // go through list, until limit or budget is reached or list empty or when every entry has been checked
+    for(; i < limit && budget.HasBudget() && !connectJobs.empty() && i < initconjobs; i++)
     {
         auto job = std::move(connectJobs.front());
         connectJobs.pop_front();
-        job->ExecuteJob();
+        aijh.RunJob(*job);
         if(job->GetState() != JobState::Finished
            && job->GetState() != JobState::Failed) // couldnt do job? -> move to back of list
         {
             connectJobs.push_back(std::move(job));
         }
     }
-    for(; i < limit && !buildJobs.empty() && i < (initconjobs + initbuildjobs); i++)
+    for(; i < limit && budget.HasBudget() && !buildJobs.empty() && i < (initconjobs + initbuildjobs); i++)
     {
         auto job = GetBuildJob();
-        job->ExecuteJob();
+        aijh.RunJob(*job);
         if(job->GetState() != JobState::Finished
            && job->GetState() != JobState::Failed) // couldnt do job? -> move to back of list
         {
@@ -275,13 +277,39 @@ bool AIConstruction::ConnectFlagToRoadSytem(const noFlag* flag, std::vector<Dire
     std::cout << "FindFlagsNum: " << flags.size() << std::endl;
 #endif
 
+    // The score of a flag is 2 * length of the new road + length of the existing path to the target.
+    // Both are at least as long as the distance between the points, so check the flags in order of that lower bound
+    // and stop as soon as no flag can be better than the current best.
+    // On equal scores the flag found first by FindFlags wins
+    struct Candidate
+    {
+        unsigned minScore;
+        unsigned idx;
+        const noFlag* flag;
+    };
+    std::vector<Candidate> candidates;
+    candidates.reserve(flags.size());
+    for(const noFlag* curFlag : flags)
+    {
+        const unsigned minScore = 2 * aii.gwb.CalcDistance(flag->GetPos(), curFlag->GetPos())
+                                  + aii.gwb.CalcDistance(curFlag->GetPos(), targetFlag->GetPos());
+        candidates.push_back(Candidate{minScore, static_cast<unsigned>(candidates.size()), curFlag});
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const Candidate& lhs, const Candidate& rhs) { return lhs.minScore < rhs.minScore; });
+
     const noFlag* shortest = nullptr;
     unsigned shortestLength = 99999;
+    unsigned shortestIdx = 0;
     std::vector<Direction> tmpRoute;
 
     // Jede Flagge testen...
-    for(const noFlag* curFlag : flags)
+    for(const Candidate& candidate : candidates)
     {
+        if(candidate.minScore > shortestLength
+           || (candidate.minScore == shortestLength && (!shortest || candidate.idx > shortestIdx)))
+            break;
+        const noFlag* curFlag = candidate.flag;
         tmpRoute.clear();
         unsigned length;
         // the flag should not be at a military building!
@@ -315,25 +343,26 @@ bool AIConstruction::ConnectFlagToRoadSytem(const noFlag* flag, std::vector<Dire
 
         // Find path from current flag to target. If the current flag IS the target then we have already a path with
         // distance=0
-        unsigned distance = 0;
-        bool pathFound = curFlag == targetFlag || aii.FindPathOnRoads(*curFlag, *targetFlag, &distance);
+        const unsigned distance = GetRoadDistance(*curFlag, *targetFlag);
 
         // Gewählte Fahne hat leider auch kein Anschluß an ein Lager, zu schade!
-        if(!pathFound)
+        if(distance == NO_ROAD_PATH)
+            continue;
+
+        // Kürzer als der letzte? Nehmen! Existierende Strecke höher gewichten (2), damit möglichst kurze Baustrecken
+        // bevorzugt werden bei ähnlich langen Wegmöglichkeiten
+        const unsigned score = 2 * length + distance + 10 * maxNonFlagPts;
+        if(score > shortestLength || (score == shortestLength && (!shortest || candidate.idx > shortestIdx)))
             continue;
 
         // Sind wir mit der Fahne schon verbunden? Einmal reicht!
         if(aii.FindPathOnRoads(*curFlag, *flag))
             continue;
 
-        // Kürzer als der letzte? Nehmen! Existierende Strecke höher gewichten (2), damit möglichst kurze Baustrecken
-        // bevorzugt werden bei ähnlich langen Wegmöglichkeiten
-        if(2 * length + distance + 10 * maxNonFlagPts < shortestLength)
-        {
-            shortest = curFlag;
-            shortestLength = 2 * length + distance + 10 * maxNonFlagPts;
-            route = tmpRoute;
-        }
+        shortest = curFlag;
+        shortestLength = score;
+        shortestIdx = candidate.idx;
+        route = tmpRoute;
     }
 
     if(shortest)
@@ -350,6 +379,28 @@ bool AIConstruction::ConnectFlagToRoadSytem(const noFlag* flag, std::vector<Dire
     return false;
 }
 
+unsigned AIConstruction::GetRoadDistance(const noFlag& flag, const noFlag& targetFlag)
+{
+    if(&flag == &targetFlag)
+        return 0;
+    // Roads only change while the game runs, so the cached values are valid for the current GF
+    const unsigned curGF = aii.gwb.GetEvMgr().GetCurrentGF();
+    if(roadDistanceCacheGF != curGF)
+    {
+        roadDistanceCache.clear();
+        roadDistanceCacheGF = curGF;
+    }
+    const auto key = std::make_pair(flag.GetObjId(), targetFlag.GetObjId());
+    const auto it = roadDistanceCache.find(key);
+    if(it != roadDistanceCache.end())
+        return it->second;
+    unsigned distance;
+    if(!aii.FindPathOnRoads(flag, targetFlag, &distance))
+        distance = NO_ROAD_PATH;
+    roadDistanceCache[key] = distance;
+    return distance;
+}
+
 bool AIConstruction::MinorRoadImprovements(const noRoadNode* start, const noRoadNode* target,
                                            std::vector<Direction>& route)
 {
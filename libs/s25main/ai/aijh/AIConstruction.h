@@ -10,7 +10,10 @@
 #include "gameTypes/Direction.h"
 #include "gameTypes/MapCoordinates.h"
 #include <deque>
+#include <limits>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 class AIInterface;
@@ -97,6 +100,13 @@ private:
     std::deque<MapPoint> constructionlocations;
     // contains the amount of buildings ordered since the last nwf
     helpers::EnumArray<uint8_t, BuildingType> constructionorders;
+    /// Road distance (flag, target flag) -> length, cached for the GF roadDistanceCacheGF
+    std::map<std::pair<unsigned, unsigned>, unsigned> roadDistanceCache;
+    unsigned roadDistanceCacheGF = 0;
+
+    static constexpr unsigned NO_ROAD_PATH = std::numeric_limits<unsigned>::max();
+    /// Return the length of the road path from flag to targetFlag or NO_ROAD_PATH if not connected
+    unsigned GetRoadDistance(const noFlag& flag, const noFlag& targetFlag);
 };
 
 } // namespace AIJH
@@ -38,10 +38,12 @@
 #include "gameData/ToolConsts.h"
 #include <algorithm>
 #include <array>
+#include <iterator>
 #include <memory>
 #include <random>
 #include <stdexcept>
 #include <type_traits>
+#include <unordered_set>
 
 namespace {
 void HandleBuildingNote(AIEventManager& eventMgr, const BuildingNote& note)
@@ -163,7 +165,7 @@ static auto createResourceMaps(const AIInterface& aii, const AIMap& aiMap)
 AIPlayerJH::AIPlayerJH(const unsigned char playerId, const GameWorldBase& gwb, const AI::Level level)
     : AIPlayer(playerId, gwb, level), UpgradeBldPos(MapPoint::Invalid()), resourceMaps(createResourceMaps(aii, aiMap)),
       isInitGfCompleted(false), defeated(player.IsDefeated()), bldPlanner(std::make_unique<BuildingPlanner>(*this)),
-      construction(std::make_unique<AIConstruction>(*this))
+      construction(std::make_unique<AIConstruction>(*this)), workBudget(WORK_BUDGET_PER_GF, MAX_WORK_BUDGET)
 {
     InitNodes();
     InitResourceMaps();
@@ -202,14 +204,26 @@ AIPlayerJH::AIPlayerJH(const unsigned char playerId, const GameWorldBase& gwb, c
             HandleResourceNote(eventManager, note);
     });
     subRoad = notifications.subscribe<RoadNote>([this, playerId](const RoadNote& note) {
-        if(note.player == playerId)
-            HandleRoadNote(eventManager, note);
+        if(note.player != playerId)
+            return;
+        HandleRoadNote(eventManager, note);
+        // The BQ of the road points might not have changed but roads can't cross them anymore
+        if(note.type == RoadNote::Constructed)
+        {
+            MapPoint pt = note.pos;
+            for(const Direction dir : note.route)
+            {
+                pt = gwb.GetNeighbour(pt, dir);
+                outdatedNodes.push_back(pt);
+            }
+        }
     });
     subShip = notifications.subscribe<ShipNote>([this, playerId](const ShipNote& note) {
         if(note.player == playerId)
             HandleShipNote(eventManager, note);
     });
-    subBQ = recordBQsToUpdate(this->gwb, this->nodesWithOutdatedBQ);
+    // BQ, ownership, border and reachability of nodes change only with those notes
+    subBQ = recordBQsToUpdate(this->gwb, this->outdatedNodes);
 }
 
 AIPlayerJH::~AIPlayerJH() = default;
@@ -238,13 +252,8 @@ void AIPlayerJH::RunGF(const unsigned gf, bool gfisnwf)
             aii.Chat(_("Hi, I'm an artifical player and I'm not very good yet!"));
     }
 
-    if(!nodesWithOutdatedBQ.empty())
-    {
-        helpers::makeUnique(nodesWithOutdatedBQ, MapPointLess());
-        for(const MapPoint pt : nodesWithOutdatedBQ)
-            aiMap[pt].bq = aii.GetBuildingQuality(pt);
-        nodesWithOutdatedBQ.clear();
-    }
+    if(!outdatedNodes.empty())
+        UpdateOutdatedNodes();
 
     bldPlanner->Update(gf, *this);
 
@@ -348,7 +357,7 @@ void AIPlayerJH::PlanNewBuildings(const unsigned gf)
         auto it = storehouses.begin();
         std::advance(it, randomStore);
         const MapPoint whPos = (*it)->GetPos();
-        UpdateNodesAround(whPos, 15); // update the area we want to build in first
+        DecayFailedPenaltiesAround(whPos, 15); // retest the area we want to build in first
         for(const BuildingType i : bldToTest)
         {
             if(construction->Wanted(i))
@@ -369,7 +378,7 @@ void AIPlayerJH::PlanNewBuildings(const unsigned gf)
     auto it2 = militaryBuildings.begin();
     std::advance(it2, randomMiliBld);
     MapPoint bldPos = (*it2)->GetPos();
-    UpdateNodesAround(bldPos, 15);
+    DecayFailedPenaltiesAround(bldPos, 15);
     // resource gathering buildings only around military; processing only close to warehouses
     for(unsigned i = 0; i < numResGatherBlds; i++)
     {
@@ -585,35 +594,126 @@ void AIPlayerJH::IterativeReachableNodeChecker(std::queue<MapPoint> toCheck)
                 continue;
 
             // Test whether point is reachable; yes->add to check list
-            if(roadPathChecker.IsNodeOk(curNeighbour))
+            // Penalized nodes are only retested in DecayFailedPenaltiesAround
+            if(node.failed_penalty == 0 && roadPathChecker.IsNodeOk(curNeighbour))
             {
-                if(node.failed_penalty == 0)
-                {
-                    node.reachable = true;
-                    toCheck.push(curNeighbour);
-                } else
-                {
-                    node.failed_penalty--;
-                }
+                node.reachable = true;
+                toCheck.push(curNeighbour);
             }
         }
         toCheck.pop();
     }
 }
 
+bool AIPlayerJH::IsOwnFlag(const MapPoint pt) const
+{
+    const auto* flag = gwb.GetSpecObj<noFlag>(pt);
+    return flag && flag->GetPlayer() == playerId;
+}
+
 void AIPlayerJH::UpdateReachableNodes(const std::vector<MapPoint>& pts)
 {
+    PathConditionRoad<GameWorldBase> roadPathChecker(gwb, false);
     std::queue<MapPoint> toCheck;
+    // Reachable nodes which might have lost their connection to a flag
+    std::vector<MapPoint> maybeDisconnected;
 
     for(const MapPoint& curPt : pts)
     {
-        const auto* flag = gwb.GetSpecObj<noFlag>(curPt);
-        if(flag && flag->GetPlayer() == playerId)
+        Node& node = aiMap[curPt];
+        if(IsOwnFlag(curPt))
         {
-            aiMap[curPt].reachable = true;
+            node.reachable = true;
             toCheck.push(curPt);
-        } else
-            aiMap[curPt].reachable = false;
+        } else if(!roadPathChecker.IsNodeOk(curPt))
+        {
+            if(!node.reachable)
+                continue;
+            node.reachable = false;
+            // Nodes reached over this one need to be reached another way
+            for(const MapPoint curNeighbour : aiMap.GetNeighbours(curPt))
+            {
+                if(aiMap[curNeighbour].reachable)
+                    maybeDisconnected.push_back(curNeighbour);
+            }
+        } else if(node.reachable)
+            maybeDisconnected.push_back(curPt); // E.g. a removed flag
+    }
+    RemoveDisconnectedNodes(maybeDisconnected);
+
+    // Usable nodes may now be reached from reachable nodes around them
+    for(const MapPoint& curPt : pts)
+    {
+        if(aiMap[curPt].reachable)
+            continue;
+        for(const MapPoint curNeighbour : aiMap.GetNeighbours(curPt))
+        {
+            if(aiMap[curNeighbour].reachable)
+                toCheck.push(curNeighbour);
+        }
+    }
+    IterativeReachableNodeChecker(toCheck);
+}
+
+void AIPlayerJH::RemoveDisconnectedNodes(const std::vector<MapPoint>& pts)
+{
+    // Indices of reachable nodes which are connected to an own flag
+    std::unordered_set<unsigned> connectedNodes;
+    for(const MapPoint startPt : pts)
+    {
+        if(!aiMap[startPt].reachable || helpers::contains(connectedNodes, gwb.GetIdx(startPt)))
+            continue;
+        // Search the reachable nodes connected to this one for a flag or a node already known to be connected
+        std::vector<MapPoint> visited{startPt};
+        std::unordered_set<unsigned> visitedIdxs{gwb.GetIdx(startPt)};
+        bool isConnected = false;
+        for(unsigned i = 0; i < visited.size(); i++)
+        {
+            const MapPoint curPt = visited[i];
+            if(IsOwnFlag(curPt) || helpers::contains(connectedNodes, gwb.GetIdx(curPt)))
+            {
+                isConnected = true;
+                break;
+            }
+            for(const MapPoint curNeighbour : aiMap.GetNeighbours(curPt))
+            {
+                if(aiMap[curNeighbour].reachable && visitedIdxs.insert(gwb.GetIdx(curNeighbour)).second)
+                    visited.push_back(curNeighbour);
+            }
+        }
+        if(isConnected)
+            connectedNodes.insert(visitedIdxs.begin(), visitedIdxs.end());
+        else
+        {
+            for(const MapPoint curPt : visited)
+                aiMap[curPt].reachable = false;
+        }
+    }
+}
+
+void AIPlayerJH::DecayFailedPenaltiesAround(const MapPoint pt, unsigned radius)
+{
+    PathConditionRoad<GameWorldBase> roadPathChecker(gwb, false);
+    std::queue<MapPoint> toCheck;
+    for(const MapPoint curPt : gwb.GetPointsInRadius(pt, radius))
+    {
+        Node& node = aiMap[curPt];
+        if(node.failed_penalty == 0 || !roadPathChecker.IsNodeOk(curPt))
+            continue;
+        // Tested once from every reachable neighbour, the first test after the penalty is gone succeeds
+        for(const MapPoint curNeighbour : aiMap.GetNeighbours(curPt))
+        {
+            if(!aiMap[curNeighbour].reachable)
+                continue;
+            if(node.failed_penalty > 0)
+                node.failed_penalty--;
+            else
+            {
+                node.reachable = true;
+                toCheck.push(curPt);
+                break;
+            }
+        }
     }
     IterativeReachableNodeChecker(toCheck);
 }
@@ -636,18 +736,23 @@ void AIPlayerJH::InitNodes()
     }
 }
 
-void AIPlayerJH::UpdateNodesAround(const MapPoint pt, unsigned radius)
+void AIPlayerJH::UpdateOutdatedNodes()
 {
-    std::vector<MapPoint> pts = gwb.GetPointsInRadius(pt, radius);
-    UpdateReachableNodes(pts);
-    for(const MapPoint& pt : pts)
+    helpers::makeUnique(outdatedNodes, MapPointLess());
+    // Only nodes in or taken from our territory can change their reachability
+    std::vector<MapPoint> ownNodes;
+    std::copy_if(outdatedNodes.begin(), outdatedNodes.end(), std::back_inserter(ownNodes),
+                 [this](const MapPoint pt) { return aiMap[pt].reachable || gwb.GetNode(pt).owner == playerId + 1; });
+    if(!ownNodes.empty())
+        UpdateReachableNodes(ownNodes);
+    for(const MapPoint pt : outdatedNodes)
     {
         Node& node = aiMap[pt];
-        // Change of ownership might change bq
         node.bq = aii.GetBuildingQuality(pt);
         node.owned = aii.IsOwnTerritory(pt);
         node.border = aii.IsBorder(pt);
     }
+    outdatedNodes.clear();
 }
 
 void AIPlayerJH::InitResourceMaps()
@@ -674,6 +779,19 @@ MapPoint AIPlayerJH::FindBestPosition(const MapPoint& pt, AIResource res, Buildi
     return resourceMaps[res].findBestPosition(pt, size, radius, minimum);
 }
 
+void AIPlayerJH::RunJob(AIJob& job)
+{
+    const auto getNumSearches = [this]() {
+        return aii.GetNumFreePathSearches() + aii.GetNumRoadPathSearches();
+    };
+    const unsigned numSearchesBefore = getNumSearches();
+    workBudget.StartJob();
+    job.ExecuteJob();
+    // Each job costs at least 1 unit
+    workBudget.AddWork(1 + getNumSearches() - numSearchesBefore);
+    workBudget.FinishJob();
+}
+
 void AIPlayerJH::ExecuteAIJob()
 {
     // Check whether current job is finished...
@@ -697,13 +815,15 @@ void AIPlayerJH::ExecuteAIJob()
             currentJob = 0;
         }
     }*/
-    unsigned quota = 10; // limit the amount of events to handle
-    while(eventManager.EventAvailable()
-          && quota) // handle all new events - some will add new orders but they can all be handled instantly
+    workBudget.StartGF();
+    unsigned quota = MAX_EVENTS_PER_GF; // limit the amount of events to handle
+    // handle all new events - some will add new orders but they can all be handled instantly
+    while(eventManager.EventAvailable() && quota
+          && (workBudget.HasBudget() || quota > MAX_EVENTS_PER_GF - MIN_EVENTS_PER_GF))
     {
         quota--;
         currentJob = std::make_unique<EventJob>(*this, eventManager.GetEvent());
-        currentJob->ExecuteJob();
+        RunJob(*currentJob);
     }
     // how many construction & connect jobs the ai will attempt every gf, the ai gets new orders from events and every
     // 200 gf
@@ -1181,7 +1301,7 @@ void AIPlayerJH::HandleBuildingFinished(const MapPoint pt, BuildingType bld)
     switch(bld)
     {
         case BuildingType::HarborBuilding:
-            UpdateNodesAround(pt, 8); // todo: fix radius
+            DecayFailedPenaltiesAround(pt, 8); // todo: fix radius
             RemoveAllUnusedRoads(
               pt); // repair & reconnect road system - required when a colony gets a new harbor by expedition
             aii.ChangeReserve(pt, 0, 1); // order 1 defender to stay in the harborbuilding
@@ -1257,7 +1377,7 @@ void AIPlayerJH::HandleTreeChopped(const MapPoint pt)
 
     aiMap[pt].reachable = true;
 
-    UpdateNodesAround(pt, 3);
+    DecayFailedPenaltiesAround(pt, 3);
 
     int random = rand();
 
@@ -1314,7 +1434,7 @@ void AIPlayerJH::HandleNoMoreResourcesReachable(const MapPoint pt, BuildingType
     if(bld == BuildingType::Fishery)
         resourceMaps[AIResource::Fish].avoidPosition(pt);
 
-    UpdateNodesAround(pt, 11); // todo: fix radius
+    DecayFailedPenaltiesAround(pt, 11); // todo: fix radius
     RemoveUnusedRoad(*gwb.GetSpecObj<noFlag>(gwb.GetNeighbour(pt, Direction::SouthEast)), Direction::NorthWest, true);
 
     // try to expand, maybe res blocked a passage
@@ -1364,7 +1484,7 @@ void AIPlayerJH::HandleShipBuilt(const MapPoint pt)
 
 void AIPlayerJH::HandleBorderChanged(const MapPoint pt)
 {
-    UpdateNodesAround(pt, 11); // todo: fix radius
+    DecayFailedPenaltiesAround(pt, 11); // todo: fix radius
 
     const auto* mil = gwb.GetSpecObj<nobMilitary>(pt);
     if(mil)
@@ -1587,20 +1707,19 @@ void AIPlayerJH::TryToAttack()
         unsigned attackersStrength = 0;
 
         // ask each of nearby own military buildings for soldiers to contribute to the potential attack
-        sortedMilitaryBlds myBuildings = gwb.LookForMilitaryBuildings(dest, 2);
-        for(const nobBaseMilitary* otherMilBld : myBuildings)
-        {
+        gwb.CheckMilitaryBuildings(dest, 2, [&](const nobBaseMilitary* otherMilBld) {
             if(otherMilBld->GetPlayer() == playerId)
             {
                 const auto* myMil = dynamic_cast<const nobMilitary*>(otherMilBld);
                 if(!myMil || myMil->IsUnderAttack())
-                    continue;
+                    return false;
 
                 unsigned newAttackers;
                 attackersStrength += myMil->GetSoldiersStrengthForAttack(dest, newAttackers);
                 attackersCount += newAttackers;
             }
-        }
+            return false;
+        });
 
         if(attackersCount == 0)
             continue;
@@ -1876,7 +1995,7 @@ void AIPlayerJH::RemoveAllUnusedRoads(const MapPoint pt)
         if(RemoveUnusedRoad(*flag, boost::none, true, false))
             reconnectflags.push_back(flag);
     }
-    UpdateNodesAround(pt, 25);
+    DecayFailedPenaltiesAround(pt, 25);
     for(const noFlag* flag : reconnectflags)
         construction->AddConnectFlagJob(flag);
 }
@@ -8,6 +8,7 @@
 #include "ai/AIPlayer.h"
 #include "ai/aijh/AIMap.h"
 #include "ai/aijh/AIResourceMap.h"
+#include "ai/aijh/AIWorkBudget.h"
 #include "helpers/OptionalEnum.h"
 #include "gameTypes/MapCoordinates.h"
 #include <boost/container/static_vector.hpp>
@@ -27,6 +28,13 @@ class BuildingPlanner;
 class AIConstruction;
 class AIJob;
 
+/// Work units the AI may use per GF and at most in one GF when it saved up unused work
+constexpr unsigned WORK_BUDGET_PER_GF = 50;
+constexpr unsigned MAX_WORK_BUDGET = 500;
+/// Events handled per GF at most and at least, even without budget, so they don't pile up while the budget is used
+constexpr unsigned MAX_EVENTS_PER_GF = 10;
+constexpr unsigned MIN_EVENTS_PER_GF = 2;
+
 /// Create a subscription which records all nodes for which the BQ (may) have changed
 /// Requires arguments to have the same lifetime as the subscription
 Subscription recordBQsToUpdate(const GameWorldBase& gw, std::vector<MapPoint>& bqsToUpdate);
@@ -46,6 +54,10 @@ public:
     const BuildingPlanner& GetBldPlanner() const { return *bldPlanner; }
     const AIJob* GetCurrentJob() const { return currentJob.get(); }
     unsigned GetNumJobs() const;
+    AIWorkBudget& GetWorkBudget() { return workBudget; }
+    const AIWorkBudget& GetWorkBudget() const { return workBudget; }
+    /// Execute the job and account for the work done
+    void RunJob(AIJob& job);
 
     void RunGF(unsigned gf, bool gfisnwf) override;
     void OnChatMessage(unsigned sendPlayerId, ChatDestination, const std::string& msg) override;
@@ -112,8 +124,10 @@ public:
     void SetGatheringForUpgradeWarehouse(nobBaseWarehouse* upgradewarehouse);
     /// Initializes the nodes on start of the game
     void InitNodes();
-    /// Updates the nodes around a position
-    void UpdateNodesAround(MapPoint pt, unsigned radius);
+    /// Updates the nodes whose state might have changed since the last update
+    void UpdateOutdatedNodes();
+    /// Retests the nodes around a position which were penalized for failed constructions
+    void DecayFailedPenaltiesAround(MapPoint pt, unsigned radius);
     /// Returns the resource on a specific point
     AINodeResource CalcResource(MapPoint pt);
     /// Initialize the resource maps
@@ -184,7 +198,11 @@ public:
 
     void InitReachableNodes();
     void IterativeReachableNodeChecker(std::queue<MapPoint> toCheck);
+    /// Updates the reachability of the given nodes and of the nodes reached over them
     void UpdateReachableNodes(const std::vector<MapPoint>& pts);
+    /// Marks the given nodes and all reachable nodes connected to them unreachable if they are not connected to a flag
+    void RemoveDisconnectedNodes(const std::vector<MapPoint>& pts);
+    bool IsOwnFlag(MapPoint pt) const;
 
     /// disconnects 'inland' military buildings from road system(and sends out soldiers), sets stop gold, uses the
     /// upgrade building (order new private, kick out general)
@@ -235,9 +253,11 @@ private:
     AIEventManager eventManager;
     std::unique_ptr<BuildingPlanner> bldPlanner;
     std::unique_ptr<AIConstruction> construction;
+    AIWorkBudget workBudget;
 
     Subscription subBuilding, subExpedition, subResource, subRoad, subShip, subBQ;
-    std::vector<MapPoint> nodesWithOutdatedBQ;
+    /// Nodes changed since the last AI step, updated at once at the start of the next one
+    std::vector<MapPoint> outdatedNodes;
 };
 
 } // namespace AIJH
@@ -8,7 +8,10 @@
 #include "ai/aijh/AIMap.h"
 #include "buildings/noBuildingSite.h"
 #include "buildings/nobUsual.h"
+#include "helpers/containerUtils.h"
 #include "gameData/TerrainDesc.h"
+#include <algorithm>
+#include <limits>
 
 namespace AIJH {
 
@@ -63,6 +66,11 @@ void AIResourceMap::init()
             map[pt] = isValid ? aii.CalcResourceValue(pt, res) : 0;
         }
     }
+    numTilesX = (mapSize.x + TILE_SIZE - 1) / TILE_SIZE;
+    const unsigned numTilesY = (mapSize.y + TILE_SIZE - 1) / TILE_SIZE;
+    tileMax.resize(numTilesX * numTilesY);
+    for(unsigned tileIdx = 0; tileIdx < tileMax.size(); tileIdx++)
+        calcTileMax(tileIdx);
 }
 
 void AIResourceMap::updateAround(const MapPoint& pt, int radius)
@@ -71,44 +79,154 @@ void AIResourceMap::updateAround(const MapPoint& pt, int radius)
         updateAroundDiminishable(pt, radius);
     else
         updateAroundReplinishable(pt, radius);
+    for(const unsigned tileIdx : getTilesAround(pt, static_cast<unsigned>(radius)))
+        calcTileMax(tileIdx);
+}
+
+bool AIResourceMap::isUsablePosition(const MapPoint& pt, BuildingQuality size) const
+{
+    const unsigned idx = map.GetIdx(pt);
+    if(!aiMap[idx].reachable || !aiMap[idx].owned || aiMap[idx].farmed)
+        return false;
+    RTTR_Assert(aii.GetBuildingQuality(pt)
+                == aiMap[pt].bq); // Temporary, to check if aiMap is correctly update, see below
+    if(!canUseBq(aii.GetBuildingQuality(pt), size)) // map[idx].bq; TODO: Update nodes BQ and use that
+        return false;
+    // special case fish -> check for other fishery buildings
+    if(res == AIResource::Fish && aii.isBuildingNearby(BuildingType::Fishery, pt, 5))
+        return false;
+    if(res == AIResource::Borderland && aii.gwb.IsOnRoad(aii.gwb.GetNeighbour(pt, Direction::SouthEast)))
+        return false;
+    // dont build next to empty harborspots
+    return !aii.isHarborPosClose(pt, 2, true);
+}
+
+std::vector<unsigned> AIResourceMap::getTilesAround(const MapPoint& pt, const unsigned radius) const
+{
+    const auto getTileCoords = [radius](const int center, const unsigned size) {
+        std::vector<unsigned> result;
+        if(2 * radius + 1 >= size)
+        {
+            for(unsigned i = 0; i * TILE_SIZE < size; i++)
+                result.push_back(i);
+            return result;
+        }
+        for(int i = center - static_cast<int>(radius); i <= center + static_cast<int>(radius); i++)
+        {
+            const unsigned tile = static_cast<unsigned>(i + size) % size / TILE_SIZE;
+            if(result.empty() || result.back() != tile)
+                result.push_back(tile);
+        }
+        // Wrapping around might end in the first tile
+        if(result.size() > 1u && result.front() == result.back())
+            result.pop_back();
+        return result;
+    };
+    const MapExtent mapSize = map.GetSize();
+    std::vector<unsigned> result;
+    const std::vector<unsigned> tilesX = getTileCoords(pt.x, mapSize.x);
+    for(const unsigned tileY : getTileCoords(pt.y, mapSize.y))
+    {
+        for(const unsigned tileX : tilesX)
+            result.push_back(tileY * numTilesX + tileX);
+    }
+    return result;
+}
+
+void AIResourceMap::calcTileMax(const unsigned tileIdx)
+{
+    const MapExtent mapSize = map.GetSize();
+    const MapPoint tileStart((tileIdx % numTilesX) * TILE_SIZE, (tileIdx / numTilesX) * TILE_SIZE);
+    const MapPoint tileEnd(std::min<unsigned>(tileStart.x + TILE_SIZE, mapSize.x),
+                           std::min<unsigned>(tileStart.y + TILE_SIZE, mapSize.y));
+    int maxValue = std::numeric_limits<int>::min();
+    for(MapPoint curPt(0, tileStart.y); curPt.y < tileEnd.y; ++curPt.y)
+    {
+        for(curPt.x = tileStart.x; curPt.x < tileEnd.x; ++curPt.x)
+            maxValue = std::max(maxValue, map[curPt]);
+    }
+    tileMax[tileIdx] = maxValue;
 }
 
 MapPoint AIResourceMap::findBestPosition(const MapPoint& pt, BuildingQuality size, unsigned radius, int minimum) const
 {
-    MapPoint best = MapPoint::Invalid();
     int best_value = (minimum == std::numeric_limits<int>::min()) ? minimum : minimum - 1;
 
-    std::vector<MapPoint> pts = aii.gwb.GetPointsInRadiusWithCenter(pt, radius);
-    for(const MapPoint& curPt : pts)
+    const MapExtent mapSize = map.GetSize();
+    // When wrapping around the map the same node might be found multiple times at different distances
+    if(2 * radius + 1 >= mapSize.x || 2 * radius + 1 >= mapSize.y)
+    {
+        MapPoint best = MapPoint::Invalid();
+        for(const MapPoint& curPt : aii.gwb.GetPointsInRadiusWithCenter(pt, radius))
+        {
+            if(map[curPt] > best_value && isUsablePosition(curPt, size))
+            {
+                best = curPt;
+                best_value = map[curPt];
+            }
+        }
+        return best;
+    }
+
+    // Check the tiles with the highest values first and stop if none of the remaining tiles can contain a better
+    // value. Collect all usable positions with the best value to choose the same one as the search going around pt
+    std::vector<unsigned> tiles = getTilesAround(pt, radius);
+    std::sort(tiles.begin(), tiles.end(), [this](unsigned lhs, unsigned rhs) { return tileMax[lhs] > tileMax[rhs]; });
+    std::vector<MapPoint> bestPts;
+    for(const unsigned tileIdx : tiles)
     {
-        const unsigned idx = map.GetIdx(curPt);
-        if(map[idx] > best_value)
+        if(tileMax[tileIdx] < best_value || (tileMax[tileIdx] == best_value && bestPts.empty()))
+            break;
+        const MapPoint tileStart((tileIdx % numTilesX) * TILE_SIZE, (tileIdx / numTilesX) * TILE_SIZE);
+        const MapPoint tileEnd(std::min<unsigned>(tileStart.x + TILE_SIZE, mapSize.x),
+                               std::min<unsigned>(tileStart.y + TILE_SIZE, mapSize.y));
+        for(MapPoint curPt(0, tileStart.y); curPt.y < tileEnd.y; ++curPt.y)
         {
-            if(!aiMap[idx].reachable || !aiMap[idx].owned || aiMap[idx].farmed)
-                continue;
-            RTTR_Assert(aii.GetBuildingQuality(curPt)
-                        == aiMap[curPt].bq); // Temporary, to check if aiMap is correctly update, see below
-            if(!canUseBq(aii.GetBuildingQuality(curPt), size)) // map[idx].bq; TODO: Update nodes BQ and use that
-                continue;
-            // special case fish -> check for other fishery buildings
-            if(res == AIResource::Fish && aii.isBuildingNearby(BuildingType::Fishery, curPt, 5))
-                continue;
-            if(res == AIResource::Borderland && aii.gwb.IsOnRoad(aii.gwb.GetNeighbour(curPt, Direction::SouthEast)))
-                continue;
-            // dont build next to empty harborspots
-            if(aii.isHarborPosClose(curPt, 2, true))
-                continue;
-            best = curPt;
-            best_value = map[idx];
-            // TODO: calculate "perfect" rating and instantly return if we got that already
+            for(curPt.x = tileStart.x; curPt.x < tileEnd.x; ++curPt.x)
+            {
+                const int value = map[curPt];
+                if(value < best_value || (value == best_value && bestPts.empty()))
+                    continue;
+                if(aii.gwb.CalcDistance(pt, curPt) > radius || !isUsablePosition(curPt, size))
+                    continue;
+                if(value > best_value)
+                {
+                    best_value = value;
+                    bestPts.clear();
+                }
+                bestPts.push_back(curPt);
+            }
         }
     }
+    if(bestPts.empty())
+        return MapPoint::Invalid();
+    if(bestPts.size() == 1u)
+        return bestPts.front();
 
-    return best;
+    // Same value -> the first one in the (smallest) circle around pt wins
+    unsigned minDistance = radius;
+    for(const MapPoint& curPt : bestPts)
+        minDistance = std::min(minDistance, aii.gwb.CalcDistance(pt, curPt));
+    if(minDistance == 0)
+        return pt;
+    MapPoint curPt = pt;
+    for(unsigned r = 0; r < minDistance; r++)
+        curPt = aiMap.GetNeighbour(curPt, Direction::West);
+    for(const auto dir : helpers::enumRange(Direction::NorthEast))
+    {
+        for(unsigned step = 0; step < minDistance; ++step, curPt = aiMap.GetNeighbour(curPt, dir))
+        {
+            if(helpers::contains(bestPts, curPt))
+                return curPt;
+        }
+    }
+    RTTR_Assert(false);
+    return bestPts.front();
 }
 
 void AIResourceMap::avoidPosition(const MapPoint& pt)
 {
+    // Tile maximum stays an upper bound
     map[pt] = 0;
 }
 
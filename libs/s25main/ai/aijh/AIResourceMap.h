@@ -9,6 +9,7 @@
 #include "world/NodeMapBase.h"
 #include "gameTypes/BuildingQuality.h"
 #include "gameTypes/BuildingType.h"
+#include <vector>
 
 class AIInterface;
 namespace AIJH {
@@ -39,6 +40,11 @@ private:
     void updateAroundDiminishable(const MapPoint& pt, int radius);
     /// Update algorithm for resources which can be replenished
     void updateAroundReplinishable(const MapPoint& pt, int radius);
+    /// Check if the position can be used for a building of the given size
+    bool isUsablePosition(const MapPoint& pt, BuildingQuality size) const;
+    /// Return the indices of all tiles overlapping the bounding box of the radius around pt
+    std::vector<unsigned> getTilesAround(const MapPoint& pt, unsigned radius) const;
+    void calcTileMax(unsigned tileIdx);
 
     /// Which resource is stored in the map and radius of affected nodes
     const AIResource res;
@@ -47,6 +53,12 @@ private:
     const unsigned resRadius;
 
     NodeMapBase<int> map;
+    /// Size of the (square) tiles the map is divided into
+    static constexpr unsigned TILE_SIZE = 8;
+    /// Maximum value of each tile (or more) to skip whole tiles when searching.
+    /// Not filtered by the node states as those change without the resource map knowing
+    std::vector<int> tileMax;
+    unsigned numTilesX = 0;
     const AIInterface& aii;
     const AIMap& aiMap;
 };
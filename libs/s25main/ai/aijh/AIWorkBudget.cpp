@@ -0,0 +1,75 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AIWorkBudget.h"
+#include <algorithm>
+
+namespace AIJH {
+
+AIWorkBudget::AIWorkBudget(unsigned budgetPerGF, unsigned maxBudget)
+    : budgetPerGF(budgetPerGF), maxBudget(std::max(budgetPerGF, maxBudget)), available(0), workInCurrentGF(0),
+      budgetAtGFStart(0), workAtJobStart(0), isJobWithBudget(false), maxJobWork(0), numJobsWithoutBudget(0),
+      workWithoutBudget(0), numUncountedNodes(0), isGFStarted(false)
+{
+    histogram.fill(0);
+}
+
+void AIWorkBudget::StartGF()
+{
+    if(isGFStarted)
+        histogram[GetBucket(workInCurrentGF)]++;
+    isGFStarted = true;
+    workInCurrentGF = 0;
+    maxJobWork = numJobsWithoutBudget = workWithoutBudget = 0;
+    available = std::min(available + static_cast<int>(budgetPerGF), static_cast<int>(maxBudget));
+    budgetAtGFStart = GetAvailable();
+}
+
+void AIWorkBudget::AddWork(unsigned units)
+{
+    workInCurrentGF += units;
+    available -= static_cast<int>(units);
+}
+
+void AIWorkBudget::AddTestedNodes(unsigned numNodes)
+{
+    numUncountedNodes += numNodes;
+    AddWork(numUncountedNodes / NODES_PER_WORK_UNIT);
+    numUncountedNodes %= NODES_PER_WORK_UNIT;
+}
+
+void AIWorkBudget::StartJob()
+{
+    workAtJobStart = workInCurrentGF;
+    isJobWithBudget = HasBudget();
+}
+
+void AIWorkBudget::FinishJob()
+{
+    const unsigned jobWork = workInCurrentGF - workAtJobStart;
+    maxJobWork = std::max(maxJobWork, jobWork);
+    if(!isJobWithBudget)
+    {
+        numJobsWithoutBudget++;
+        workWithoutBudget += jobWork;
+    }
+}
+
+unsigned AIWorkBudget::GetBucketStart(unsigned bucket)
+{
+    return bucket == 0 ? 0u : 1u << (bucket - 1);
+}
+
+unsigned AIWorkBudget::GetBucket(unsigned work)
+{
+    unsigned bucket = 0;
+    while(work > 0 && bucket + 1 < NUM_BUCKETS)
+    {
+        bucket++;
+        work >>= 1;
+    }
+    return bucket;
+}
+
+} // namespace AIJH
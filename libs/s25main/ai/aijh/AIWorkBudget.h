@@ -0,0 +1,72 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+namespace AIJH {
+
+/// Limits the work the AI starts per GF to spread it over multiple GFs.
+/// Work is measured in deterministic units (jobs, path searches, nodes checked) instead of time so the AI does the
+/// same on all machines. Unused budget is saved up to a maximum and work exceeding the budget is paid back in the
+/// following GFs.
+class AIWorkBudget
+{
+public:
+    /// Number of nodes a position search may check per work unit
+    static constexpr unsigned NODES_PER_WORK_UNIT = 25;
+    /// Histogram buckets: 0, 1, 2-3, 4-7, ..., >= 2^(NUM_BUCKETS - 2)
+    static constexpr unsigned NUM_BUCKETS = 12;
+    using Histogram = std::array<unsigned, NUM_BUCKETS>;
+
+    AIWorkBudget(unsigned budgetPerGF, unsigned maxBudget);
+
+    /// Start a new GF which adds the budget for it
+    void StartGF();
+    /// Return true if new work may be started
+    bool HasBudget() const { return available > 0; }
+    /// Return the budget left, 0 if there is none
+    unsigned GetAvailable() const { return available > 0 ? static_cast<unsigned>(available) : 0u; }
+    /// Account for work done
+    void AddWork(unsigned units);
+    /// Account for nodes checked by position searches. Nodes not making up a full unit are carried over
+    void AddTestedNodes(unsigned numNodes);
+    /// Mark the start and end of a job to keep statistics about the work per job
+    void StartJob();
+    void FinishJob();
+
+    unsigned GetBudgetPerGF() const { return budgetPerGF; }
+    unsigned GetMaxBudget() const { return maxBudget; }
+    unsigned GetWorkInCurrentGF() const { return workInCurrentGF; }
+    /// Budget saved up from previous GFs plus the one for the current GF
+    unsigned GetBudgetAtGFStart() const { return budgetAtGFStart; }
+    /// Most work done by a single job in the current GF
+    unsigned GetMaxJobWork() const { return maxJobWork; }
+    /// Number of jobs started without budget left in the current GF and the work they did
+    unsigned GetNumJobsWithoutBudget() const { return numJobsWithoutBudget; }
+    unsigned GetWorkWithoutBudget() const { return workWithoutBudget; }
+    /// Number of (completed) GFs by the work done in them
+    const Histogram& GetHistogram() const { return histogram; }
+    /// Return the smallest amount of work counted in the given bucket
+    static unsigned GetBucketStart(unsigned bucket);
+    static unsigned GetBucket(unsigned work);
+
+private:
+    const unsigned budgetPerGF, maxBudget;
+    /// Budget left. Negative if more work was done than allowed
+    int available;
+    unsigned workInCurrentGF;
+    unsigned budgetAtGFStart;
+    /// Work done in the GF when the current job was started and whether there was budget left
+    unsigned workAtJobStart;
+    bool isJobWithBudget;
+    unsigned maxJobWork, numJobsWithoutBudget, workWithoutBudget;
+    /// Tested nodes not yet accounted for as a work unit
+    unsigned numUncountedNodes;
+    bool isGFStarted;
+    Histogram histogram;
+};
+
+} // namespace AIJH
@@ -15,6 +15,7 @@
 #include "gameData/BuildingConsts.h"
 #include "gameData/BuildingProperties.h"
 #include <boost/range/adaptor/reversed.hpp>
+#include <algorithm>
 
 namespace AIJH {
 
@@ -459,7 +460,12 @@ void ConnectJob::ExecuteJob()
 void SearchJob::ExecuteJob()
 {
     state = JobState::Failed;
-    PositionSearchState searchState = search->execute(aijh);
+    // Test as many nodes as the budget allows (at least some to make progress)
+    AIWorkBudget& budget = aijh.GetWorkBudget();
+    const unsigned numTestedBefore = search->GetNumTestedNodes();
+    const PositionSearchState searchState =
+      search->execute(aijh, std::max(1u, budget.GetAvailable()) * AIWorkBudget::NODES_PER_WORK_UNIT);
+    budget.AddTestedNodes(search->GetNumTestedNodes() - numTestedBefore);
 
     if(searchState == PositionSearchState::InProgress)
         state = JobState::Waiting;
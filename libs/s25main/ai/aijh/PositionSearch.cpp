@@ -9,8 +9,7 @@
 AIJH::PositionSearch::PositionSearch(const AIPlayerJH& player, const MapPoint pt, AIResource res, int minimum,
                                      BuildingType bld, bool searchGlobalOptimum /*= false*/)
     : startPt(pt), res(res), minimum(minimum), size(BUILDING_SIZE[bld]), bld(bld),
-      searchGlobalOptimum(searchGlobalOptimum), nodesPerStep(25), // TODO: Make it depend on something...
-      resultPt(MapPoint::Invalid()), resultValue(0)
+      searchGlobalOptimum(searchGlobalOptimum), numTestedNodes(0), resultPt(MapPoint::Invalid()), resultValue(0)
 {
     tested.resize(prodOfComponents(player.GetWorld().GetSize()));
 
@@ -19,11 +18,11 @@ AIJH::PositionSearch::PositionSearch(const AIPlayerJH& player, const MapPoint pt
     tested[player.GetWorld().GetIdx(pt)] = true;
 }
 
-AIJH::PositionSearchState AIJH::PositionSearch::execute(const AIPlayerJH& player)
+AIJH::PositionSearchState AIJH::PositionSearch::execute(const AIPlayerJH& player, const unsigned maxNodes)
 {
     const AIResourceMap& resMap = player.GetResMap(res);
-    // make nodesPerStep tests
-    for(int i = 0; i < nodesPerStep; i++)
+    // make maxNodes tests
+    for(unsigned i = 0; i < maxNodes; i++)
     {
         // no more nodes to test? end this!
         if(toTest.empty())
@@ -32,6 +31,7 @@ AIJH::PositionSearchState AIJH::PositionSearch::execute(const AIPlayerJH& player
         // get the node
         MapPoint pt = toTest.front();
         toTest.pop();
+        numTestedNodes++;
         const Node& node = player.GetAINode(pt);
 
         // and test it... TODO exception at res::borderland?
@@ -53,7 +53,7 @@ AIJH::PositionSearchState AIJH::PositionSearch::execute(const AIPlayerJH& player
             // test if already tested or not in territory
             if(!tested[nIdx] && player.GetAINode(neighbourPt).owned)
             {
-                toTest.push(pt);
+                toTest.push(neighbourPt);
                 tested[nIdx] = true;
             }
         }
@@ -28,8 +28,10 @@ public:
     PositionSearch(const AIPlayerJH& player, MapPoint pt, AIResource res, int minimum, BuildingType bld,
                    bool searchGlobalOptimum = false);
 
-    PositionSearchState execute(const AIPlayerJH& player);
+    /// Continue the search testing at most maxNodes nodes
+    PositionSearchState execute(const AIPlayerJH& player, unsigned maxNodes);
     BuildingType GetBld() const { return bld; }
+    unsigned GetNumTestedNodes() const { return numTestedNodes; }
     MapPoint GetResultPt() const { return resultPt; }
 
 private:
@@ -46,8 +48,8 @@ private:
     /// If false, the first point matching the conditions will be returned. Otherwise it looks further for even better
     /// points
     bool searchGlobalOptimum;
-    /// how many nodes should we test each cycle?
-    int nodesPerStep;
+    /// how many nodes were tested so far?
+    unsigned numTestedNodes;
     /// which nodes have already been tested or will be tested next (=already in queue)?
     std::vector<bool> tested;
     /// which nodes are currently queued to be tested next?
@@ -814,22 +814,26 @@ void nobHarborBuilding::RemoveDependentFigure(noFigure& figure)
 }
 
 /// Gibt eine Liste mit möglichen Verbindungen zurück
-std::vector<nobHarborBuilding::ShipConnection> nobHarborBuilding::GetShipConnections() const
+const std::vector<nobHarborBuilding::ShipConnection>& nobHarborBuilding::GetShipConnections() const
 {
-    std::vector<ShipConnection> connections;
+    static const std::vector<ShipConnection> noConnections;
 
     // Is the harbor being destroyed right now? Could happen due to pathfinding for wares that get notified about this
     // buildings destruction
     if(IsBeingDestroyedNow())
-        return connections;
+        return noConnections;
 
     // Should already be handled by the above check, but keep the runtime check for now (TODO: remove runtime check)
     RTTR_Assert(world->GetGOT(pos) == GO_Type::NobHarborbuilding);
 
     // Is there any harbor building at all? (could be destroyed)?
     if(world->GetGOT(pos) != GO_Type::NobHarborbuilding)
-        return connections;
+        return noConnections;
 
+    if(areShipConnectionsValid)
+        return shipConnections;
+
+    numShipConnectionCalcs++;
     std::vector<nobHarborBuilding*> harbor_buildings;
     for(unsigned short seaId : seaIds)
     {
@@ -837,6 +841,7 @@ std::vector<nobHarborBuilding::ShipConnection> nobHarborBuilding::GetShipConnect
             world->GetPlayer(player).GetHarborsAtSea(harbor_buildings, seaId);
     }
 
+    shipConnections.clear();
     for(auto* harbor_building : harbor_buildings)
     {
         ShipConnection sc;
@@ -844,9 +849,10 @@ std::vector<nobHarborBuilding::ShipConnection> nobHarborBuilding::GetShipConnect
         // Als Kantengewicht nehmen wir die doppelte Entfernung (evtl muss ja das Schiff erst kommen)
         // plus einer Kopfpauschale (Ein/Ausladen usw. dauert ja alles)
         sc.way_costs = 2 * world->CalcHarborDistance(GetHarborPosID(), harbor_building->GetHarborPosID()) + 10;
-        connections.push_back(sc);
+        shipConnections.push_back(sc);
     }
-    return connections;
+    areShipConnectionsValid = true;
+    return shipConnections;
 }
 
 /// Fügt einen Mensch hinzu, der mit dem Schiff irgendwo hin fahren will
@@ -155,8 +155,13 @@ public:
         /// Kosten für die Strecke in Weglänge eines einfachen Trägers
         unsigned way_costs;
     };
-    /// Gibt eine Liste mit möglichen Verbindungen zurück
-    std::vector<ShipConnection> GetShipConnections() const;
+    /// Gibt eine Liste mit möglichen Verbindungen zurück.
+    /// Calculated on first use and kept till a harbor of the owner is built or destroyed
+    const std::vector<ShipConnection>& GetShipConnections() const;
+    /// Harbors of the owner changed, so the ship connections need to be recalculated
+    void InvalidateShipConnections() { areShipConnectionsValid = false; }
+    /// Number of times the ship connections were calculated (statistics for benchmarks)
+    unsigned GetNumShipConnectionCalcs() const { return numShipConnectionCalcs; }
 
     /// Fügt einen Mensch hinzu, der mit dem Schiff irgendwo hin fahren will
     void AddFigureForShip(std::unique_ptr<noFigure> fig, MapPoint dest);
@@ -211,4 +216,10 @@ public:
 
     /// Is the harbor just being destroyed right now?
     bool IsBeingDestroyedNow() const;
+
+private:
+    /// Cached result of GetShipConnections, only depends on the harbors of the owner
+    mutable std::vector<ShipConnection> shipConnections;
+    mutable bool areShipConnectionsValid = false;
+    mutable unsigned numShipConnectionCalcs = 0;
 };
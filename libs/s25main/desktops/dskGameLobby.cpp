@@ -41,9 +41,11 @@
 #include "libsiedler2/prototypen.h"
 #include "s25util/Log.h"
 #include "s25util/MyTime.h"
+#include <chrono>
 #include <memory>
 #include <mygettext/mygettext.h>
 #include <set>
+#include <stdexcept>
 
 namespace {
 enum CtrlIds
@@ -230,28 +232,15 @@ dskGameLobby::dskGameLobby(ServerType serverType, std::shared_ptr<GameLobby> gam
     combo->AddString(_("Fast"));      // Schnell
     combo->AddString(_("Very fast")); // Sehr Schnell
 
-    // Karte laden, um Kartenvorschau anzuzeigen
+    // Karte im Hintergrund laden, um Kartenvorschau anzuzeigen. Decoding the terrain of big maps takes a while
     if(!gameLobby_->isSavegame())
     {
-        // Map laden
-        libsiedler2::Archiv mapArchiv;
-        // Karteninformationen laden
-        if(int ec = libsiedler2::loader::LoadMAP(GAMECLIENT.GetMapPath(), mapArchiv))
-        {
-            WINDOWMANAGER.ShowAfterSwitch(
-              std::make_unique<iwMsgbox>(_("Error"), _("Could not load map:\n") + libsiedler2::getErrorString(ec), this,
-                                         MsgboxButton::Ok, MsgboxIcon::ExclamationRed, 0));
-        } else
-        {
-            auto* map = static_cast<libsiedler2::ArchivItem_Map*>(mapArchiv.get(0));
-            ctrlPreviewMinimap* preview = AddPreviewMinimap(70, DrawPoint(560, 40), Extent(220, 220), map);
-
-            // Titel der Karte, Y-Position relativ je nach Höhe der Minimap festlegen, daher nochmals danach
-            // verschieben, da diese Position sonst skaliert wird!
-            ctrlText* text = AddText(71, DrawPoint(670, 0), _("Map: ") + GAMECLIENT.GetMapTitle(), COLOR_YELLOW,
-                                     FontStyle::CENTER, NormalFont);
-            text->SetPos(DrawPoint(text->GetPos().x, preview->GetPos().y + preview->GetMapArea().bottom + 10));
-        }
+        mapPreviewLoader_ = std::async(std::launch::async, [mapPath = GAMECLIENT.GetMapPath()]() {
+            auto mapArchiv = std::make_unique<libsiedler2::Archiv>();
+            if(int ec = libsiedler2::loader::LoadMAP(mapPath, *mapArchiv))
+                throw std::runtime_error(libsiedler2::getErrorString(ec));
+            return mapArchiv;
+        });
     }
 
     if(GAMECLIENT.IsAIBattleModeOn())
@@ -308,6 +297,9 @@ dskGameLobby::dskGameLobby(ServerType serverType, std::shared_ptr<GameLobby> gam
 
 dskGameLobby::~dskGameLobby()
 {
+    // Loading can't be canceled. The task only uses its own data, so let it finish and drop the result or error
+    if(mapPreviewLoader_.valid())
+        mapPreviewLoader_.wait();
     if(lobbyClient_)
         lobbyClient_->RemoveListener(this);
     GAMECLIENT.RemoveInterface(this);
@@ -481,11 +473,42 @@ void dskGameLobby::UpdatePlayerRow(const unsigned row)
 void dskGameLobby::Msg_PaintBefore()
 {
     Desktop::Msg_PaintBefore();
+    if(mapPreviewLoader_.valid() && mapPreviewLoader_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        ShowMapPreview();
     // Chatfenster Fokus geben
     if(!IsSinglePlayer())
         GetCtrl<ctrlEdit>(ID_CHAT_INPUT)->SetFocus();
 }
 
+void dskGameLobby::ShowMapPreview()
+{
+    std::unique_ptr<libsiedler2::Archiv> mapArchiv;
+    try
+    {
+        mapArchiv = mapPreviewLoader_.get();
+    } catch(const std::exception& e)
+    {
+        WINDOWMANAGER.Show(std::make_unique<iwMsgbox>(_("Error"), _("Could not load map:\n") + std::string(e.what()),
+                                                      this, MsgboxButton::Ok, MsgboxIcon::ExclamationRed, 0));
+        return;
+    }
+    auto* map = static_cast<libsiedler2::ArchivItem_Map*>(mapArchiv->get(0));
+    ctrlPreviewMinimap* preview = AddPreviewMinimap(70, DrawPoint(560, 40), Extent(220, 220), map);
+
+    // Titel der Karte, Y-Position relativ je nach Höhe der Minimap festlegen, daher nochmals danach
+    // verschieben, da diese Position sonst skaliert wird!
+    ctrlText* text = AddText(71, DrawPoint(670, 0), _("Map: ") + GAMECLIENT.GetMapTitle(), COLOR_YELLOW,
+                             FontStyle::CENTER, NormalFont);
+    text->SetPos(DrawPoint(text->GetPos().x, preview->GetPos().y + preview->GetMapArea().bottom + 10));
+
+    // Colors of the players which joined while the map was loading
+    for(unsigned i = 0; i < gameLobby_->getNumPlayers(); i++)
+    {
+        const JoinPlayerInfo& player = gameLobby_->getPlayer(i);
+        preview->SetPlayerColor(i, player.isUsed() ? player.color : 0);
+    }
+}
+
 void dskGameLobby::Msg_Group_ButtonClick(const unsigned group_id, const unsigned ctrl_id)
 {
     unsigned playerId = group_id - ID_PLAYER_GROUP_START;
@@ -8,6 +8,7 @@
 #include "network/ClientInterface.h"
 #include "gameTypes/ServerType.h"
 #include "liblobby/LobbyInterface.h"
+#include <future>
 #include <memory>
 
 class ctrlChat;
@@ -17,6 +18,9 @@ class LuaInterfaceSettings;
 class GameLobbyController;
 class ILobbyClient;
 enum class Team : uint8_t;
+namespace libsiedler2 {
+class Archiv;
+}
 
 /// Desktop für das Hosten-eines-Spiels-Fenster
 class dskGameLobby final : public Desktop, public ClientInterface, public LobbyInterface
@@ -44,6 +48,9 @@ private:
     void ChangePing(unsigned playerId);
     void ChangeColor(unsigned player, unsigned color);
 
+    /// Add the preview of the map loaded in the background
+    void ShowMapPreview();
+
     void Msg_PaintBefore() override;
     void Msg_Group_ButtonClick(unsigned group_id, unsigned ctrl_id) override;
     void Msg_Group_CheckboxChange(unsigned group_id, unsigned ctrl_id, bool checked) override;
@@ -94,4 +101,6 @@ private:
     bool wasActivated, allowAddonChange;
     ctrlChat *gameChat, *lobbyChat;
     unsigned lobbyChatTabAnimId, localChatTabAnimId;
+    /// Loads the map for the preview in the background
+    std::future<std::unique_ptr<libsiedler2::Archiv>> mapPreviewLoader_;
 };
@@ -5,8 +5,11 @@
 #include "CompressedData.h"
 #include "FileChecksum.h"
 #include "helpers/format.hpp"
+#include "s25util/BinaryFile.h"
 #include "s25util/Log.h"
+#include "s25util/Serializer.h"
 #include <boost/nowide/fstream.hpp>
+#include <algorithm>
 #include <bzlib.h>
 #include <cmath>
 #include <stdexcept>
@@ -100,3 +103,133 @@ std::vector<char> CompressedData::decompress(const std::vector<char>& data, size
 
     return uncompressedData;
 }
+
+void CompressedData::decompress(BinaryFile& file, unsigned compressedSize, unsigned uncompressedSize,
+                                Serializer& output)
+{
+    constexpr unsigned bufferSize = 64 * 1024;
+    std::vector<char> inBuffer(std::max(1u, std::min(bufferSize, compressedSize)));
+    std::vector<char> outBuffer(bufferSize);
+
+    bz_stream stream{};
+    int err = BZ2_bzDecompressInit(&stream, 0, 0);
+    if(err != BZ_OK)
+        throw std::runtime_error(helpers::format("BZ2_bzDecompressInit failed with error: %1%", err));
+    // Free the stream on all exits
+    struct StreamGuard
+    {
+        bz_stream& stream;
+        ~StreamGuard() { BZ2_bzDecompressEnd(&stream); }
+    } guard{stream};
+
+    // Reserve the space for all data so the chunks don't grow the buffer repeatedly. The length is not changed
+    if(uncompressedSize > 0)
+        output.GetDataWritable(output.GetLength() + uncompressedSize);
+
+    unsigned remainingIn = compressedSize;
+    unsigned totalOut = 0;
+    do
+    {
+        if(stream.avail_in == 0 && remainingIn > 0)
+        {
+            const unsigned numRead = std::min<unsigned>(remainingIn, inBuffer.size());
+            file.ReadRawData(inBuffer.data(), numRead);
+            remainingIn -= numRead;
+            stream.next_in = inBuffer.data();
+            stream.avail_in = numRead;
+        }
+        stream.next_out = outBuffer.data();
+        stream.avail_out = outBuffer.size();
+        err = BZ2_bzDecompress(&stream);
+        if(err != BZ_OK && err != BZ_STREAM_END)
+            throw std::runtime_error(helpers::format("BZ2_bzDecompress failed with error: %1%", err));
+        const unsigned numOut = outBuffer.size() - stream.avail_out;
+        if(numOut > uncompressedSize - totalOut)
+            throw std::runtime_error(
+              helpers::format("Length mismatch after decompressing. Expected: %1%, got more", uncompressedSize));
+        totalOut += numOut;
+        output.PushRawData(outBuffer.data(), numOut);
+        // No progress possible with the data we have
+        if(err == BZ_OK && numOut == 0 && stream.avail_in == 0 && remainingIn == 0)
+            throw std::runtime_error("Unexpected end of compressed data");
+    } while(err != BZ_STREAM_END);
+
+    if(totalOut != uncompressedSize)
+        throw std::runtime_error(
+          helpers::format("Length mismatch after decompressing. Expected: %1%, got %2%", uncompressedSize, totalOut));
+    // Skip data after the end of the stream, if any
+    while(remainingIn > 0)
+    {
+        const unsigned numRead = std::min<unsigned>(remainingIn, inBuffer.size());
+        file.ReadRawData(inBuffer.data(), numRead);
+        remainingIn -= numRead;
+    }
+}
+
+struct IncrementalDecompressor::Stream
+{
+    bz_stream bz{};
+    boost::nowide::ofstream file;
+    std::vector<char> outBuffer = std::vector<char>(64 * 1024);
+    // Does nothing if initialization failed
+    ~Stream() { BZ2_bzDecompressEnd(&bz); }
+};
+
+IncrementalDecompressor::IncrementalDecompressor(const boost::filesystem::path& filePath, unsigned uncompressedLength)
+    : stream_(std::make_unique<Stream>()), remainingLength_(uncompressedLength), numBytesAdded_(0), checksum_(0),
+      isFinished_(false)
+{
+    stream_->file.open(filePath, std::ios::binary);
+    if(!stream_->file)
+        throw std::runtime_error(helpers::format("Can't write to %1%", filePath));
+    const int err = BZ2_bzDecompressInit(&stream_->bz, 0, 0);
+    if(err != BZ_OK)
+        throw std::runtime_error(helpers::format("BZ2_bzDecompressInit failed with error: %1%", err));
+}
+
+IncrementalDecompressor::~IncrementalDecompressor() = default;
+
+void IncrementalDecompressor::add(const char* data, size_t size)
+{
+    if(isFinished_)
+    {
+        if(size > 0)
+            throw std::runtime_error("Unexpected data after end of compressed data");
+        return;
+    }
+    bz_stream& bz = stream_->bz;
+    std::vector<char>& outBuffer = stream_->outBuffer;
+    bz.next_in = const_cast<char*>(data);
+    bz.avail_in = size;
+    numBytesAdded_ += size;
+    unsigned numOut;
+    // Continue while there is input left or the output buffer was too small
+    do
+    {
+        bz.next_out = outBuffer.data();
+        bz.avail_out = outBuffer.size();
+        const int err = BZ2_bzDecompress(&bz);
+        if(err != BZ_OK && err != BZ_STREAM_END)
+            throw std::runtime_error(helpers::format("BZ2_bzDecompress failed with error: %1%", err));
+        numOut = outBuffer.size() - bz.avail_out;
+        if(numOut > remainingLength_)
+            throw std::runtime_error("Length mismatch after decompressing: Got more data than expected");
+        remainingLength_ -= numOut;
+        checksum_ += CalcChecksumOfBuffer(outBuffer.data(), numOut);
+        if(!stream_->file.write(outBuffer.data(), numOut))
+            throw std::runtime_error("Writing decompressed data failed");
+        isFinished_ = err == BZ_STREAM_END;
+    } while(!isFinished_ && (bz.avail_in > 0 || numOut == outBuffer.size()));
+
+    if(isFinished_)
+    {
+        if(bz.avail_in > 0)
+            throw std::runtime_error("Unexpected data after end of compressed data");
+        if(remainingLength_ != 0)
+            throw std::runtime_error(
+              helpers::format("Length mismatch after decompressing: %1% bytes missing", remainingLength_));
+        stream_->file.close();
+        if(!stream_->file)
+            throw std::runtime_error("Writing decompressed data failed");
+    }
+}
@@ -5,9 +5,13 @@
 #pragma once
 
 #include <boost/filesystem/path.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
+class BinaryFile;
+class Serializer;
+
 /// Holds compressed data
 struct CompressedData
 {
@@ -27,4 +31,34 @@ struct CompressedData
 
     static std::vector<char> compress(const std::vector<char>& data);
     static std::vector<char> decompress(const std::vector<char>& data, size_t uncompressedSize);
+    /// Decompress compressedSize bytes read from the file and append them to the serializer.
+    /// Uses only a small buffer instead of reading the whole compressed data first
+    static void decompress(BinaryFile& file, unsigned compressedSize, unsigned uncompressedSize, Serializer& output);
+};
+
+/// Decompresses data received in consecutive parts (e.g. the map sent by the server) directly to a file.
+/// So decompression and checksum calculation can be done while the remaining data is still being transferred
+class IncrementalDecompressor
+{
+public:
+    /// Throws if the file cannot be opened
+    IncrementalDecompressor(const boost::filesystem::path& filePath, unsigned uncompressedLength);
+    ~IncrementalDecompressor();
+
+    /// Decompress the next part of the compressed data and write it to the file. Throws on error
+    void add(const char* data, size_t size);
+    /// True if all data was decompressed and written
+    bool isFinished() const { return isFinished_; }
+    /// Number of compressed bytes added so far
+    size_t getNumBytesAdded() const { return numBytesAdded_; }
+    /// Checksum of the uncompressed data written so far
+    unsigned getChecksum() const { return checksum_; }
+
+private:
+    struct Stream;
+    std::unique_ptr<Stream> stream_;
+    unsigned remainingLength_;
+    size_t numBytesAdded_;
+    unsigned checksum_;
+    bool isFinished_;
 };
@@ -4,10 +4,10 @@
 
 #include "gameTypes/MapNode.h"
 #include "SerializedGameData.h"
-#include "nodeObjs/noBase.h"
 #include "gameData/TerrainDesc.h"
 #include "gameData/WorldDescription.h"
 #include <algorithm>
+#include <memory>
 
 MapNode::MapNode()
     : altitude(10), shadow(64), t1(0), t2(0), resources(0), reserved(false), owner(0), bq(BuildingQuality::Nothing),
@@ -17,7 +17,18 @@ MapNode::MapNode()
     std::fill(boundary_stones.begin(), boundary_stones.end(), 0);
 }
 
-void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc) const
+MapNode::~MapNode()
+{
+    clearFigures();
+}
+
+void MapNode::clearFigures()
+{
+    figures.clear_and_dispose(std::default_delete<noBase>());
+}
+
+void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc,
+                        const FoWNode* fow) const
 {
     helpers::pushContainer(sgd, roads);
     sgd.PushUnsignedChar(altitude);
@@ -28,17 +39,19 @@ void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, cons
     sgd.PushBool(reserved);
     sgd.PushUnsignedChar(owner);
     helpers::pushContainer(sgd, boundary_stones);
-    RTTR_Assert(numPlayers <= fow.size());
+    RTTR_Assert(numPlayers <= MAX_PLAYERS);
     for(unsigned z = 0; z < numPlayers; ++z)
         fow[z].Serialize(sgd);
     sgd.PushObject(obj);
-    sgd.PushObjectContainer(figures);
+    sgd.PushVarSize(figures.size());
+    for(const noBase& figure : figures)
+        sgd.PushObject(&figure);
     sgd.PushUnsignedShort(seaId);
     sgd.PushUnsignedInt(harborId);
 }
 
 void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc,
-                          const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains)
+                          const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains, FoWNode* fow)
 {
     helpers::popContainer(sgd, roads);
 
@@ -67,11 +80,14 @@ void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, co
     helpers::popContainer(sgd, boundary_stones);
     if(sgd.GetGameDataVersion() < 9)
         bq = sgd.Pop<BuildingQuality>();
-    RTTR_Assert(numPlayers <= fow.size());
+    RTTR_Assert(numPlayers <= MAX_PLAYERS);
     for(unsigned z = 0; z < numPlayers; ++z)
         fow[z].Deserialize(sgd);
     obj = sgd.PopObject<noBase>();
-    sgd.PopObjectContainer(figures);
+    clearFigures();
+    const unsigned numFigures = (sgd.GetGameDataVersion() >= 2) ? sgd.PopVarSize() : sgd.PopUnsignedInt();
+    for(unsigned i = 0; i < numFigures; ++i)
+        figures.push_back(*sgd.PopObject<noBase>());
     seaId = sgd.PopUnsignedShort();
     harborId = sgd.PopUnsignedInt();
 }
@@ -6,22 +6,39 @@
 
 #include "Resource.h"
 #include "helpers/EnumArray.h"
+#include "nodeObjs/noBase.h"
 #include "gameTypes/BuildingQuality.h"
 #include "gameTypes/FoWNode.h"
 #include "gameTypes/MapTypes.h"
 #include "gameData/DescIdx.h"
 #include "gameData/MaxPlayers.h"
-#include <array>
-#include <list>
-#include <memory>
+#include <boost/intrusive/list.hpp>
 #include <vector>
 
-class noBase;
 class SerializedGameData;
 struct TerrainDesc;
 struct WorldDescription;
 
+/// List of the figures on a node. Does not allocate, the links are stored in the figures (see FigureListHook)
+using FigureList = boost::intrusive::list<noBase, boost::intrusive::base_hook<FigureListHook>>;
+
+/// View of a figure list which allows access to the figures but not modifications of the list
+class FigureRange
+{
+    FigureList& figures_;
+
+public:
+    explicit FigureRange(FigureList& figures) : figures_(figures) {}
+    FigureList::iterator begin() const { return figures_.begin(); }
+    FigureList::iterator end() const { return figures_.end(); }
+    noBase& front() const { return figures_.front(); }
+    noBase& back() const { return figures_.back(); }
+    bool empty() const { return figures_.empty(); }
+    size_t size() const { return figures_.size(); }
+};
+
 /// Eigenschaften von einem Punkt auf der Map
+/// The FoW state of the players is stored separately (see World::GetFoWNode) to keep this small
 struct MapNode
 {
     /// Roads from this point: E, SE, SW
@@ -41,8 +58,6 @@ struct MapNode
     unsigned char owner;
     BoundaryStones boundary_stones;
     BuildingQuality bq;
-    /// How the players see the point in FoW
-    std::array<FoWNode, MAX_PLAYERS> fow;
 
     /// To which sea this belongs to (0=None)
     unsigned short seaId;
@@ -51,15 +66,20 @@ struct MapNode
 
     /// Objekt, welches sich dort befindet
     noBase* obj;
-    /// Figures or fights on this node
-    std::list<std::unique_ptr<noBase>> figures;
+    /// Figures or fights on this node. Owned by the node
+    FigureList figures;
 
     MapNode();
+    ~MapNode();
     MapNode(const MapNode&) = delete;
     MapNode(MapNode&&) = default;
     MapNode& operator=(const MapNode&) = delete;
     MapNode& operator=(MapNode&&) = default;
-    void Serialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc) const;
+    /// Remove and destroy all figures
+    void clearFigures();
+    /// Serialize the node including the FoW nodes of the first numPlayers players
+    void Serialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc,
+                   const FoWNode* fow) const;
     void Deserialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc,
-                     const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains);
+                     const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains, FoWNode* fow);
 };
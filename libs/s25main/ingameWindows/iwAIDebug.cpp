@@ -6,6 +6,7 @@
 #include "Loader.h"
 #include "ai/AIEvents.h"
 #include "ai/aijh/AIPlayerJH.h"
+#include "ai/aijh/AIWorkBudget.h"
 #include "ai/aijh/Jobs.h"
 #include "controls/ctrlComboBox.h"
 #include "controls/ctrlMultiline.h"
@@ -27,6 +28,24 @@ enum
     ID_CbOverlay,
     ID_Text
 };
+
+/// Budget and histogram of the work done per GF
+std::string getWorkStats(const AIJH::AIWorkBudget& budget)
+{
+    std::stringstream ss;
+    ss << "Work budget: " << budget.GetAvailable() << " (+" << budget.GetBudgetPerGF() << "/GF)" << std::endl;
+    ss << "GFs by work:";
+    const AIJH::AIWorkBudget::Histogram& histogram = budget.GetHistogram();
+    for(unsigned i = 0; i < histogram.size(); i++)
+    {
+        if(i % 4 == 0)
+            ss << std::endl;
+        else
+            ss << "  ";
+        ss << AIJH::AIWorkBudget::GetBucketStart(i) << (i + 1 < histogram.size() ? "" : "+") << ": " << histogram[i];
+    }
+    return ss.str();
+}
 }
 
 class iwAIDebug::DebugPrinter : public IDrawNodeCallback
@@ -112,8 +131,8 @@ iwAIDebug::iwAIDebug(GameWorldView& gwv, const std::vector<const AIPlayer*>& ais
     overlays->AddString("Borderland");
     overlays->AddString("Fish");
 
-    // Show 7 lines of text and 1 empty line
-    text = AddMultiline(ID_Text, DrawPoint(15, 120), Extent(250, 8 * NormalFont->getHeight()), TextureColor::Grey,
+    // Show 7 lines of text, 1 empty line and 5 lines of work statistics
+    text = AddMultiline(ID_Text, DrawPoint(15, 120), Extent(250, 13 * NormalFont->getHeight()), TextureColor::Grey,
                         NormalFont, FontStyle::NO_OUTLINE);
 
     SetIwSize(Extent(GetIwSize().x, text->GetPos().y + text->GetSize().y));
@@ -152,6 +171,7 @@ void iwAIDebug::Msg_PaintBefore()
     {
         text->Clear();
         text->AddString(_("No current job"), COLOR_YELLOW);
+        text->AddString(getWorkStats(printer->ai->GetWorkBudget()), COLOR_YELLOW);
         return;
     }
 
@@ -213,6 +233,8 @@ void iwAIDebug::Msg_PaintBefore()
         default: ss << "Unknown status"; break;
     }
 
+    ss << std::endl << getWorkStats(printer->ai->GetWorkBudget());
+
     text->Clear();
     text->AddString(ss.str(), COLOR_YELLOW);
 }
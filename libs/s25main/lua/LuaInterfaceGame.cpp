@@ -180,6 +180,15 @@ LuaInterfaceGame::LuaInterfaceGame(Game& gameInstance, ILocalGameState& localGam
     LuaWorld::Register(lua);
 
     lua["rttr"] = this;
+    // Get notified about new globals, so handlers defined at runtime (e.g. by other handlers) are used right away
+    lua["rttrOnGlobalDefined"] = kaguya::function([this](const std::string& name) { onGlobalDefined(name); });
+    lua.dostring("local onDefined = rttrOnGlobalDefined\n"
+                 "rttrOnGlobalDefined = nil\n"
+                 "setmetatable(_G, {__newindex = function(t, k, v)\n"
+                 "    rawset(t, k, v)\n"
+                 "    if type(k) == 'string' then onDefined(k) end\n"
+                 "end})");
+    updateDefinedHandlers();
 }
 
 LuaInterfaceGame::~LuaInterfaceGame() = default;
@@ -220,7 +229,9 @@ bool LuaInterfaceGame::Serialize(Serializer& luaSaveState)
     if(save.type() == LUA_TFUNCTION)
     {
         clearErrorOccured();
-        if(save.call<bool>(kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred())
+        const bool result = save.call<bool>(kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred();
+        updateDefinedHandlers();
+        if(result)
             return true;
         else
         {
@@ -237,11 +248,51 @@ bool LuaInterfaceGame::Deserialize(Serializer& luaSaveState)
     if(load.type() == LUA_TFUNCTION)
     {
         clearErrorOccured();
-        return load.call<bool>(kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred();
+        const bool result = load.call<bool>(kaguya::standard::ref(luaSaveState)) && !hasErrorOccurred();
+        updateDefinedHandlers();
+        return result;
     } else
         return true;
 }
 
+void LuaInterfaceGame::onScriptLoaded()
+{
+    updateDefinedHandlers();
+}
+
+void LuaInterfaceGame::onGlobalDefined(const std::string& name)
+{
+    // Handlers which got removed are noticed when they are looked up for the next event
+    if(name.compare(0, 2, "on") == 0)
+        updateDefinedHandlers();
+}
+
+bool LuaInterfaceGame::isFunction(const char* name)
+{
+    return lua[name].type() == LUA_TFUNCTION;
+}
+
+void LuaInterfaceGame::updateDefinedHandlers()
+{
+    handlers_.explored = isFunction("onExplored");
+    handlers_.exploredBatch = isFunction("onExploredBatch");
+    handlers_.occupied = isFunction("onOccupied");
+    handlers_.occupiedBatch = isFunction("onOccupiedBatch");
+    handlers_.attack = isFunction("onAttack");
+    handlers_.start = isFunction("onStart");
+    handlers_.gameFrame = isFunction("onGameFrame");
+    handlers_.resourceFound = isFunction("onResourceFound");
+    handlers_.cancelPactRequest = isFunction("onCancelPactRequest");
+    handlers_.suggestPact = isFunction("onSuggestPact");
+    handlers_.pactCanceled = isFunction("onPactCanceled");
+    handlers_.pactCreated = isFunction("onPactCreated");
+    // Drop events for handlers which got removed
+    if(!handlers_.exploredBatch)
+        exploredBatch_.clear();
+    if(!handlers_.occupiedBatch)
+        occupiedBatch_.clear();
+}
+
 void LuaInterfaceGame::ClearResources()
 {
     for(unsigned p = 0; p < gw.GetNumPlayers(); p++)
@@ -326,6 +377,14 @@ LuaWorld LuaInterfaceGame::GetWorld()
 
 void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigned char owner)
 {
+    if(handlers_.exploredBatch)
+    {
+        if(player >= exploredBatch_.size())
+            exploredBatch_.resize(player + 1);
+        exploredBatch_[player].emplace_back(pt, owner);
+    }
+    if(!handlers_.explored)
+        return;
     kaguya::LuaRef onExplored = lua["onExplored"];
     if(onExplored.type() == LUA_TFUNCTION)
     {
@@ -343,6 +402,14 @@ void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigne
 
 void LuaInterfaceGame::EventOccupied(unsigned player, const MapPoint pt)
 {
+    if(handlers_.occupiedBatch)
+    {
+        if(player >= occupiedBatch_.size())
+            occupiedBatch_.resize(player + 1);
+        occupiedBatch_[player].push_back(pt);
+    }
+    if(!handlers_.occupied)
+        return;
     kaguya::LuaRef onOccupied = lua["onOccupied"];
     if(onOccupied.type() == LUA_TFUNCTION)
         onOccupied.call<void>(player, pt.x, pt.y);
@@ -351,6 +418,8 @@ void LuaInterfaceGame::EventOccupied(unsigned player, const MapPoint pt)
 void LuaInterfaceGame::EventAttack(unsigned char attackerPlayerId, unsigned char defenderPlayerId,
                                    unsigned attackerCount)
 {
+    if(!handlers_.attack)
+        return;
     kaguya::LuaRef onAttack = lua["onAttack"];
     if(onAttack.type() == LUA_TFUNCTION)
         onAttack.call<void>(attackerPlayerId, defenderPlayerId, attackerCount);
@@ -358,6 +427,8 @@ void LuaInterfaceGame::EventAttack(unsigned char attackerPlayerId, unsigned char
 
 void LuaInterfaceGame::EventStart(bool isFirstStart)
 {
+    if(!handlers_.start)
+        return;
     kaguya::LuaRef onStart = lua["onStart"];
     if(onStart.type() == LUA_TFUNCTION)
         onStart.call<void>(isFirstStart);
@@ -365,14 +436,69 @@ void LuaInterfaceGame::EventStart(bool isFirstStart)
 
 void LuaInterfaceGame::EventGameFrame(unsigned nr)
 {
+    // Once per GF catch up on changes not noticed otherwise, e.g. a function assigned to an existing global
+    updateDefinedHandlers();
+    if(!handlers_.gameFrame)
+        return;
     kaguya::LuaRef onGameFrame = lua["onGameFrame"];
     if(onGameFrame.type() == LUA_TFUNCTION)
         onGameFrame.call<void>(nr);
 }
 
+void LuaInterfaceGame::SendBatchedEvents()
+{
+    // Swap out first as the handlers might cause new events
+    std::vector<std::vector<std::pair<MapPoint, unsigned char>>> explored;
+    std::swap(explored, exploredBatch_);
+    std::vector<std::vector<MapPoint>> occupied;
+    std::swap(occupied, occupiedBatch_);
+
+    for(unsigned player = 0; player < explored.size(); player++)
+    {
+        if(explored[player].empty())
+            continue;
+        kaguya::LuaRef onExploredBatch = lua["onExploredBatch"];
+        if(onExploredBatch.type() != LUA_TFUNCTION)
+            break;
+        kaguya::LuaTable points = lua.newTable();
+        int idx = 1;
+        for(const auto& ptAndOwner : explored[player])
+        {
+            kaguya::LuaTable entry = lua.newTable();
+            entry[1] = ptAndOwner.first.x;
+            entry[2] = ptAndOwner.first.y;
+            // Adapt owner to be comparable with the player index, nil if there is no owner
+            if(ptAndOwner.second != 0)
+                entry[3] = ptAndOwner.second - 1;
+            points[idx++] = entry;
+        }
+        onExploredBatch.call<void>(player, points);
+    }
+    for(unsigned player = 0; player < occupied.size(); player++)
+    {
+        if(occupied[player].empty())
+            continue;
+        kaguya::LuaRef onOccupiedBatch = lua["onOccupiedBatch"];
+        if(onOccupiedBatch.type() != LUA_TFUNCTION)
+            break;
+        kaguya::LuaTable points = lua.newTable();
+        int idx = 1;
+        for(const MapPoint pt : occupied[player])
+        {
+            kaguya::LuaTable entry = lua.newTable();
+            entry[1] = pt.x;
+            entry[2] = pt.y;
+            points[idx++] = entry;
+        }
+        onOccupiedBatch.call<void>(player, points);
+    }
+}
+
 void LuaInterfaceGame::EventResourceFound(unsigned char player, const MapPoint pt, ResourceType type,
                                           unsigned char quantity)
 {
+    if(!handlers_.resourceFound)
+        return;
     kaguya::LuaRef onResourceFound = lua["onResourceFound"];
     if(onResourceFound.type() == LUA_TFUNCTION)
         onResourceFound.call<void>(player, pt.x, pt.y, type, quantity);
@@ -381,6 +507,8 @@ void LuaInterfaceGame::EventResourceFound(unsigned char player, const MapPoint p
 bool LuaInterfaceGame::EventCancelPactRequest(PactType pt, unsigned char canceledByPlayerId,
                                               unsigned char targetPlayerId)
 {
+    if(!handlers_.cancelPactRequest)
+        return true;
     kaguya::LuaRef onPactCancel = lua["onCancelPactRequest"];
     if(onPactCancel.type() == LUA_TFUNCTION)
         return onPactCancel.call<bool>(pt, canceledByPlayerId, targetPlayerId);
@@ -391,7 +519,7 @@ void LuaInterfaceGame::EventSuggestPact(const PactType pt, unsigned char suggest
                                         unsigned char targetPlayerId, const unsigned duration)
 {
     AIPlayer* ai = game.GetAIPlayer(targetPlayerId);
-    if(ai != nullptr)
+    if(ai != nullptr && handlers_.suggestPact)
     {
         kaguya::LuaRef onPactCancel = lua["onSuggestPact"];
         if(onPactCancel.type() == LUA_TFUNCTION)
@@ -409,6 +537,8 @@ void LuaInterfaceGame::EventSuggestPact(const PactType pt, unsigned char suggest
 void LuaInterfaceGame::EventPactCanceled(const PactType pt, unsigned char canceledByPlayerId,
                                          unsigned char targetPlayerId)
 {
+    if(!handlers_.pactCanceled)
+        return;
     kaguya::LuaRef onPactCanceled = lua["onPactCanceled"];
     if(onPactCanceled.type() == LUA_TFUNCTION)
     {
@@ -419,6 +549,8 @@ void LuaInterfaceGame::EventPactCanceled(const PactType pt, unsigned char cancel
 void LuaInterfaceGame::EventPactCreated(const PactType pt, unsigned char suggestedByPlayerId,
                                         unsigned char targetPlayerId, const unsigned duration)
 {
+    if(!handlers_.pactCreated)
+        return;
     kaguya::LuaRef onPactCreated = lua["onPactCreated"];
     if(onPactCreated.type() == LUA_TFUNCTION)
     {
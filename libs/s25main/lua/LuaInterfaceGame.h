@@ -9,6 +9,8 @@
 #include "gameTypes/PactTypes.h"
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 class GameWorld;
 class LuaPlayer;
@@ -34,6 +36,8 @@ public:
     void EventAttack(unsigned char attackerPlayerId, unsigned char defenderPlayerId, unsigned attackerCount);
     void EventStart(bool isFirstStart);
     void EventGameFrame(unsigned nr);
+    /// Deliver the events collected during the GF to the batch handlers (e.g. onExploredBatch)
+    void SendBatchedEvents();
     void EventResourceFound(unsigned char player, MapPoint pt, ResourceType type, unsigned char quantity);
     // Called if player wants to cancel a pact
     bool EventCancelPactRequest(PactType pt, unsigned char canceledByPlayerId, unsigned char targetPlayerId);
@@ -59,10 +63,33 @@ public:
     void PostMessageLua(int playerIdx, const std::string& msg);
     void PostMessageWithLocation(int playerIdx, const std::string& msg, int x, int y);
 
+protected:
+    void onScriptLoaded() override;
+
 private:
+    /// Which event handlers (on*-functions) the script defines. Avoids looking them up for every event
+    struct DefinedHandlers
+    {
+        bool explored = false, exploredBatch = false;
+        bool occupied = false, occupiedBatch = false;
+        bool attack = false, start = false, gameFrame = false, resourceFound = false;
+        bool cancelPactRequest = false, suggestPact = false, pactCanceled = false, pactCreated = false;
+    };
+
     ILocalGameState& localGameState;
     GameWorld& gw;
     Game& game;
+    DefinedHandlers handlers_;
+    /// Points (and their owner) explored during the current GF per player for onExploredBatch
+    std::vector<std::vector<std::pair<MapPoint, unsigned char>>> exploredBatch_;
+    /// Points occupied during the current GF per player for onOccupiedBatch
+    std::vector<std::vector<MapPoint>> occupiedBatch_;
+
+    bool isFunction(const char* name);
+    /// Update which handlers are defined. Done after loading a script, onLoad, onSave and once per GF
+    void updateDefinedHandlers();
+    /// Called by Lua when a new global is set, so handlers defined e.g. by other handlers are used right away
+    void onGlobalDefined(const std::string& name);
     LuaPlayer GetPlayer(int playerIdx);
     LuaWorld GetWorld();
 };
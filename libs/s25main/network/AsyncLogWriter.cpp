@@ -0,0 +1,139 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AsyncLogWriter.h"
+#include "Savegame.h"
+#include "random/randomIO.h"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+void writeAsyncLog(std::ostream& os, const std::string& mapTitle, const std::vector<PlayerAsyncLog>& logs,
+                   unsigned numIdentical)
+{
+    os << "Map: " << mapTitle << std::endl;
+    os << std::setfill(' ');
+    for(const PlayerAsyncLog& log : logs)
+    {
+        os << "Player " << std::setw(2) << log.playerId << (log.isHost ? '#' : ' ') << "\t\"" << log.name << '"'
+           << std::endl;
+        os << "System info: " << log.systemInfo << std::endl;
+        os << "\tChecksum: " << std::setw(0) << log.checksum << std::endl;
+    }
+    for(const PlayerAsyncLog& log : logs)
+        os << "Checksum " << std::setw(2) << log.playerId << std::setw(0) << ": " << log.checksum << std::endl;
+
+    if(logs.empty())
+        return;
+    size_t numEntries = 0;
+    for(const PlayerAsyncLog& log : logs)
+        numEntries = std::max(numEntries, log.randEntries.size());
+    // print identical lines, they help in tracing the bug
+    for(unsigned i = 0; i < numIdentical; i++)
+        os << "[ I ]: " << logs[0].randEntries[i] << "\n";
+    for(size_t i = numIdentical; i < numEntries; i++)
+    {
+        for(const PlayerAsyncLog& log : logs)
+        {
+            if(i < log.randEntries.size())
+                os << "[C" << std::setw(2) << log.playerId << std::setw(0) << "]: " << log.randEntries[i] << '\n';
+        }
+    }
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    if(thread_.joinable())
+        thread_.join();
+}
+
+void AsyncLogWriter::addJob(Job job, Callback onFinished)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(Task{std::move(job), std::move(onFinished)});
+        if(!thread_.joinable())
+            thread_ = std::thread(&AsyncLogWriter::run, this);
+    }
+    cond_.notify_all();
+}
+
+void AsyncLogWriter::poll()
+{
+    std::vector<std::pair<Callback, bool>> finishedTasks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finishedTasks.swap(finishedTasks_);
+    }
+    // Without the lock, the callbacks may add new jobs
+    for(const auto& task : finishedTasks)
+    {
+        if(task.first)
+            task.first(task.second);
+    }
+}
+
+void AsyncLogWriter::waitForAll()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]() { return tasks_.empty() && !isRunningTask_; });
+    }
+    poll();
+}
+
+bool AsyncLogWriter::isIdle() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.empty() && !isRunningTask_;
+}
+
+void AsyncLogWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while(true)
+    {
+        cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+        // Finish all jobs before stopping so no logs get lost
+        if(tasks_.empty())
+            return;
+        Task task = std::move(tasks_.front());
+        tasks_.pop_front();
+        isRunningTask_ = true;
+        lock.unlock();
+        bool success;
+        try
+        {
+            success = task.job();
+        } catch(const std::exception&)
+        {
+            success = false;
+        }
+        lock.lock();
+        isRunningTask_ = false;
+        finishedTasks_.emplace_back(std::move(task.onFinished), success);
+        cond_.notify_all();
+    }
+}
+
+void addClientAsyncLogJob(AsyncLogWriter& writer, const boost::filesystem::path& logFilePath,
+                          std::vector<RandomEntry> randomLog, const boost::filesystem::path& saveFilePath,
+                          std::shared_ptr<Savegame> save, const std::string& mapTitle,
+                          AsyncLogWriter::Callback onFinished)
+{
+    // std::function requires copyable functors
+    auto sharedLog = std::make_shared<const std::vector<RandomEntry>>(std::move(randomLog));
+    writer.addJob(
+      [logFilePath, sharedLog, saveFilePath, save, mapTitle]() {
+          saveRandomLog(logFilePath, *sharedLog);
+          return save && save->Save(saveFilePath, mapTitle);
+      },
+      std::move(onFinished));
+}
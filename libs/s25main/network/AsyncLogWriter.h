@@ -0,0 +1,85 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "AsyncChecksum.h"
+#include "random/Random.h"
+#include <boost/filesystem/path.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class Savegame;
+
+/// Data of one player written to the async log of the server
+struct PlayerAsyncLog
+{
+    unsigned playerId;
+    bool isHost;
+    std::string name;
+    std::string systemInfo;
+    AsyncChecksum checksum;
+    std::vector<RandomEntry> randEntries;
+};
+
+/// Write the async log of the server comparing the RNG entries of all players.
+/// The first numIdentical entries are equal for all players and written only once
+void writeAsyncLog(std::ostream& os, const std::string& mapTitle, const std::vector<PlayerAsyncLog>& logs,
+                   unsigned numIdentical);
+
+/// Runs the formatting, compression and writing of async (desync) logs and savegames on a worker thread,
+/// so the game and the lobby stay responsive meanwhile.
+/// Jobs must only use the data passed to them, not the game or other global state.
+class AsyncLogWriter
+{
+public:
+    /// Executed on the worker thread. Returns true on success
+    using Job = std::function<bool()>;
+    /// Executed by poll() in the owners thread with the result of the job
+    using Callback = std::function<void(bool success)>;
+
+    AsyncLogWriter() = default;
+    /// Finishes all remaining jobs, but does not run their callbacks
+    ~AsyncLogWriter();
+
+    void addJob(Job job, Callback onFinished = Callback());
+    /// Run the callbacks of all finished jobs
+    void poll();
+    /// Wait till all jobs are finished and run their callbacks
+    void waitForAll();
+    /// True if there are no unfinished jobs
+    bool isIdle() const;
+
+private:
+    struct Task
+    {
+        Job job;
+        Callback onFinished;
+    };
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<Task> tasks_;
+    std::vector<std::pair<Callback, bool>> finishedTasks_;
+    bool isRunningTask_ = false;
+    bool stop_ = false;
+    std::thread thread_;
+
+    void run();
+};
+
+/// Write the RNG history of a client to logFilePath and the savegame of the desynced game to saveFilePath using the
+/// writer. The result is only successful if the savegame (null if it could not be created) was written
+void addClientAsyncLogJob(AsyncLogWriter& writer, const boost::filesystem::path& logFilePath,
+                          std::vector<RandomEntry> randomLog, const boost::filesystem::path& saveFilePath,
+                          std::shared_ptr<Savegame> save, const std::string& mapTitle,
+                          AsyncLogWriter::Callback onFinished);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "GameProtocol.h"
 #include "gameTypes/ServerType.h"
 #include <string>
 #include <utility>
@@ -17,6 +18,8 @@ struct CreateServerInfo
     const std::string password;
     const bool ipv6; // IPv6 or IPv4
     const bool use_upnp;
+    /// Limits for the messages the server accepts from each player
+    PlayerMsgLimits msgLimits;
     CreateServerInfo(ServerType type, uint16_t port, std::string gameName, std::string password = "", bool ipv6 = false,
                      bool useUpnp = false)
         : type(type), port(port), gameName(std::move(gameName)), password(std::move(password)), ipv6(ipv6),
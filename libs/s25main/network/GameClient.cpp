@@ -3,8 +3,10 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "GameClient.h"
+#include "AsyncLogWriter.h"
 #include "CreateServerInfo.h"
 #include "EventManager.h"
+#include "GFTimeBudget.h"
 #include "Game.h"
 #include "GameEvent.h"
 #include "GameLobby.h"
@@ -39,12 +41,12 @@
 #include "world/GameWorld.h"
 #include "world/GameWorldView.h"
 #include "world/MapLoader.h"
+#include "gameTypes/CompressedData.h"
 #include "gameTypes/RoadBuildState.h"
 #include "gameData/GameConsts.h"
 #include "libsiedler2/ArchivItem_Map.h"
 #include "libsiedler2/ArchivItem_Map_Header.h"
 #include "libsiedler2/prototypen.h"
-#include "s25util/SocketSet.h"
 #include "s25util/StringConversion.h"
 #include "s25util/System.h"
 #include "s25util/fileFuncs.h"
@@ -54,6 +56,11 @@
 #include <helpers/chronoIO.h>
 #include <memory>
 
+namespace {
+/// Maximum time spent executing GFs in one call to ExecuteGameFrame before the next visual frame is drawn
+constexpr auto maxGFTimePerCall = std::chrono::milliseconds(40);
+} // namespace
+
 void GameClient::ClientConfig::Clear()
 {
     server.clear();
@@ -129,7 +136,10 @@ bool GameClient::HostGame(const CreateServerInfo& csi, const boost::filesystem::
 #endif
         copy_file(map_path, playedMapPath, overwrite_existing, ignoredEc);
     }
-    return GAMESERVER.Start(csi, map_path, map_type, hostPw)
+    CreateServerInfo serverInfo = csi;
+    serverInfo.msgLimits.maxQueuedMsgs = SETTINGS.server.maxQueuedMsgs;
+    serverInfo.msgLimits.maxMsgsPerSecond = SETTINGS.server.maxMsgsPerSecond;
+    return GAMESERVER.Start(serverInfo, map_path, map_type, hostPw)
            && Connect("localhost", hostPw, csi.type, csi.port, true, csi.ipv6);
 }
 
@@ -138,41 +148,21 @@ bool GameClient::HostGame(const CreateServerInfo& csi, const boost::filesystem::
  */
 void GameClient::Run()
 {
+    // Report finished async logs also when the game was left meanwhile
+    if(asyncLogWriter_)
+        asyncLogWriter_->poll();
+
     if(state == ClientState::Stopped)
         return;
 
-    SocketSet set;
-
-    // erstmal auf Daten überprüfen
-    set.Clear();
-
-    // zum set hinzufügen
-    set.Add(mainPlayer.socket);
-    if(set.Select(0, 0) > 0)
-    {
-        // nachricht empfangen
-        if(!mainPlayer.receiveMsgs())
-        {
-            LOG.write("Receiving Message from server failed\n");
-            ServerLost();
-        }
-    }
-
-    // nun auf Fehler prüfen
-    set.Clear();
-
-    // zum set hinzufügen
-    set.Add(mainPlayer.socket);
-
-    // auf fehler prüfen
-    if(set.Select(0, 2) > 0)
+    // Send and receive in a separate thread so the latency does not depend on the frame rate
+    if(!mainPlayer.ioThread && mainPlayer.socket.isValid())
+        mainPlayer.startIOThread();
+    // Closing the connection on error stops the thread, so this is reported only once
+    if(mainPlayer.ioThread && !mainPlayer.receiveMsgs())
     {
-        if(set.InSet(mainPlayer.socket))
-        {
-            // Server ist weg
-            LOG.write("Error on socket to server\n");
-            ServerLost();
-        }
+        LOG.write("Connection to server failed\n");
+        ServerLost();
     }
 
     if(state == ClientState::Loaded)
@@ -183,7 +173,7 @@ void GameClient::Run()
     } else if(state == ClientState::Game)
         ExecuteGameFrame();
 
-    // maximal 10 Pakete verschicken
+    // maximal 10 Pakete verschicken (only without I/O thread, e.g. in replays)
     mainPlayer.sendMsgs(10);
 
     mainPlayer.executeMsgs(*this);
@@ -208,6 +198,7 @@ void GameClient::Stop()
     framesinfo.Clear();
     clientconfig.Clear();
     mapinfo.Clear();
+    mapDecompressor_.reset();
 
     if(replayinfo)
     {
@@ -840,9 +831,28 @@ bool GameClient::OnGameMessage(const GameMessage_Server_Async& msg)
     const bfs::path filePathSave = RTTRCONFIG.ExpandPath(s25::folders::save) / makePortableFileName(fileName + ".sav");
     const bfs::path filePathLog =
       RTTRCONFIG.ExpandPath(s25::folders::logs) / makePortableFileName(fileName + "Player.log");
-    saveRandomLog(filePathLog, RANDOM.GetAsyncLog());
-    SaveToFile(filePathSave);
-    LOG.write(_("Async log saved at %1%,\ngame saved at %2%\n")) % filePathLog % filePathSave;
+
+    mainPlayer.sendMsg(GameMessage_Chat(GetPlayerId(), ChatDestination::System, "Saving game..."));
+    // Only take the snapshots here. Formatting, compressing and writing is done in the background
+    auto save = std::make_shared<Savegame>();
+    try
+    {
+        MakeSavegame(*save);
+    } catch(std::exception& e)
+    {
+        SystemChat(std::string("Error during saving: ") + e.what());
+        save.reset();
+    }
+    if(!asyncLogWriter_)
+        asyncLogWriter_ = std::make_unique<AsyncLogWriter>();
+    addClientAsyncLogJob(
+      *asyncLogWriter_, filePathLog, RANDOM.GetAsyncLog(), filePathSave, std::move(save), mapinfo.title,
+      [this, filePathLog, filePathSave](bool success) {
+          if(success)
+              LOG.write(_("Async log saved at %1%,\ngame saved at %2%\n")) % filePathLog % filePathSave;
+          else
+              SystemChat(std::string("Error during saving: ") + filePathSave.string());
+      });
     return true;
 }
 
@@ -931,6 +941,15 @@ bool GameClient::OnGameMessage(const GameMessage_Map_Info& msg)
     mapinfo.luaData.uncompressedLength = msg.luaLen;
     mapinfo.mapData.data.resize(msg.mapCompressedLen);
     mapinfo.luaData.data.resize(msg.luaCompressedLen);
+    try
+    {
+        mapDecompressor_ = std::make_unique<IncrementalDecompressor>(mapinfo.filepath, msg.mapLen);
+    } catch(const std::runtime_error& e)
+    {
+        // Decompressed as a whole when everything is received
+        LOG.write("Could not decompress map while receiving it: %1%\n") % e.what();
+        mapDecompressor_.reset();
+    }
     mainPlayer.sendMsgAsync(new GameMessage_MapRequest(false));
     AdvanceState(ConnectState::ReceiveMap);
     return true;
@@ -952,6 +971,18 @@ bool GameClient::OnGameMessage(const GameMessage_Map_Data& msg)
         return true;
     }
     std::copy(msg.data.begin(), msg.data.end(), targetData.begin() + msg.offset);
+    // Decompress the map and calculate its checksum while the rest is still being transferred
+    if(msg.isMapData && mapDecompressor_ && msg.offset == mapDecompressor_->getNumBytesAdded())
+    {
+        try
+        {
+            mapDecompressor_->add(msg.data.data(), msg.data.size());
+        } catch(const std::runtime_error& e)
+        {
+            LOG.write("Could not decompress map while receiving it: %1%\n") % e.what();
+            mapDecompressor_.reset();
+        }
+    }
 
     uint32_t totalSize = mapinfo.mapData.data.size();
     uint32_t receivedSize = msg.offset + msg.data.size();
@@ -967,10 +998,17 @@ bool GameClient::OnGameMessage(const GameMessage_Map_Data& msg)
 
     if(receivedSize == totalSize)
     {
-        if(!mapinfo.mapData.DecompressToFile(mapinfo.filepath, &mapinfo.mapChecksum))
+        if(mapDecompressor_ && mapDecompressor_->isFinished())
+            mapinfo.mapChecksum = mapDecompressor_->getChecksum();
+        else
         {
-            OnError(ClientError::MapTransmission);
-            return true;
+            // Close the partially written file first
+            mapDecompressor_.reset();
+            if(!mapinfo.mapData.DecompressToFile(mapinfo.filepath, &mapinfo.mapChecksum))
+            {
+                OnError(ClientError::MapTransmission);
+                return true;
+            }
         }
         if(!mapinfo.luaFilepath.empty() && !mapinfo.luaData.DecompressToFile(mapinfo.luaFilepath, &mapinfo.luaChecksum))
         {
@@ -978,6 +1016,7 @@ bool GameClient::OnGameMessage(const GameMessage_Map_Data& msg)
             return true;
         }
         RTTR_Assert(!mapinfo.luaFilepath.empty() || mapinfo.luaChecksum == 0);
+        mapDecompressor_.reset();
 
         if(!CreateLobby())
         {
@@ -1126,7 +1165,17 @@ bool GameClient::OnGameMessage(const GameMessage_GameCommand& msg)
 {
     if(nwfInfo)
     {
-        if(!nwfInfo->addPlayerCmds(msg.player, msg.cmds))
+        PlayerGameCommands cmds;
+        try
+        {
+            cmds = msg.decodeCmds();
+        } catch(const std::exception& e)
+        {
+            LOG.write("Received invalid gamecommands for player %1%: %2%\n") % unsigned(msg.player) % e.what();
+            OnError(ClientError::InvalidMessage);
+            return true;
+        }
+        if(!nwfInfo->addPlayerCmds(msg.player, cmds))
         {
             LOG.write("Could not add gamecommands for player %1%. He might be cheating!\n") % unsigned(msg.player);
             RTTR_Assert(false);
@@ -1269,11 +1318,18 @@ void GameClient::ExecuteGameFrame()
             return; // Pause
     }
 
-    const unsigned curGF = GetGFNumber();
-    const bool isSkipping = skiptogf > curGF;
-    // Is it time for the next GF? If we are skipping, it is always time for the next GF
-    if(isSkipping || (currentTime - framesinfo.lastTime) >= framesinfo.gf_length)
+    // Execute all GFs that are due, so the simulation does not depend on the frame rate.
+    // The time used per call is limited to keep the game responsive, remaining GFs are run in the next call
+    GFTimeBudget budget(maxGFTimePerCall);
+    while(state == ClientState::Game && !framesinfo.isPaused)
     {
+        const unsigned curGF = GetGFNumber();
+        const bool isSkipping = skiptogf > curGF;
+        // Is it time for the next GF? If we are skipping, it is always time for the next GF
+        if(!isSkipping && (currentTime - framesinfo.lastTime) < framesinfo.gf_length)
+            break;
+        if(!budget.startGF())
+            break;
         try
         {
             if(isSkipping)
@@ -1336,17 +1392,19 @@ void GameClient::ExecuteGameFrame()
         {
             SystemChat((boost::format(_("Error during execution of lua script: %1\nGame stopped!")) % e.what()).str());
             OnError(ClientError::InvalidMap);
+            return; // Game is stopped
         }
         if(skiptogf == GetGFNumber())
             skiptogf = 0;
     }
+    if(state != ClientState::Game)
+        return;
     framesinfo.frameTime = std::chrono::duration_cast<FramesInfo::milliseconds32_t>(currentTime - framesinfo.lastTime);
     // Check remaining time until next GF
     if(framesinfo.frameTime >= framesinfo.gf_length)
     {
-        // This can happen, if we don't call this method in intervalls less than gf_length or gf_length has changed
-        // TODO: Run multiple GFs per call.
-        // For now just make sure it is less than gf_length by skipping some simulation time,
+        // This can happen, if the GFs take longer than maxGFTimePerCall or gf_length has changed
+        // Make sure it is less than gf_length by skipping some simulation time,
         // until we are only a bit less than 1 GF behind
         // However we allow the simulation to lack behind for a few frames, so if there was a single spike we can still
         // catch up in the next visual frames
@@ -1615,25 +1673,22 @@ void GameClient::SkipGF(unsigned gf, GameWorldView& gwv)
     SetPause(false);
     skiptogf = gf;
 
-    // GFs überspringen
-    for(unsigned i = GetGFNumber(); i < skiptogf; ++i)
+    // GFs überspringen. Each call executes as many GFs as possible in its time budget, so draw the progress in between
+    while(state == ClientState::Game && !framesinfo.isPaused && skiptogf > GetGFNumber())
     {
-        if(i % 1000 == 0)
-        {
-            RoadBuildState road;
-            road.mode = RoadBuildMode::Disabled;
+        const unsigned curGF = GetGFNumber();
+        RoadBuildState road;
+        road.mode = RoadBuildMode::Disabled;
 
-            // spiel aktualisieren
-            gwv.Draw(road, MapPoint::Invalid(), false);
+        // spiel aktualisieren
+        gwv.Draw(road, MapPoint::Invalid(), false);
 
-            // text oben noch hinschreiben
-            boost::format nwfString(_("current GF: %u - still fast forwarding: %d GFs left (%d %%)"));
-            nwfString % GetGFNumber() % (gf - i) % (i * 100 / gf);
-            LargeFont->Draw(DrawPoint(VIDEODRIVER.GetRenderSize() / 2u), nwfString.str(), FontStyle::CENTER,
-                            COLOR_YELLOW);
+        // text oben noch hinschreiben
+        boost::format nwfString(_("current GF: %u - still fast forwarding: %d GFs left (%d %%)"));
+        nwfString % curGF % (gf - curGF) % (curGF * 100 / gf);
+        LargeFont->Draw(DrawPoint(VIDEODRIVER.GetRenderSize() / 2u), nwfString.str(), FontStyle::CENTER, COLOR_YELLOW);
 
-            VIDEODRIVER.SwapBuffers();
-        }
+        VIDEODRIVER.SwapBuffers();
         ExecuteGameFrame();
     }
 
@@ -1667,7 +1722,20 @@ bool GameClient::SaveToFile(const boost::filesystem::path& filepath)
     VIDEODRIVER.SwapBuffers();
 
     Savegame save;
+    try
+    {
+        MakeSavegame(save);
+        // Und alles speichern
+        return save.Save(filepath, mapinfo.title);
+    } catch(std::exception& e)
+    {
+        SystemChat(std::string("Error during saving: ") + e.what());
+        return false;
+    }
+}
 
+void GameClient::MakeSavegame(Savegame& save)
+{
     WritePlayerInfo(save);
 
     // GGS-Daten
@@ -1678,17 +1746,8 @@ bool GameClient::SaveToFile(const boost::filesystem::path& filepath)
     // Enable/Disable debugging of savegames
     save.sgd.debugMode = SETTINGS.global.debugMode;
 
-    try
-    {
-        // Spiel serialisieren
-        save.sgd.MakeSnapshot(*game);
-        // Und alles speichern
-        return save.Save(filepath, mapinfo.title);
-    } catch(std::exception& e)
-    {
-        SystemChat(std::string("Error during saving: ") + e.what());
-        return false;
-    }
+    // Spiel serialisieren
+    save.sgd.MakeSnapshot(*game);
 }
 
 void GameClient::ResetVisualSettings()
@@ -27,15 +27,18 @@ struct Info;
 }
 
 class AIPlayer;
+class AsyncLogWriter;
 class ClientInterface;
 class Game;
 class GameEvent;
 class GameLobby;
 class GamePlayer;
 class GameWorldView;
+class IncrementalDecompressor;
 class NWFInfo;
 class Replay;
 class SavedFile;
+class Savegame;
 enum class ConnectState;
 struct CreateServerInfo;
 struct PlayerGameCommands;
@@ -261,6 +264,8 @@ private:
     /// Schreibt den Header der Replaydatei
     void StartReplayRecording(unsigned random_init);
     void WritePlayerInfo(SavedFile& file);
+    /// Store the current state of the game in the savegame
+    void MakeSavegame(Savegame& save);
 
 public:
     /// Virtuelle Werte der Einstellungsfenster, die aber noch nicht wirksam sind, nur um die Verzögerungen zu
@@ -272,6 +277,8 @@ public:
 
 private:
     NetworkPlayer mainPlayer;
+    /// Writes the logs and savegame of an async in the background
+    std::unique_ptr<AsyncLogWriter> asyncLogWriter_;
 
     ClientState state;
     ConnectState connectState;
@@ -298,6 +305,8 @@ private:
     } clientconfig;
 
     MapInfo mapinfo;
+    /// Decompresses the map data while it is received from the server
+    std::unique_ptr<IncrementalDecompressor> mapDecompressor_;
 
     FramesInfoClient framesinfo;
 
@@ -5,29 +5,68 @@
 #include "GameMessage_GameCommand.h"
 #include "GameMessageInterface.h"
 #include "GameProtocol.h"
+#include "s25util/Serializer.h"
+#include <stdexcept>
 
 //////////////////////////////////////////////////////////////////////////
 
-GameMessage_GameCommand::GameMessage_GameCommand() : GameMessageWithPlayer(NMS_GAMECOMMANDS) {}
+GameMessage_GameCommand::GameMessage_GameCommand() : GameMessageWithPlayer(NMS_GAMECOMMANDS), numGCs_(0) {}
 
 GameMessage_GameCommand::GameMessage_GameCommand(uint8_t player, const AsyncChecksum& checksum,
                                                  const std::vector<gc::GameCommandPtr>& gcs)
-    : GameMessageWithPlayer(NMS_GAMECOMMANDS, player), cmds(checksum, gcs)
+    : GameMessageWithPlayer(NMS_GAMECOMMANDS, player), checksum(checksum), numGCs_(gcs.size())
+{
+    if(gcs.empty())
+        return;
+    Serializer ser;
+    for(const gc::GameCommandPtr& gc : gcs)
+        gc->Serialize(ser);
+    gcData_.assign(ser.GetData(), ser.GetData() + ser.GetLength());
+}
+
+GameMessage_GameCommand::GameMessage_GameCommand(uint8_t player, const GameMessage_GameCommand& forwardedMsg)
+    : GameMessageWithPlayer(NMS_GAMECOMMANDS, player), checksum(forwardedMsg.checksum),
+      numGCs_(forwardedMsg.numGCs_), gcData_(forwardedMsg.gcData_)
 {}
 
 void GameMessage_GameCommand::Serialize(Serializer& ser) const
 {
     GameMessageWithPlayer::Serialize(ser);
-    cmds.Serialize(ser);
+    checksum.Serialize(ser);
+    ser.PushUnsignedInt(numGCs_);
+    ser.PushUnsignedInt(gcData_.size());
+    if(!gcData_.empty())
+        ser.PushRawData(gcData_.data(), gcData_.size());
 }
 
 void GameMessage_GameCommand::Deserialize(Serializer& ser)
 {
     GameMessageWithPlayer::Deserialize(ser);
-    cmds.Deserialize(ser);
+    checksum.Deserialize(ser);
+    numGCs_ = ser.PopUnsignedInt();
+    const unsigned dataSize = ser.PopUnsignedInt();
+    // Each command takes at least 1 byte (its type)
+    if(dataSize > ser.GetBytesLeft() || numGCs_ > dataSize)
+        throw std::length_error("Invalid size of game command data");
+    gcData_.resize(dataSize);
+    if(dataSize)
+        ser.PopRawData(gcData_.data(), dataSize);
 }
 
 bool GameMessage_GameCommand::Run(GameMessageInterface* callback) const
 {
     return callback->OnGameMessage(*this);
 }
+
+std::vector<gc::GameCommandPtr> GameMessage_GameCommand::decodeGCs() const
+{
+    std::vector<gc::GameCommandPtr> gcs(numGCs_);
+    if(gcs.empty())
+        return gcs;
+    Serializer ser(gcData_.data(), gcData_.size());
+    for(gc::GameCommandPtr& gc : gcs)
+        gc = gc::GameCommand::Deserialize(ser);
+    if(ser.GetBytesLeft() != 0u)
+        throw std::length_error("Game command data contains more than the announced commands");
+    return gcs;
+}
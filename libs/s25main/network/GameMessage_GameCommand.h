@@ -7,19 +7,37 @@
 #include "GameCommand.h"
 #include "GameMessage.h"
 #include "PlayerGameCommands.h"
+#include <cstdint>
 #include <vector>
 
 class Serializer;
 
+/// Game commands of a player for one NWF.
+/// The commands are stored serialized and only decoded when required (by the clients), so the server can forward them
+/// without decoding and encoding them again.
 class GameMessage_GameCommand : public GameMessageWithPlayer
 {
 public:
-    PlayerGameCommands cmds;
+    /// Checksum of the player for this NWF
+    AsyncChecksum checksum;
 
     GameMessage_GameCommand(); //-V730
     GameMessage_GameCommand(uint8_t player, const AsyncChecksum& checksum, const std::vector<gc::GameCommandPtr>& gcs);
+    /// Forward the (still serialized) commands of the given message as the commands of the given player
+    GameMessage_GameCommand(uint8_t player, const GameMessage_GameCommand& forwardedMsg);
 
     void Serialize(Serializer& ser) const override;
     void Deserialize(Serializer& ser) override;
     bool Run(GameMessageInterface* callback) const override;
+
+    unsigned getNumGCs() const { return numGCs_; }
+    /// Decode the game commands. Throws if the data isn't exactly the given number of valid commands
+    std::vector<gc::GameCommandPtr> decodeGCs() const;
+    /// Return checksum and decoded game commands
+    PlayerGameCommands decodeCmds() const { return PlayerGameCommands(checksum, decodeGCs()); }
+
+private:
+    unsigned numGCs_;
+    /// Serialized game commands
+    std::vector<uint8_t> gcData_;
 };
@@ -156,6 +156,21 @@ constexpr unsigned PING_RATE = 1;
 constexpr unsigned PING_TIMEOUT = 5 * 60;
 /// Maximum time the players get for loading the map
 constexpr unsigned LOAD_TIMEOUT = 10 * 60;
+/// Maximum number of received but not yet executed messages of a player at the server.
+/// Further messages stay in the socket till the queued ones are executed
+constexpr unsigned MAX_QUEUED_MSGS = 512;
+/// Maximum average number of messages a player may send to the server per second before being kicked.
+/// Bursts of up to this many messages at once are allowed
+constexpr unsigned MAX_MSGS_PER_SECOND = 2000;
+
+/// Limits for the messages received from a player, so memory usage and latency of the server stay bounded
+struct PlayerMsgLimits
+{
+    /// Maximum number of received but not yet executed messages
+    unsigned maxQueuedMsgs = MAX_QUEUED_MSGS;
+    /// Maximum number of messages per second
+    unsigned maxMsgsPerSecond = MAX_MSGS_PER_SECOND;
+};
 
 /// Größe eines Map-Paketes
 /// ACHTUNG: IPV4 garantiert nur maximal 576!!
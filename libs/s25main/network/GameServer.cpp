@@ -20,7 +20,6 @@
 #include "helpers/random.h"
 #include "network/CreateServerInfo.h"
 #include "network/GameMessages.h"
-#include "random/randomIO.h"
 #include "gameTypes/LanGameInfo.h"
 #include "gameTypes/TeamTypes.h"
 #include "gameData/GameConsts.h"
@@ -38,8 +37,8 @@
 #include <boost/nowide/convert.hpp>
 #include <boost/nowide/fstream.hpp>
 #include <helpers/chronoIO.h>
-#include <iomanip>
 #include <iterator>
+#include <memory>
 #include <mygettext/mygettext.h>
 
 struct GameServer::AsyncLog
@@ -64,6 +63,7 @@ void GameServer::ServerConfig::Clear()
     password.clear();
     port = 0;
     ipv6 = false;
+    msgLimits = PlayerMsgLimits();
 }
 
 GameServer::CountDown::CountDown() : isActive(false), remainingSecs(0) {}
@@ -124,6 +124,7 @@ bool GameServer::Start(const CreateServerInfo& csi, const boost::filesystem::pat
     config.servertype = csi.type;
     config.port = csi.port;
     config.ipv6 = csi.ipv6;
+    config.msgLimits = csi.msgLimits;
     mapinfo.type = map_type;
     mapinfo.filepath = map_path;
 
@@ -300,17 +301,11 @@ void GameServer::Run()
             continue;
         player.executeMsgs(*this);
     }
-    // Send afterwards as most messages are relayed which should be done as fast as possible
-    for(GameServerPlayer& player : networkPlayers)
-    {
-        // Ignore kicked players
-        if(!player.socket.isValid())
-            continue;
-        player.sendMsgs(10);
-    }
+    // Messages are sent by the I/O threads of the players as soon as they are queued
     helpers::erase_if(networkPlayers, [](const auto& player) { return !player.socket.isValid(); });
 
     lanAnnouncer.Run();
+    asyncLogWriter.poll();
 }
 
 void GameServer::RunStateConfig()
@@ -355,10 +350,9 @@ void GameServer::RunStateLoading()
     {
         for(const NWFPlayerInfo& player : nwfInfo.getPlayerInfos())
         {
-            GameMessage_GameCommand msg(player.id, nwfInfo.getPlayerCmds(player.id).checksum,
-                                        std::vector<gc::GameCommandPtr>());
-            SendToAll(msg);
-            nwfInfo.addPlayerCmds(player.id, msg.cmds);
+            const AsyncChecksum checksum = nwfInfo.getPlayerCmds(player.id).checksum;
+            SendToAll(GameMessage_GameCommand(player.id, checksum, std::vector<gc::GameCommandPtr>()));
+            nwfInfo.addPlayerCmds(player.id, PlayerGameCommands(checksum, {}));
         }
     }
 
@@ -411,6 +405,7 @@ void GameServer::Stop()
 
     // clear async logs
     asyncLogs.clear();
+    asyncLogWriter.waitForAll();
 
     lanAnnouncer.Stop();
 
@@ -647,26 +642,7 @@ void GameServer::KickPlayer(uint8_t playerId, KickReason cause, uint32_t param)
 // testet, ob in der Verbindungswarteschlange Clients auf Verbindung warten
 void GameServer::ClientWatchDog()
 {
-    SocketSet set;
-    set.Clear();
-
-    // sockets zum set hinzufügen
-    for(GameServerPlayer& player : networkPlayers)
-        set.Add(player.socket);
-
-    // auf fehler prüfen
-    if(set.Select(0, 2) > 0)
-    {
-        for(const GameServerPlayer& player : networkPlayers)
-        {
-            if(set.InSet(player.socket))
-            {
-                LOG.write(_("SERVER: Error on socket of player %1%, bye bye!\n")) % player.playerId;
-                KickPlayer(player.playerId, KickReason::ConnectionLost, __LINE__);
-            }
-        }
-    }
-
+    // Socket errors are detected by the I/O threads of the players and handled in FillPlayerQueues
     for(GameServerPlayer& player : networkPlayers)
     {
         if(player.hasTimedOut())
@@ -837,7 +813,7 @@ void GameServer::WaitForClients()
         {
             if(playerInfos[playerId].ps == PlayerState::Free && !GetNetworkPlayer(playerId))
             {
-                networkPlayers.push_back(GameServerPlayer(playerId, socket));
+                networkPlayers.push_back(GameServerPlayer(playerId, socket, config.msgLimits));
                 newPlayerId = playerId;
                 break;
             }
@@ -849,6 +825,12 @@ void GameServer::WaitForClients()
         // war kein platz mehr frei, wenn ja dann verbindung trennen?
         if(newPlayerId == 0xFFFFFFFF)
             socket.Close();
+        else
+        {
+            // Send and receive in a separate thread so the latency does not depend on the frame rate.
+            // Only now as the socket must not be used by us anymore
+            GetNetworkPlayer(newPlayerId)->startIOThread();
+        }
     }
 }
 
@@ -856,36 +838,24 @@ void GameServer::WaitForClients()
 // füllt die warteschlangen mit "paketen"
 void GameServer::FillPlayerQueues()
 {
-    SocketSet set;
-    bool msgReceived = false;
-
-    // erstmal auf Daten überprüfen
-    do
+    // The messages are received by the I/O threads of the players. Their number is bounded, so a flooding player
+    // can't stall the server
+    for(GameServerPlayer& player : networkPlayers)
     {
-        // sockets zum set hinzufügen
-        for(const GameServerPlayer& player : networkPlayers)
-            set.Add(player.socket);
-
-        msgReceived = false;
-
-        // ist eines der Sockets im Set lesbar?
-        if(set.Select(0, 0) > 0)
+        // Ignore kicked players
+        if(!player.socket.isValid())
+            continue;
+        // nachricht empfangen
+        if(!player.countReceivedMsgs())
         {
-            for(GameServerPlayer& player : networkPlayers)
-            {
-                if(set.InSet(player.socket))
-                {
-                    // nachricht empfangen
-                    if(!player.receiveMsgs())
-                    {
-                        LOG.write(_("SERVER: Receiving Message for player %1% failed, kicking...\n")) % player.playerId;
-                        KickPlayer(player.playerId, KickReason::ConnectionLost, __LINE__);
-                    } else
-                        msgReceived = true;
-                }
-            }
+            LOG.write(_("SERVER: Receiving Message for player %1% failed, kicking...\n")) % player.playerId;
+            KickPlayer(player.playerId, KickReason::ConnectionLost, __LINE__);
+        } else if(player.exceedsMsgRate())
+        {
+            LOG.write(_("SERVER: Player %1% sent too many messages, kicking...\n")) % player.playerId;
+            KickPlayer(player.playerId, KickReason::InvalidMsg, __LINE__);
         }
-    } while(msgReceived);
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1266,18 +1236,20 @@ bool GameServer::OnGameMessage(const GameMessage_GameCommand& msg)
 {
     int targetPlayerId = GetTargetPlayer(msg);
     if((state != ServerState::Game && state != ServerState::Loading) || targetPlayerId < 0
-       || (state == ServerState::Loading && !msg.cmds.gcs.empty()))
+       || (state == ServerState::Loading && msg.getNumGCs() != 0u))
     {
         KickPlayer(msg.senderPlayerID, KickReason::InvalidMsg, __LINE__);
         return true;
     }
 
-    if(!nwfInfo.addPlayerCmds(targetPlayerId, msg.cmds))
+    // The server only needs the checksums, so the commands are forwarded without decoding them.
+    // Clients reject commands they can't decode
+    if(!nwfInfo.addPlayerCmds(targetPlayerId, PlayerGameCommands(msg.checksum, {})))
         return true; // Ignore
     GameServerPlayer* player = GetNetworkPlayer(targetPlayerId);
     if(player)
         player->setNotLagging();
-    SendToAll(GameMessage_GameCommand(targetPlayerId, msg.cmds.checksum, msg.cmds.gcs));
+    SendToAll(GameMessage_GameCommand(targetPlayerId, msg));
 
     return true;
 }
@@ -1322,9 +1294,7 @@ bool GameServer::OnGameMessage(const GameMessage_AsyncLog& msg)
 
     LOG.write(_("Async logs received completely.\n"));
 
-    const bfs::path asyncFilePath = SaveAsyncLog();
-    if(!asyncFilePath.empty())
-        SendAsyncLog(asyncFilePath);
+    SaveAsyncLog();
 
     // Kick all players that have a different checksum from the host
     AsyncChecksum hostChecksum;
@@ -1478,7 +1448,7 @@ void GameServer::PlayerDataChanged(unsigned playerIdx)
     }
 }
 
-bfs::path GameServer::SaveAsyncLog()
+void GameServer::SaveAsyncLog()
 {
     // Get the highest common counter number and start from there (remove all others)
     unsigned maxCtr = 0;
@@ -1499,7 +1469,7 @@ bfs::path GameServer::SaveAsyncLog()
     }
     // No entries :(
     if(numEntries == 0 || asyncLogs.size() < 2u)
-        return "";
+        return;
 
     // count identical lines
     unsigned numIdentical = 0;
@@ -1532,48 +1502,37 @@ bfs::path GameServer::SaveAsyncLog()
 
     LOG.write(_("There are %1% identical async log entries.\n")) % numIdentical;
 
-    bfs::path filePath =
-      RTTRCONFIG.ExpandPath(s25::folders::logs) / (s25util::Time::FormatTime("async_%Y-%m-%d_%H-%i-%s") + "Server.log");
-
-    // open async log
-    bnw::ofstream file(filePath);
-
-    if(file)
-    {
-        file << "Map: " << mapinfo.title << std::endl;
-        file << std::setfill(' ');
-        for(const AsyncLog& log : asyncLogs)
-        {
-            const JoinPlayerInfo& plInfo = playerInfos.at(log.playerId);
-            file << "Player " << std::setw(2) << unsigned(log.playerId) << (plInfo.isHost ? '#' : ' ') << "\t\""
-                 << plInfo.name << '"' << std::endl;
-            file << "System info: " << log.addData << std::endl;
-            file << "\tChecksum: " << std::setw(0) << log.checksum << std::endl;
-        }
-        for(const AsyncLog& log : asyncLogs)
-            file << "Checksum " << std::setw(2) << unsigned(log.playerId) << std::setw(0) << ": " << log.checksum
-                 << std::endl;
-
-        // print identical lines, they help in tracing the bug
-        for(unsigned i = 0; i < numIdentical; i++)
-            file << "[ I ]: " << asyncLogs[0].randEntries[i] << "\n";
-        for(unsigned i = numIdentical; i < numEntries; i++)
-        {
-            for(const AsyncLog& log : asyncLogs)
-            {
-                if(i < log.randEntries.size())
-                    file << "[C" << std::setw(2) << unsigned(log.playerId) << std::setw(0)
-                         << "]: " << log.randEntries[i] << '\n';
-            }
-        }
-
-        LOG.write(_("Async log saved at %1%\n")) % filePath;
-        return filePath;
-    } else
+    // Formatting and writing takes long for many players, so only collect the data here
+    // The entries are not needed anymore, only the checksums for kicking the players
+    std::vector<PlayerAsyncLog> logs;
+    logs.reserve(asyncLogs.size());
+    for(AsyncLog& log : asyncLogs)
     {
-        LOG.write(_("Failed to save async log at %1%\n")) % filePath;
-        return "";
+        const JoinPlayerInfo& plInfo = playerInfos.at(log.playerId);
+        logs.push_back(PlayerAsyncLog{log.playerId, plInfo.isHost, plInfo.name, std::move(log.addData), log.checksum,
+                                      std::move(log.randEntries)});
     }
+
+    const bfs::path filePath =
+      RTTRCONFIG.ExpandPath(s25::folders::logs) / (s25util::Time::FormatTime("async_%Y-%m-%d_%H-%i-%s") + "Server.log");
+    // std::function requires copyable functors
+    auto sharedLogs = std::make_shared<const std::vector<PlayerAsyncLog>>(std::move(logs));
+    asyncLogWriter.addJob(
+      [filePath, mapTitle = mapinfo.title, sharedLogs, numIdentical]() {
+          bnw::ofstream file(filePath);
+          if(!file)
+              return false;
+          writeAsyncLog(file, mapTitle, *sharedLogs, numIdentical);
+          return static_cast<bool>(file);
+      },
+      [this, filePath](bool success) {
+          if(success)
+          {
+              LOG.write(_("Async log saved at %1%\n")) % filePath;
+              SendAsyncLog(filePath);
+          } else
+              LOG.write(_("Failed to save async log at %1%\n")) % filePath;
+      });
 }
 
 void GameServer::SendAsyncLog(const bfs::path& asyncLogFilePath)
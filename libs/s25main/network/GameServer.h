@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "AsyncLogWriter.h"
 #include "FramesInfo.h"
 #include "GameMessageInterface.h"
 #include "GameProtocol.h"
@@ -120,7 +121,8 @@ private:
     void ExecuteNWF();
 
     bool CheckForAsync();
-    boost::filesystem::path SaveAsyncLog();
+    /// Write the async log in the background and send it afterwards
+    void SaveAsyncLog();
     void SendAsyncLog(const boost::filesystem::path& asyncLogFilePath);
 
     void CheckAndKickLaggingPlayers();
@@ -155,6 +157,7 @@ private:
         std::string hostPassword, password;
         unsigned short port;
         bool ipv6;
+        PlayerMsgLimits msgLimits;
     } config;
 
     MapInfo mapinfo;
@@ -186,6 +189,7 @@ private:
     struct AsyncLog;
     /// AsyncLogs of all players
     std::vector<AsyncLog> asyncLogs;
+    AsyncLogWriter asyncLogWriter;
     /// Time at which the loading started
     std::chrono::steady_clock::time_point loadStartTime;
 
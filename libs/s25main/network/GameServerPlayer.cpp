@@ -4,6 +4,7 @@
 
 #include "GameServerPlayer.h"
 #include "GameMessages.h"
+#include "NetworkIOThread.h"
 #include "helpers/mathFuncs.h"
 #include <algorithm>
 #include <limits>
@@ -18,15 +19,35 @@ int durationToInt(const T_Duration& duration)
 }
 } // namespace
 
-GameServerPlayer::GameServerPlayer(unsigned id, const Socket& socket) //-V818
-    : NetworkPlayer(id), state_(JustConnectedState())
+GameServerPlayer::GameServerPlayer(unsigned id, const Socket& socket, const PlayerMsgLimits& msgLimits) //-V818
+    : NetworkPlayer(id), state_(JustConnectedState()), msgLimits_(msgLimits), msgRateCredit_(seconds(1)),
+      lastMsgCountTime_(Clock::now()), numCountedMsgs_(0)
 {
     boost::get<JustConnectedState>(state_).timer.start();
     this->socket = socket;
 }
 
+GameServerPlayer::GameServerPlayer(GameServerPlayer&&) = default;
+GameServerPlayer& GameServerPlayer::operator=(GameServerPlayer&&) = default;
 GameServerPlayer::~GameServerPlayer() = default;
 
+bool GameServerPlayer::countReceivedMsgs()
+{
+    // The I/O thread stops receiving when the queue is full, so a flooding player can't make us read (and allocate)
+    // unbounded data. Messages exceeding the queue size stay in the socket, so the player gets slowed down by TCP
+    if(!ioThread || ioThread->hasError())
+        return false;
+    const unsigned numReceivedMsgs = ioThread->getNumReceivedMsgs();
+    const unsigned numNewMsgs = numReceivedMsgs - numCountedMsgs_;
+    numCountedMsgs_ = numReceivedMsgs;
+    const auto now = Clock::now();
+    msgRateCredit_ = std::min<Clock::duration>(msgRateCredit_ + (now - lastMsgCountTime_), seconds(1));
+    lastMsgCountTime_ = now;
+    const Clock::duration timePerMsg = Clock::duration(seconds(1)) / std::max(1u, msgLimits_.maxMsgsPerSecond);
+    msgRateCredit_ -= numNewMsgs * timePerMsg;
+    return true;
+}
+
 void GameServerPlayer::setMapSending(std::chrono::seconds estimatedSendTime)
 {
     MapSendingState state;
@@ -48,7 +69,7 @@ void GameServerPlayer::doPing()
     {
         state->isPinging = true;
         state->pingTimer.restart();
-        sendQueue.push(new GameMessage_Ping(0xFF));
+        sendMsgAsync(new GameMessage_Ping(0xFF));
     }
 }
 
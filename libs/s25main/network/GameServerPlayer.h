@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "GameProtocol.h"
 #include "NetworkPlayer.h"
 #include "Timer.h"
 #include "helpers/SmoothedValue.hpp"
@@ -36,9 +37,18 @@ class GameServerPlayer : public NetworkPlayer
     };
 
 public:
-    GameServerPlayer(unsigned id, const Socket& socket);
+    GameServerPlayer(unsigned id, const Socket& socket, const PlayerMsgLimits& msgLimits = PlayerMsgLimits());
+    GameServerPlayer(GameServerPlayer&&);
+    GameServerPlayer& operator=(GameServerPlayer&&);
     ~GameServerPlayer();
 
+    /// Start the I/O thread which receives till the receive queue is full
+    void startIOThread() { NetworkPlayer::startIOThread(msgLimits_.maxQueuedMsgs); }
+    /// Account the messages received since the last call for the message rate. Return false on connection error
+    bool countReceivedMsgs();
+    /// True if the player sent more messages than allowed by the rate, allowing bursts of up to one second
+    bool exceedsMsgRate() const { return msgRateCredit_ < Clock::duration::zero(); }
+
     void setMapSending(std::chrono::seconds estimatedSendTime);
     void setActive();
     bool isMapSending() const { return holds_alternative<MapSendingState>(state_); }
@@ -62,4 +72,11 @@ public:
 
 private:
     boost::variant<JustConnectedState, MapSendingState, ActiveState> state_;
+    PlayerMsgLimits msgLimits_;
+    /// Token bucket for the message rate measured in time: Grows with the elapsed time up to one second and each
+    /// message takes the time it may take at the allowed rate
+    Clock::duration msgRateCredit_;
+    Clock::time_point lastMsgCountTime_;
+    /// Number of received messages already accounted
+    unsigned numCountedMsgs_;
 };
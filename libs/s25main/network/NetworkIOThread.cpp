@@ -0,0 +1,267 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "NetworkIOThread.h"
+#include "GameMessage.h"
+#include "NetworkPlayer.h"
+#include "s25util/ProxySettings.h"
+#include "s25util/SocketSet.h"
+#include <algorithm>
+#include <chrono>
+#ifdef _WIN32
+#    include <winsock2.h>
+#    include <ws2tcpip.h>
+#else
+#    include <arpa/inet.h>
+#    include <netinet/in.h>
+#    include <sys/socket.h>
+#endif
+
+constexpr int NetworkIOThread::POLL_TIME_MS;
+constexpr unsigned NetworkIOThread::UNLIMITED_MSGS;
+constexpr size_t NetworkIOThread::QUEUE_SIZE;
+
+namespace {
+/// Maximum time the thread waits when it can be woken up. Only a safety net
+constexpr int IDLE_TIME_MS = 1000;
+/// Maximum time to wait for the peer to take the messages still queued when stopping
+constexpr std::chrono::milliseconds FLUSH_TIME(200);
+
+/// Connect the 2 sockets to each other over the loopback interface.
+/// Only local connections can be accepted and the accepted one must come from the first socket
+bool connectSocketPair(Socket& first, Socket& second)
+{
+    Socket listener;
+    if(!listener.Create(AF_INET))
+        return false;
+    sockaddr_in listenAddr{};
+    listenAddr.sin_family = AF_INET;
+    listenAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    listenAddr.sin_port = 0; // Any free port
+    socklen_t addrLen = sizeof(listenAddr);
+    if(bind(listener.GetSocket(), reinterpret_cast<sockaddr*>(&listenAddr), addrLen) != 0
+       || listen(listener.GetSocket(), 1) != 0
+       || getsockname(listener.GetSocket(), reinterpret_cast<sockaddr*>(&listenAddr), &addrLen) != 0)
+        return false;
+    if(!first.Connect("127.0.0.1", ntohs(listenAddr.sin_port), false, ProxySettings()))
+        return false;
+    sockaddr_in firstAddr{};
+    addrLen = sizeof(firstAddr);
+    if(getsockname(first.GetSocket(), reinterpret_cast<sockaddr*>(&firstAddr), &addrLen) != 0)
+        return false;
+    // Another local process might have connected before. The connection of the first socket is pending then
+    for(unsigned i = 0; i < 10; i++)
+    {
+        sockaddr_in peerAddr{};
+        addrLen = sizeof(peerAddr);
+        const SOCKET so = accept(listener.GetSocket(), reinterpret_cast<sockaddr*>(&peerAddr), &addrLen);
+        if(so == INVALID_SOCKET)
+            return false;
+        second = Socket(so, Socket::Status::Connected);
+        if(peerAddr.sin_addr.s_addr == firstAddr.sin_addr.s_addr && peerAddr.sin_port == firstAddr.sin_port)
+            return true;
+        second.Close();
+    }
+    return false;
+}
+} // namespace
+
+NetworkIOThread::NetworkIOThread(NetworkPlayer& player, unsigned maxQueuedMsgs)
+    : socket_(player.socket), maxQueuedMsgs_(maxQueuedMsgs), recvQueue_(GameMessage::create_game),
+      sendQueue_(GameMessage::create_game), numQueuedMsgs_(0), numReceivedMsgs_(0), waitingForOwner_(false),
+      wakeupPending_(false), stop_(false), error_(false)
+{
+    if(!connectSocketPair(wakeupSender_, wakeupReceiver_))
+    {
+        wakeupSender_.Close();
+        wakeupReceiver_.Close();
+    }
+    // Messages queued before start
+    while(!player.sendQueue.empty())
+        sendQueue_.push(player.sendQueue.pop().release());
+    while(!player.recvQueue.empty())
+        recvQueue_.push(player.recvQueue.pop().release());
+    thread_ = std::thread([this]() { run(); });
+}
+
+NetworkIOThread::~NetworkIOThread()
+{
+    stop();
+}
+
+void NetworkIOThread::stop()
+{
+    if(!thread_.joinable())
+        return;
+    stop_ = true;
+    wakeup();
+    thread_.join();
+    // The thread is done, so its queues can be used here.
+    // Send the remaining messages (e.g. the reason for a kick) but don't wait long for a peer not reading them
+    Message* msg;
+    while(msgsToSend_.pop(msg))
+        sendQueue_.push(msg);
+    for(Message* pendingMsg : pendingMsgs_)
+        sendQueue_.push(pendingMsg);
+    pendingMsgs_.clear();
+    if(!error_)
+        sendQueuedMsgs(std::chrono::steady_clock::now() + FLUSH_TIME);
+    receivedMsgs_.consume_all([](Message* receivedMsg) { delete receivedMsg; });
+    recvQueue_.clear();
+    sendQueue_.clear();
+    wakeupSender_.Close();
+    wakeupReceiver_.Close();
+}
+
+void NetworkIOThread::sendMsgAsync(Message* msg)
+{
+    if(!thread_.joinable())
+    {
+        delete msg;
+        return;
+    }
+    // Keep the order
+    flushPendingMsgs();
+    if(!pendingMsgs_.empty() || !msgsToSend_.push(msg))
+        pendingMsgs_.push_back(msg);
+    wakeup();
+}
+
+std::unique_ptr<Message> NetworkIOThread::popReceivedMsg()
+{
+    flushPendingMsgs();
+    Message* msg;
+    if(!receivedMsgs_.pop(msg))
+        return nullptr;
+    --numQueuedMsgs_;
+    if(waitingForOwner_.exchange(false))
+        wakeup();
+    return std::unique_ptr<Message>(msg);
+}
+
+void NetworkIOThread::flushPendingMsgs()
+{
+    if(pendingMsgs_.empty())
+        return;
+    while(!pendingMsgs_.empty() && msgsToSend_.push(pendingMsgs_.front()))
+        pendingMsgs_.pop_front();
+    wakeup();
+}
+
+void NetworkIOThread::wakeup()
+{
+    // Only 1 byte till the thread read it, so the sender never blocks
+    if(wakeupSender_.isValid() && !wakeupPending_.exchange(true))
+    {
+        const char data = 0;
+        wakeupSender_.Send(&data, 1);
+    }
+}
+
+void NetworkIOThread::run()
+{
+    bool canWakeup = wakeupReceiver_.isValid();
+    SocketSet set;
+    while(!stop_)
+    {
+        Message* msg;
+        while(msgsToSend_.pop(msg))
+            sendQueue_.push(msg);
+        // Never block in sending, so the thread can always be stopped
+        if(!sendQueuedMsgs(std::chrono::steady_clock::now()))
+            break;
+
+        // If the owner can't keep up the messages stay in the recvQueue
+        while(!recvQueue_.empty() && receivedMsgs_.write_available() > 0u)
+        {
+            // Count first so the owner never pops an uncounted message
+            ++numQueuedMsgs_;
+            receivedMsgs_.push(recvQueue_.pop().release());
+        }
+        // Get woken up when the owner pops messages. Set before checking so a pop meanwhile is not missed
+        waitingForOwner_ = true;
+        if(!recvQueue_.empty() && receivedMsgs_.write_available() > 0u)
+            continue;
+        const bool readSocket = canReceive();
+        if(readSocket && recvQueue_.empty())
+            waitingForOwner_ = false;
+
+        set.Clear();
+        if(canWakeup)
+            set.Add(wakeupReceiver_);
+        if(readSocket)
+            set.Add(socket_);
+        // Check again soon for messages which could not be sent yet
+        const int numReady = set.Select((canWakeup && sendQueue_.empty()) ? IDLE_TIME_MS : POLL_TIME_MS, 0);
+        if(numReady < 0)
+            break;
+        if(numReady == 0 || stop_)
+            continue;
+        if(canWakeup && set.InSet(wakeupReceiver_))
+        {
+            // Reset before reading, so no wakeup gets lost
+            wakeupPending_ = false;
+            char buffer[64];
+            if(wakeupReceiver_.Recv(buffer, sizeof(buffer)) <= 0)
+                canWakeup = false;
+        }
+        if(readSocket && set.InSet(socket_))
+        {
+            const auto numMsgs = recvQueue_.size();
+            int result;
+            if(maxQueuedMsgs_ == UNLIMITED_MSGS)
+                result = recvQueue_.recvAll(socket_);
+            else
+            {
+                // When limited receive message by message till the queue is full so the remaining data stays in the
+                // socket. All waiting messages are read at once instead of waiting on the socket for each
+                size_t prevNumMsgs;
+                do
+                {
+                    prevNumMsgs = recvQueue_.size();
+                    result = recvQueue_.recv(socket_);
+                } while(result >= 0 && recvQueue_.size() > prevNumMsgs && canReceive());
+            }
+            numReceivedMsgs_ += static_cast<unsigned>(recvQueue_.size() - numMsgs);
+            if(result < 0)
+                break;
+            set.Clear();
+            set.Add(socket_);
+            if(set.Select(0, 2) > 0)
+                break;
+        }
+    }
+    // Not stopped by the owner -> Connection failed
+    if(!stop_)
+    {
+        // The owner can still handle what was received before, e.g. the reason for being kicked
+        while(!recvQueue_.empty() && receivedMsgs_.write_available() > 0u)
+        {
+            ++numQueuedMsgs_;
+            receivedMsgs_.push(recvQueue_.pop().release());
+        }
+        error_ = true;
+    }
+}
+
+bool NetworkIOThread::sendQueuedMsgs(std::chrono::steady_clock::time_point deadline)
+{
+    SocketSet set;
+    while(!sendQueue_.empty())
+    {
+        const auto remainingTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now());
+        set.Clear();
+        set.Add(socket_);
+        const int numReady = set.Select(std::max(0, static_cast<int>(remainingTime.count())), 1);
+        if(numReady < 0)
+            return false;
+        if(numReady == 0)
+            break;
+        // The socket can take more data and messages are small, so sending one doesn't block
+        if(!sendQueue_.send(socket_, 1))
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,83 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "s25util/MessageQueue.h"
+#include "s25util/Socket.h"
+#include <boost/lockfree/spsc_queue.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <thread>
+
+class Message;
+class NetworkPlayer;
+
+/// Does the socket I/O of a NetworkPlayer in a separate thread which blocks on the socket.
+/// So messages are received and sent independent of how often the owner runs (e.g. once per drawn frame).
+/// Messages are only (de)serialized by the I/O thread and handed over via lock-free queues. They are still executed
+/// in the owning thread.
+/// The thread waits on the socket and a loopback socket pair used to wake it up for sending and stopping.
+/// Only owned by a NetworkPlayer (see NetworkPlayer::startIOThread) which forwards its I/O functions to this.
+class NetworkIOThread
+{
+public:
+    /// Time the thread waits for data before checking for messages to send if no wakeup sockets could be created
+    static constexpr int POLL_TIME_MS = 2;
+    static constexpr unsigned UNLIMITED_MSGS = std::numeric_limits<unsigned>::max();
+
+    /// Start the thread for the socket of the player and take over its queued messages.
+    /// If more than maxQueuedMsgs were received but not yet popped, no more data is read from the socket
+    explicit NetworkIOThread(NetworkPlayer& player, unsigned maxQueuedMsgs = UNLIMITED_MSGS);
+    ~NetworkIOThread();
+
+    /// Stop the thread. Messages still queued for sending are sent if the peer takes them within a short time,
+    /// received messages not yet popped are dropped
+    void stop();
+    bool isRunning() const { return thread_.joinable(); }
+    /// True if the connection failed. The thread is finished then
+    bool hasError() const { return error_; }
+    /// Number of messages received so far
+    unsigned getNumReceivedMsgs() const { return numReceivedMsgs_; }
+
+    /// Enqueue a message to be sent. Takes ownership
+    void sendMsgAsync(Message* msg);
+    /// Return the next received message or nullptr if there is none
+    std::unique_ptr<Message> popReceivedMsg();
+
+private:
+    static constexpr size_t QUEUE_SIZE = 4096;
+
+    Socket socket_;
+    /// Sockets connected to each other. Sending on the first wakes up the thread waiting on the second
+    Socket wakeupSender_, wakeupReceiver_;
+    const unsigned maxQueuedMsgs_;
+    /// Only used by the I/O thread
+    MessageQueue recvQueue_, sendQueue_;
+    /// Messages from the I/O thread to the owner and back
+    boost::lockfree::spsc_queue<Message*, boost::lockfree::capacity<QUEUE_SIZE>> receivedMsgs_, msgsToSend_;
+    /// Messages to send which did not fit into msgsToSend_. Only used by the owner
+    std::deque<Message*> pendingMsgs_;
+    /// Number of messages in receivedMsgs_
+    std::atomic<unsigned> numQueuedMsgs_;
+    std::atomic<unsigned> numReceivedMsgs_;
+    /// Set while the thread can't hand over or receive more messages till the owner pops some
+    std::atomic<bool> waitingForOwner_;
+    /// Set when the wakeup data was sent but not yet read by the thread
+    std::atomic<bool> wakeupPending_;
+    std::atomic<bool> stop_, error_;
+    std::thread thread_;
+
+    void run();
+    /// Return true if more messages may be received
+    bool canReceive() { return recvQueue_.size() + numQueuedMsgs_ < maxQueuedMsgs_; }
+    void flushPendingMsgs();
+    /// Send queued messages while the socket can take more data, waiting for that at most till the deadline.
+    /// Return false on error
+    bool sendQueuedMsgs(std::chrono::steady_clock::time_point deadline);
+    void wakeup();
+};
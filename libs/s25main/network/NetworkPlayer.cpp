@@ -4,43 +4,81 @@
 
 #include "NetworkPlayer.h"
 #include "GameMessage.h"
+#include "NetworkIOThread.h"
+#include "RTTR_Assert.h"
 
 NetworkPlayer::NetworkPlayer(unsigned playerId)
     : playerId(playerId), recvQueue(GameMessage::create_game), sendQueue(GameMessage::create_game)
 {}
 
+NetworkPlayer::NetworkPlayer(NetworkPlayer&&) = default;
+NetworkPlayer& NetworkPlayer::operator=(NetworkPlayer&&) = default;
+NetworkPlayer::~NetworkPlayer() = default;
+
 void NetworkPlayer::closeConnection()
 {
     // Close socket and clear queues
+    ioThread.reset();
     socket.Close();
     sendQueue.clear();
     recvQueue.clear();
 }
 
+void NetworkPlayer::startIOThread(unsigned maxQueuedMsgs)
+{
+    RTTR_Assert(!ioThread && socket.isValid());
+    ioThread = std::make_unique<NetworkIOThread>(*this, maxQueuedMsgs);
+}
+
 bool NetworkPlayer::receiveMsgs()
 {
+    if(ioThread)
+        return !ioThread->hasError();
     return recvQueue.recvAll(socket) >= 0;
 }
 
 bool NetworkPlayer::sendMsgs(int maxNumMsgs)
 {
+    if(ioThread)
+        return !ioThread->hasError();
     return sendQueue.send(socket, maxNumMsgs);
 }
 
 void NetworkPlayer::sendMsgAsync(Message* msg)
 {
-    sendQueue.push(msg);
+    if(ioThread)
+        ioThread->sendMsgAsync(msg);
+    else
+        sendQueue.push(msg);
 }
 
 void NetworkPlayer::sendMsg(const Message& msg)
 {
-    MessageQueue::sendMessage(socket, msg);
+    // The socket is used by the I/O thread, so only it may send.
+    // Stopping it sends the queued messages, so this is sent even if the connection is closed right after
+    if(ioThread)
+        ioThread->sendMsgAsync(msg.clone());
+    else
+        MessageQueue::sendMessage(socket, msg);
 }
 
 void NetworkPlayer::executeMsgs(MessageInterface& msgHandler)
 {
-    while(!recvQueue.empty())
-        recvQueue.pop()->run(&msgHandler, playerId);
+    if(ioThread)
+    {
+        // The handler might close the connection which stops the thread
+        while(ioThread)
+        {
+            const std::unique_ptr<Message> msg = ioThread->popReceivedMsg();
+            if(!msg)
+                break;
+            msg->run(&msgHandler, playerId);
+        }
+    } else
+    {
+        while(!recvQueue.empty())
+            recvQueue.pop()->run(&msgHandler, playerId);
+    }
 }
 
 void swap(NetworkPlayer& lhs, NetworkPlayer& rhs)
@@ -50,4 +88,5 @@ void swap(NetworkPlayer& lhs, NetworkPlayer& rhs)
     swap(lhs.recvQueue, rhs.recvQueue);
     swap(lhs.sendQueue, rhs.sendQueue);
     swap(lhs.socket, rhs.socket);
+    swap(lhs.ioThread, rhs.ioThread);
 }
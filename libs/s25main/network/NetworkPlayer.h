@@ -6,19 +6,28 @@
 
 #include "s25util/MessageQueue.h"
 #include "s25util/Socket.h"
+#include <limits>
+#include <memory>
 
 class Message;
 class MessageInterface;
+class NetworkIOThread;
 
 /// A player with a network connection and send/recv queues
 class NetworkPlayer
 {
 public:
     NetworkPlayer(unsigned playerId);
-    virtual ~NetworkPlayer() = default;
-    /// Close the socket and clear queues
+    NetworkPlayer(NetworkPlayer&&);
+    NetworkPlayer& operator=(NetworkPlayer&&);
+    virtual ~NetworkPlayer();
+    /// Close the socket, stop the I/O thread and clear queues. Messages queued in the I/O thread are sent before
     virtual void closeConnection();
+    /// Do the I/O of the (connected) socket in a separate thread from now on.
+    /// See NetworkIOThread for maxQueuedMsgs
+    void startIOThread(unsigned maxQueuedMsgs = std::numeric_limits<unsigned>::max());
     /// Receive all waiting messages from the socket. Return false on error
+    /// Note: If an I/O thread is set, all functions here use it instead of the queues and socket.
     bool receiveMsgs();
     /// Send at most maxNumMsgs (if non-negative). Return false on error
     bool sendMsgs(int maxNumMsgs);
@@ -33,6 +42,8 @@ public:
     unsigned playerId;
     MessageQueue recvQueue, sendQueue;
     Socket socket;
+    /// Thread doing the socket I/O if set
+    std::unique_ptr<NetworkIOThread> ioThread;
 };
 
 void swap(NetworkPlayer& lhs, NetworkPlayer& rhs);
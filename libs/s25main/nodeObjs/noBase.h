@@ -7,6 +7,7 @@
 #include "DrawPoint.h"
 #include "GameObject.h"
 #include "NodalObjectTypes.h"
+#include <boost/intrusive/list_hook.hpp>
 #include <memory>
 
 class FOWObject;
@@ -24,7 +25,11 @@ enum class BlockingManner
     NothingAround /// Allow nothing around
 };
 
-class noBase : public GameObject
+struct FigureListTag;
+/// Hook to put an object into the (intrusive) figure list of a map node without extra allocations
+using FigureListHook = boost::intrusive::list_base_hook<boost::intrusive::tag<FigureListTag>>;
+
+class noBase : public GameObject, public FigureListHook
 {
 public:
     noBase(const NodalObjectType nop) : nop(nop) {}
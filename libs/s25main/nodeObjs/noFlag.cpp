@@ -23,6 +23,7 @@
 noFlag::noFlag(const MapPoint pos, const unsigned char player)
     : noRoadNode(NodalObjectType::Flag, pos, player), ani_offset(rand() % 20000)
 {
+    numWaresForRoad.fill(0);
     // BWUs nullen
     for(auto& bwu : bwus)
     {
@@ -57,6 +58,9 @@ noFlag::noFlag(SerializedGameData& sgd, const unsigned obj_id)
         }
     } else
         sgd.PopObjectContainer(wares, GO_Type::Ware);
+    // The direction of the wares is already loaded as it is stored before their location
+    for(const auto dir : helpers::EnumRange<Direction>{})
+        numWaresForRoad[dir] = countWaresForRoad(dir);
 
     // BWUs laden
     for(auto& bwu : bwus)
@@ -81,6 +85,7 @@ void noFlag::Destroy()
         ware->Destroy();
     }
     wares.clear();
+    numWaresForRoad.fill(0);
 
     // Den Flag-Workern Bescheid sagen, die hier ggf. arbeiten
     world->GetPlayer(player).FlagDestroyed(this);
@@ -140,6 +145,7 @@ void noFlag::AddWare(std::unique_ptr<Ware> ware)
     // First add ware, then tell carrier. So get the info from the ware first
     const RoadPathDirection nextDir = ware->GetNextDir();
     wares.push_back(std::move(ware));
+    addWareDir(nextDir);
 
     if(nextDir != RoadPathDirection::None)
         GetRoute(toDirection(nextDir))->AddWareJob(this);
@@ -180,6 +186,7 @@ std::unique_ptr<Ware> noFlag::SelectWare(const Direction roadDir, const bool swa
     {
         bestWare = std::move(wares[best_ware_index]);
         wares.erase(wares.begin() + best_ware_index);
+        removeWareDir(bestWare->GetNextDir());
     }
 
     // ggf. anderen Trägern Bescheid sagen, aber nicht dem, der die Ware aufgehoben hat!
@@ -224,11 +231,41 @@ std::unique_ptr<Ware> noFlag::SelectWare(const Direction roadDir, const bool swa
 }
 
 unsigned noFlag::GetNumWaresForRoad(const Direction dir) const
+{
+    RTTR_Assert(numWaresForRoad[dir] == countWaresForRoad(dir));
+    return numWaresForRoad[dir];
+}
+
+unsigned noFlag::countWaresForRoad(const Direction dir) const
 {
     const auto roadDir = toRoadPathDirection(dir);
     return helpers::count_if(wares, [roadDir](const auto& ware) { return ware->GetNextDir() == roadDir; });
 }
 
+void noFlag::WareNextDirChanged(const Ware& ware, const RoadPathDirection oldNextDir)
+{
+    // Ware might be about to be placed at this flag or was just taken
+    if(!helpers::contains_if(wares, [&ware](const auto& curWare) { return curWare.get() == &ware; }))
+        return;
+    removeWareDir(oldNextDir);
+    addWareDir(ware.GetNextDir());
+}
+
+void noFlag::addWareDir(const RoadPathDirection dir)
+{
+    if(dir != RoadPathDirection::None && dir != RoadPathDirection::Ship)
+        ++numWaresForRoad[toDirection(dir)];
+}
+
+void noFlag::removeWareDir(const RoadPathDirection dir)
+{
+    if(dir != RoadPathDirection::None && dir != RoadPathDirection::Ship)
+    {
+        RTTR_Assert(numWaresForRoad[toDirection(dir)] > 0);
+        --numWaresForRoad[toDirection(dir)];
+    }
+}
+
 /**
  *  Gibt Wegstrafpunkte für das Pathfinden für Waren, die in eine bestimmte
  *  Richtung noch transportiert werden müssen.
@@ -293,6 +330,7 @@ void noFlag::Capture(const unsigned char new_owner)
         ware->Destroy();
     }
     wares.clear();
+    numWaresForRoad.fill(0);
 
     // Unregister this flag in the players flags
     world->GetPlayer(player).FlagDestroyed(this);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "ObjectPool.h"
 #include "noRoadNode.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/MapTypes.h"
@@ -16,7 +17,7 @@ class SerializedGameData;
 class Ware;
 class noFigure;
 
-class noFlag : public noRoadNode
+class noFlag : public noRoadNode, public PoolAllocated
 {
 public:
     noFlag(MapPoint pos, unsigned char player);
@@ -46,6 +47,8 @@ public:
     std::unique_ptr<Ware> SelectWare(Direction roadDir, bool swap_wares, const noFigure* carrier);
     /// Prüft, ob es Waren gibt, die auf den Weg in Richtung dir getragen werden müssen.
     unsigned GetNumWaresForRoad(Direction dir) const;
+    /// Called by a ware when its next direction changed to keep the number of wares per road up to date
+    void WareNextDirChanged(const Ware& ware, RoadPathDirection oldNextDir);
     /// Gibt Wegstrafpunkte für das Pathfinden für Waren, die in eine bestimmte Richtung noch transportiert werden
     /// müssen.
     unsigned GetPunishmentPoints(Direction dir) const override;
@@ -66,6 +69,14 @@ private:
 
     /// Die Waren, die an dieser Flagge liegen
     boost::container::static_vector<std::unique_ptr<Ware>, 8> wares;
+    /// Number of wares at this flag which need to be carried along the road in each direction.
+    /// Same as counting the wares but used often by the ware path finding
+    helpers::EnumArray<uint8_t, Direction> numWaresForRoad;
+
+    /// Add/Remove a ware going in the given direction to/from the counts
+    void addWareDir(RoadPathDirection dir);
+    void removeWareDir(RoadPathDirection dir);
+    unsigned countWaresForRoad(Direction dir) const;
 
     /// Wieviele BWU-Teile es maximal geben soll, also wieviele abgebrannte Lagerhausgruppen
     /// gleichzeitig die Flagge als nicht begehbar deklarieren können.
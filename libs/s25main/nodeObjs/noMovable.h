@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "ObjectPool.h"
 #include "noCoordBase.h"
 #include "gameTypes/Direction.h"
 #include "gameTypes/MapCoordinates.h"
@@ -24,7 +25,7 @@ struct EventState
     explicit EventState(SerializedGameData& sgd);
 };
 
-class noMovable : public noCoordBase
+class noMovable : public noCoordBase, public PoolAllocated
 {
     Direction curMoveDir; /// Current move direction
     uint8_t ascent;       /// Current ascent (0-2 runter, 3 gerade, 4-6 hoch)
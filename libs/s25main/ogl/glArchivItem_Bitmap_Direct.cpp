@@ -6,8 +6,12 @@
 #include "drivers/VideoDriverWrapper.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
+#include <algorithm>
 #include <stdexcept>
 
+/// Width and height of the tiles used to track the changed parts of the texture
+constexpr unsigned UPDATE_TILE_SIZE = 32;
+
 glArchivItem_Bitmap_Direct::glArchivItem_Bitmap_Direct() : isUpdating_(false) {}
 
 glArchivItem_Bitmap_Direct::glArchivItem_Bitmap_Direct(const glArchivItem_Bitmap_Direct& item)
@@ -19,7 +23,8 @@ void glArchivItem_Bitmap_Direct::beginUpdate()
     if(isUpdating_)
         throw std::logic_error("Already updating! Forgot an endUpdate?");
     isUpdating_ = true;
-    areaToUpdate_ = Rect(0, 0, 0, 0);
+    numTiles_ = (GetSize() + Extent::all(UPDATE_TILE_SIZE - 1)) / UPDATE_TILE_SIZE;
+    dirtyTiles_.assign(prodOfComponents(numTiles_), false);
 }
 
 void glArchivItem_Bitmap_Direct::endUpdate()
@@ -27,12 +32,32 @@ void glArchivItem_Bitmap_Direct::endUpdate()
     if(!isUpdating_)
         throw std::logic_error("Already updating! Forgot an endUpdate?");
     isUpdating_ = false;
-    // Nothing to update or no texture created yet
-    if(prodOfComponents(areaToUpdate_.getSize()) == 0 || !GetTexNoCreate())
+    // No texture created yet
+    if(!GetTexNoCreate())
         return;
 
-    libsiedler2::PixelBufferBGRA buffer(areaToUpdate_.getSize().x, areaToUpdate_.getSize().y);
-    Position origin = areaToUpdate_.getOrigin();
+    // Upload each horizontal run of changed tiles at once
+    for(unsigned tileY = 0; tileY < numTiles_.y; tileY++)
+    {
+        const auto itRowBegin = dirtyTiles_.begin() + tileY * numTiles_.x;
+        const auto itRowEnd = itRowBegin + numTiles_.x;
+        for(auto itRunBegin = std::find(itRowBegin, itRowEnd, true); itRunBegin != itRowEnd;)
+        {
+            const auto itRunEnd = std::find(itRunBegin, itRowEnd, false);
+            const Position origin(static_cast<int>((itRunBegin - itRowBegin) * UPDATE_TILE_SIZE),
+                                  static_cast<int>(tileY * UPDATE_TILE_SIZE));
+            const Position endPt(std::min<int>((itRunEnd - itRowBegin) * UPDATE_TILE_SIZE, GetSize().x),
+                                 std::min<int>(origin.y + UPDATE_TILE_SIZE, GetSize().y));
+            uploadArea(Rect(origin, Extent(endPt - origin)));
+            itRunBegin = std::find(itRunEnd, itRowEnd, true);
+        }
+    }
+}
+
+void glArchivItem_Bitmap_Direct::uploadArea(const Rect& area)
+{
+    libsiedler2::PixelBufferBGRA buffer(area.getSize().x, area.getSize().y);
+    Position origin = area.getOrigin();
     int ec = print(buffer, nullptr, 0, 0, origin.x, origin.y);
     RTTR_Assert(ec == 0);
     VIDEODRIVER.BindTexture(GetTexNoCreate());
@@ -46,19 +71,5 @@ void glArchivItem_Bitmap_Direct::updatePixel(const DrawPoint& pos, const libsied
     RTTR_Assert(pos.x >= 0 && pos.y >= 0);
     RTTR_Assert(static_cast<unsigned>(pos.x) < GetSize().x && static_cast<unsigned>(pos.y) < GetSize().y);
     setPixel(pos.x, pos.y, clr);
-    // If the area is empty, create one
-    if(areaToUpdate_.getSize().x == 0)
-        areaToUpdate_ = Rect(Position(pos), Extent(1, 1));
-    else
-    {
-        // Else resize if required
-        if(pos.x < areaToUpdate_.left)
-            areaToUpdate_.left = pos.x;
-        if(pos.x >= areaToUpdate_.right)
-            areaToUpdate_.right = pos.x + 1;
-        if(pos.y < areaToUpdate_.top)
-            areaToUpdate_.top = pos.y;
-        if(pos.y >= areaToUpdate_.bottom)
-            areaToUpdate_.bottom = pos.y + 1;
-    }
+    dirtyTiles_[(pos.y / UPDATE_TILE_SIZE) * numTiles_.x + pos.x / UPDATE_TILE_SIZE] = true;
 }
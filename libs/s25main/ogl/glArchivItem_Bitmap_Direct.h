@@ -6,6 +6,7 @@
 
 #include "Rect.h"
 #include "glArchivItem_Bitmap.h"
+#include <vector>
 
 namespace libsiedler2 {
 struct ColorBGRA;
@@ -21,7 +22,7 @@ public:
 
     /// Call before updating texture
     void beginUpdate();
-    /// Call after updating texture
+    /// Call after updating texture. Uploads only the changed parts
     void endUpdate();
     /// Updates a pixels color
     void updatePixel(const DrawPoint& pos, const libsiedler2::ColorBGRA& clr);
@@ -33,5 +34,11 @@ public:
 
 private:
     bool isUpdating_;
-    Rect areaToUpdate_;
+    /// Number of tiles in x and y
+    Extent numTiles_;
+    /// Tiles changed since beginUpdate (see UPDATE_TILE_SIZE)
+    std::vector<bool> dirtyTiles_;
+
+    /// Upload the given area of the bitmap to the texture
+    void uploadArea(const Rect& area);
 };
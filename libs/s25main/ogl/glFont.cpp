@@ -16,16 +16,39 @@
 #include "s25util/utf8.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/nowide/detail/utf.hpp>
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
 constexpr bool RTTR_PRINT_FONTS = false;
+/// Number of layouted texts to keep per font
+constexpr size_t LAYOUT_CACHE_SIZE = 256;
 namespace utf = boost::nowide::detail::utf;
 using utf8 = utf::utf_traits<char>;
 
+namespace {
+/// Condense the parts of the style relevant for the layout (alignment and used texture) into a single value
+unsigned getLayoutStyle(FontStyle format)
+{
+    unsigned result = 0;
+    if(format.is(FontStyle::RIGHT))
+        result |= 1;
+    else if(format.is(FontStyle::CENTER))
+        result |= 2;
+    if(format.is(FontStyle::BOTTOM))
+        result |= 4;
+    else if(format.is(FontStyle::VCENTER))
+        result |= 8;
+    if(format.is(FontStyle::NO_OUTLINE))
+        result |= 16;
+    return result;
+}
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 
-glFont::glFont(const libsiedler2::ArchivItem_Font& font) : maxCharSize(font.getDx(), font.getDy()), asciiMapping{}
+glFont::glFont(const libsiedler2::ArchivItem_Font& font)
+    : maxCharSize(font.getDx(), font.getDy()), denseMapping{}, layoutCache(LAYOUT_CACHE_SIZE)
 {
     fontWithOutline = libsiedler2::getAllocator().create<glArchivItem_Bitmap>(libsiedler2::BobType::Bitmap);
     fontNoOutline = libsiedler2::getAllocator().create<glArchivItem_Bitmap>(libsiedler2::BobType::Bitmap);
@@ -99,17 +122,17 @@ glFont::glFont(const libsiedler2::ArchivItem_Font& font) : maxCharSize(font.getD
 
 bool glFont::CharExist(char32_t c) const
 {
-    if(c < asciiMapping.size())
-        return asciiMapping[c].first;
+    if(c < numDenseChars)
+        return denseMapping[c].first;
     return helpers::contains(utf8_mapping, c);
 }
 
 const glFont::CharInfo& glFont::GetCharInfo(char32_t c) const
 {
-    if(c < asciiMapping.size())
+    if(c < numDenseChars)
     {
-        if(asciiMapping[c].first)
-            return asciiMapping[c].second;
+        if(denseMapping[c].first)
+            return denseMapping[c].second;
     } else
     {
         auto it = utf8_mapping.find(c);
@@ -121,8 +144,8 @@ const glFont::CharInfo& glFont::GetCharInfo(char32_t c) const
 
 void glFont::AddCharInfo(char32_t c, const CharInfo& info)
 {
-    if(c < asciiMapping.size())
-        asciiMapping[c] = std::make_pair(true, info);
+    if(c < numDenseChars)
+        denseMapping[c] = std::make_pair(true, info);
     else
         utf8_mapping[c] = info;
 }
@@ -132,7 +155,7 @@ void glFont::AddCharInfo(char32_t c, const CharInfo& info)
  */
 inline void glFont::DrawChar(char32_t curChar, VertexArrays& vertices, DrawPoint& curPos) const
 {
-    CharInfo ci = GetCharInfo(curChar);
+    const CharInfo& ci = GetCharInfo(curChar);
 
     GlPoint texCoord1(ci.pos);
     GlPoint texCoord2(ci.pos + DrawPoint(ci.width, maxCharSize.y));
@@ -175,6 +198,53 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
 {
     RTTR_Assert(s25util::isValidUTF8(text));
 
+    if(text.empty())
+        return;
+
+    // Get texture first as it might need to be created
+    glArchivItem_Bitmap& usedFont = format.is(FontStyle::NO_OUTLINE) ? *fontNoOutline : *fontWithOutline;
+    unsigned texture = usedFont.GetTexture();
+    if(!texture)
+        return;
+
+    const VertexArrays& layout = GetLayout(text, format, maxWidth, end, GlPoint(usedFont.GetTexSize()));
+    if(layout.vertices.empty())
+        return;
+
+    // Layout is relative to the drawing position
+    const GlPoint offset(pos);
+    texList.vertices.resize(layout.vertices.size());
+    std::transform(layout.vertices.begin(), layout.vertices.end(), texList.vertices.begin(),
+                   [offset](const GlPoint& pt) { return pt + offset; });
+
+    glVertexPointer(2, GL_FLOAT, 0, &texList.vertices[0]);
+    glTexCoordPointer(2, GL_FLOAT, 0, &layout.texCoords[0]);
+    VIDEODRIVER.BindTexture(texture);
+    glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
+    glDrawArrays(GL_QUADS, 0, texList.vertices.size());
+}
+
+/**
+ *  Erzeugt die Vertices eines Textes relativ zur Zeichenposition oder liefert sie aus dem Cache.
+ *
+ *  @param[in] text     Der Text
+ *  @param[in] format   Format des Textes (siehe Draw)
+ *  @param[in] maxWidth maximale Länge
+ *  @param     end      Suffix for displaying a truncation of the text (...)
+ *  @param[in] texSize  Size of the font texture used to normalize the texture coordinates
+ */
+const glFont::VertexArrays& glFont::GetLayout(const std::string& text, FontStyle format, unsigned short maxWidth,
+                                              const std::string& end, const GlPoint& texSize) const
+{
+    // Lookup without copying the strings, a hit must not allocate
+    const LayoutKeyView keyView{text, (maxWidth == 0xFFFF) ? boost::string_view() : boost::string_view(end), maxWidth,
+                                getLayoutStyle(format)};
+    if(VertexArrays* cachedLayout = layoutCache.find(keyView, LayoutKeyHash(), LayoutKeyEqual()))
+        return *cachedLayout;
+    const LayoutKey key(keyView);
+
+    VertexArrays layout;
+
     unsigned maxNumChars;
     unsigned short textWidth;
     bool drawEnd;
@@ -193,7 +263,7 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
 
             // If "end" does not fit, draw nothing
             if(textWidth < endWidth)
-                return;
+                return layoutCache.insert(key, std::move(layout));
 
             // Wieviele Buchstaben gehen in den "Rest" (ohne "end")
             textWidth = getWidth(text, textWidth - endWidth, &maxNumChars) + endWidth;
@@ -203,9 +273,10 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
     }
 
     if(maxNumChars == 0)
-        return;
+        return layoutCache.insert(key, std::move(layout));
     const auto itEnd = text.cbegin() + maxNumChars;
 
+    DrawPoint pos(0, 0);
     // Vertical alignment (assumes 1 line only!)
     if(format.is(FontStyle::BOTTOM))
         pos.y -= maxCharSize.y;
@@ -217,13 +288,10 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
     else if(format.is(FontStyle::CENTER))
         pos.x -= textWidth / 2;
 
-    texList.texCoords.clear();
-    texList.vertices.clear();
-
     for(auto it = text.begin(); it != itEnd;)
     {
         const utf::code_point curChar = utf8::decode(it, itEnd);
-        DrawChar(curChar, texList, pos);
+        DrawChar(curChar, layout, pos);
     }
 
     if(drawEnd)
@@ -231,29 +299,16 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
         for(auto it = end.begin(); it != end.end();)
         {
             const utf::code_point curChar = utf8::decode(it, end.end());
-            DrawChar(curChar, texList, pos);
+            DrawChar(curChar, layout, pos);
         }
     }
 
-    if(texList.vertices.empty())
-        return;
-
-    // Get texture first as it might need to be created
-    glArchivItem_Bitmap& usedFont = format.is(FontStyle::NO_OUTLINE) ? *fontNoOutline : *fontWithOutline;
-    unsigned texture = usedFont.GetTexture();
-    if(!texture)
-        return;
-    const GlPoint texSize(usedFont.GetTexSize());
-    RTTR_Assert(texList.texCoords.size() == texList.vertices.size());
-    RTTR_Assert(texList.texCoords.size() % 4u == 0);
-    for(GlPoint& pt : texList.texCoords)
+    RTTR_Assert(layout.texCoords.size() == layout.vertices.size());
+    RTTR_Assert(layout.texCoords.size() % 4u == 0);
+    for(GlPoint& pt : layout.texCoords)
         pt /= texSize;
 
-    glVertexPointer(2, GL_FLOAT, 0, &texList.vertices[0]);
-    glTexCoordPointer(2, GL_FLOAT, 0, &texList.texCoords[0]);
-    VIDEODRIVER.BindTexture(texture);
-    glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
-    glDrawArrays(GL_QUADS, 0, texList.vertices.size());
+    return layoutCache.insert(key, std::move(layout));
 }
 
 template<bool T_limitWidth>
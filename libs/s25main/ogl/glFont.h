@@ -6,14 +6,17 @@
 
 #include "DrawPoint.h"
 #include "Rect.h"
+#include "helpers/LRUCache.hpp"
 #include "ogl/FontStyle.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "s25util/colors.h"
+#include <boost/functional/hash.hpp>
+#include <boost/utility/string_view.hpp>
 #include <glad/glad.h>
 #include <array>
-#include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace libsiedler2 {
@@ -81,21 +84,80 @@ private:
         std::vector<GlPoint> texCoords;
         std::vector<GlPoint> vertices;
     };
+    /// Everything that influences the layout of a drawn text, referencing the strings
+    struct LayoutKeyView
+    {
+        boost::string_view text;
+        /// Truncation suffix, empty if the text is not limited in width
+        boost::string_view end;
+        unsigned short maxWidth;
+        unsigned style;
+    };
+    /// Owning version of the LayoutKeyView stored in the cache
+    struct LayoutKey
+    {
+        std::string text;
+        std::string end;
+        unsigned short maxWidth;
+        unsigned style;
+
+        explicit LayoutKey(const LayoutKeyView& key)
+            : text(key.text.begin(), key.text.end()), end(key.end.begin(), key.end.end()), maxWidth(key.maxWidth),
+              style(key.style)
+        {}
+        LayoutKeyView view() const { return LayoutKeyView{text, end, maxWidth, style}; }
+        bool operator==(const LayoutKey& rhs) const
+        {
+            return maxWidth == rhs.maxWidth && style == rhs.style && text == rhs.text && end == rhs.end;
+        }
+    };
+    /// Hash and equality accepting both key types, so a lookup does not need to copy the strings
+    struct LayoutKeyHash
+    {
+        std::size_t operator()(const LayoutKeyView& key) const
+        {
+            std::size_t seed = boost::hash_range(key.text.begin(), key.text.end());
+            boost::hash_combine(seed, boost::hash_range(key.end.begin(), key.end.end()));
+            boost::hash_combine(seed, key.maxWidth);
+            boost::hash_combine(seed, key.style);
+            return seed;
+        }
+        std::size_t operator()(const LayoutKey& key) const { return (*this)(key.view()); }
+    };
+    struct LayoutKeyEqual
+    {
+        bool operator()(const LayoutKeyView& lhs, const LayoutKeyView& rhs) const
+        {
+            return lhs.maxWidth == rhs.maxWidth && lhs.style == rhs.style && lhs.text == rhs.text
+                   && lhs.end == rhs.end;
+        }
+        bool operator()(const LayoutKey& lhs, const LayoutKeyView& rhs) const { return (*this)(lhs.view(), rhs); }
+        bool operator()(const LayoutKeyView& lhs, const LayoutKey& rhs) const { return (*this)(lhs, rhs.view()); }
+        bool operator()(const LayoutKey& lhs, const LayoutKey& rhs) const { return (*this)(lhs.view(), rhs.view()); }
+    };
 
     void AddCharInfo(char32_t c, const CharInfo& info);
     /// liefert das Char-Info eines Zeichens
     const CharInfo& GetCharInfo(char32_t c) const;
     void DrawChar(char32_t curChar, VertexArrays& vertices, DrawPoint& curPos) const;
+    /// Return the glyph quads of the text relative to the aligned drawing position (cached)
+    const VertexArrays& GetLayout(const std::string& text, FontStyle format, unsigned short maxWidth,
+                                  const std::string& end, const GlPoint& texSize) const;
 
     Extent maxCharSize; // How big each char is at most (aka dx,dy)
     std::unique_ptr<glArchivItem_Bitmap> fontNoOutline;
     std::unique_ptr<glArchivItem_Bitmap> fontWithOutline;
 
-    /// Holds ascii chars only. As most chars are ascii this is faster then accessing the map
-    std::array<std::pair<bool, CharInfo>, 256> asciiMapping;
-    std::map<char32_t, CharInfo> utf8_mapping;
+    /// Number of chars stored in the dense table: Latin, Greek and Cyrillic
+    static constexpr char32_t numDenseChars = 0x500;
+    /// Holds the most common chars only. Faster than accessing the hash map
+    std::array<std::pair<bool, CharInfo>, numDenseChars> denseMapping;
+    /// All other chars
+    std::unordered_map<char32_t, CharInfo> utf8_mapping;
     CharInfo placeHolder;         /// Placeholder if glyph is missing
-    mutable VertexArrays texList; /// Buffer to hold last textures. Used so memory reallocations are avoided
+    mutable VertexArrays texList; /// Buffer to hold last vertices. Used so memory reallocations are avoided
+    /// Recently drawn texts so static texts are not layouted each frame
+    mutable helpers::LRUCache<LayoutKey, VertexArrays, LayoutKeyHash> layoutCache;
 
     /// Get width of the sequence defined by the begin/end pair of iterators
     template<bool T_unlimitedWidth>
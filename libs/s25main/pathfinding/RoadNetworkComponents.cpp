@@ -0,0 +1,71 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "RoadNetworkComponents.h"
+#include "RoadSegment.h"
+#include "buildings/nobHarborBuilding.h"
+#include "helpers/EnumRange.h"
+#include "nodeObjs/noFlag.h"
+
+namespace {
+/// Return the flag through which all paths from/to the node go
+const noFlag& getFlag(const noRoadNode& node)
+{
+    if(node.GetGOT() == GO_Type::Flag)
+        return static_cast<const noFlag&>(node);
+    return *static_cast<const noBaseBuilding&>(node).GetFlag();
+}
+} // namespace
+
+unsigned RoadNetworkComponents::getComponent(const noFlag& flag)
+{
+    const auto it = flagToComponent_.find(&flag);
+    if(it != flagToComponent_.end())
+        return it->second;
+
+    // Flood fill over all flags connected by roads. Buildings are only entered if they are the goal so they don't
+    // connect anything except harbors via their ship connections
+    const auto componentIdx = static_cast<unsigned>(components_.size());
+    components_.emplace_back();
+    Component& component = components_.back();
+    std::vector<const noFlag*> todo{&flag};
+    flagToComponent_[&flag] = componentIdx;
+    while(!todo.empty())
+    {
+        const noFlag& curFlag = *todo.back();
+        todo.pop_back();
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            const RoadSegment* route = curFlag.GetRoute(dir);
+            if(!route)
+                continue;
+            const noRoadNode* neighbour = route->GetF1();
+            if(neighbour == &curFlag)
+                neighbour = route->GetF2();
+            if(neighbour->GetGOT() == GO_Type::Flag)
+            {
+                const auto* neighbourFlag = static_cast<const noFlag*>(neighbour);
+                if(flagToComponent_.emplace(neighbourFlag, componentIdx).second)
+                    todo.push_back(neighbourFlag);
+            } else if(neighbour->GetGOT() == GO_Type::NobHarborbuilding
+                      && !static_cast<const nobHarborBuilding*>(neighbour)->GetShipConnections().empty())
+                component.hasShipConnections = true;
+        }
+    }
+    return componentIdx;
+}
+
+bool RoadNetworkComponents::isUnreachable(const noRoadNode& start, const noRoadNode& goal)
+{
+    const unsigned startComponent = getComponent(getFlag(start));
+    const unsigned goalComponent = getComponent(getFlag(goal));
+    return startComponent != goalComponent && !components_[startComponent].hasShipConnections
+           && !components_[goalComponent].hasShipConnections;
+}
+
+bool RoadNetworkComponents::isReachable(const noRoadNode& start, const noRoadNode& goal)
+{
+    const unsigned startComponent = getComponent(getFlag(start));
+    return startComponent == getComponent(getFlag(goal)) && !components_[startComponent].hasShipConnections;
+}
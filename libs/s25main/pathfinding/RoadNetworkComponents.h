@@ -0,0 +1,34 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+class noFlag;
+class noRoadNode;
+
+/// Connected components of the road network as used by wares (including boat roads).
+/// Allows to decide if a ware can reach its goal without running a path search.
+/// Components are calculated lazily and are only valid as long as no roads are added or removed.
+/// Ship connections may be directed and change with the ships, so components containing a harbor with ship
+/// connections are treated as "unknown" and a real path search is required.
+class RoadNetworkComponents
+{
+    struct Component
+    {
+        bool hasShipConnections = false;
+    };
+    std::unordered_map<const noFlag*, unsigned> flagToComponent_;
+    std::vector<Component> components_;
+
+    unsigned getComponent(const noFlag& flag);
+
+public:
+    /// Return true if there is definitely no path for a ware from start to goal
+    bool isUnreachable(const noRoadNode& start, const noRoadNode& goal);
+    /// Return true if there is definitely a path for a ware from start to goal
+    bool isReachable(const noRoadNode& start, const noRoadNode& goal);
+};
@@ -0,0 +1,97 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "WalkableComponents.h"
+#include "RttrForeachPt.h"
+#include "helpers/EnumRange.h"
+#include "helpers/containerUtils.h"
+#include "pathfinding/PathConditionHuman.h"
+#include "world/World.h"
+#include <boost/container/static_vector.hpp>
+
+void WalkableComponents::calculate()
+{
+    components_.assign(prodOfComponents(world_.GetSize()), NO_COMPONENT);
+    // Same conditions as used for the path finding but without the objects
+    const PathConditionReachable nodeCondition(world_);
+    const PathConditionHuman edgeCondition(world_);
+    unsigned numComponents = 0;
+    std::vector<MapPoint> todo;
+    RTTR_FOREACH_PT(MapPoint, world_.GetSize())
+    {
+        if(components_[world_.GetIdx(pt)] != NO_COMPONENT || !nodeCondition.IsNodeOk(pt))
+            continue;
+        const unsigned component = ++numComponents;
+        components_[world_.GetIdx(pt)] = component;
+        todo.push_back(pt);
+        while(!todo.empty())
+        {
+            const MapPoint curPt = todo.back();
+            todo.pop_back();
+            for(const auto dir : helpers::EnumRange<Direction>{})
+            {
+                const MapPoint neighbourPt = world_.GetNeighbour(curPt, dir);
+                unsigned& neighbourComponent = components_[world_.GetIdx(neighbourPt)];
+                if(neighbourComponent == NO_COMPONENT && nodeCondition.IsNodeOk(neighbourPt)
+                   && edgeCondition.IsEdgeOk(curPt, dir))
+                {
+                    neighbourComponent = component;
+                    todo.push_back(neighbourPt);
+                }
+            }
+        }
+    }
+    isValid_ = true;
+}
+
+unsigned WalkableComponents::getComponent(const MapPoint pt) const
+{
+    return components_[world_.GetIdx(pt)];
+}
+
+bool WalkableComponents::mayBeReachable(const MapPoint start, const MapPoint dest)
+{
+    if(start == dest)
+        return true;
+    if(!isValid_)
+        calculate();
+
+    // Start and destination don't need to be walkable themselves, only the nodes in between.
+    // So compare the components of the nodes the path can use after the start and before the destination
+    const PathConditionHuman edgeCondition(world_);
+    boost::container::static_vector<unsigned, helpers::NumEnumValues_v<Direction>> startComponents;
+    for(const auto dir : helpers::EnumRange<Direction>{})
+    {
+        if(!edgeCondition.IsEdgeOk(start, dir))
+            continue;
+        const MapPoint neighbourPt = world_.GetNeighbour(start, dir);
+        if(neighbourPt == dest)
+            return true;
+        const unsigned component = getComponent(neighbourPt);
+        if(component != NO_COMPONENT)
+            startComponents.push_back(component);
+    }
+    if(startComponents.empty())
+        return false;
+    for(const auto dir : helpers::EnumRange<Direction>{})
+    {
+        const unsigned component = getComponent(world_.GetNeighbour(dest, dir));
+        if(component != NO_COMPONENT && helpers::contains(startComponents, component)
+           && edgeCondition.IsEdgeOk(dest, dir))
+            return true;
+    }
+    return false;
+}
+
+void WalkableComponents::roadAdded(const MapPoint pt, const Direction dir)
+{
+    if(!isValid_)
+        return;
+    // Only roads connecting 2 components change anything. Nodes humans can't walk over are only used as start or
+    // destination for which the roads are checked directly
+    const unsigned component = getComponent(pt);
+    const unsigned otherComponent = getComponent(world_.GetNeighbour(pt, dir));
+    if(component != NO_COMPONENT && otherComponent != NO_COMPONENT && component != otherComponent)
+        isValid_ = false;
+}
@@ -0,0 +1,39 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include <vector>
+
+class World;
+
+/// Connected components of the nodes humans can walk over (see PathConditionHuman) ignoring objects on the map.
+/// Objects can only block paths, so a human can never walk between nodes of different components which allows to skip
+/// the path search, e.g. for soldiers on another island.
+/// Components are calculated lazily. Roads can lead over otherwise impassable terrain, so they are recalculated when
+/// such a road is added or the terrain is changed. Removed roads keep the components merged which is still correct.
+class WalkableComponents
+{
+    const World& world_;
+    /// Component of each node or NO_COMPONENT if humans can't walk over it
+    std::vector<unsigned> components_;
+    bool isValid_ = false;
+
+    static constexpr unsigned NO_COMPONENT = 0;
+
+    void calculate();
+    unsigned getComponent(MapPoint pt) const;
+
+public:
+    explicit WalkableComponents(const World& world) : world_(world) {}
+
+    /// Return false if there is definitely no path for humans from start to dest
+    bool mayBeReachable(MapPoint start, MapPoint dest);
+    /// A road (not a boat road) was built from pt in dir
+    void roadAdded(MapPoint pt, Direction dir);
+    /// The terrain changed, recalculate everything
+    void invalidate() { isValid_ = false; }
+};
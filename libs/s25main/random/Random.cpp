@@ -37,7 +37,7 @@ void Random<T_PRNG>::ResetState(const PRNG& newState)
 template<class T_PRNG>
 int Random<T_PRNG>::Rand(const RandomContext& context, const int maxExcl)
 {
-    history_[numInvocations_ % history_.size()] = RandomEntry(numInvocations_, maxExcl, rng_, context);
+    history_[numInvocations_ % history_.size()] = HistoryEntry{numInvocations_, maxExcl, rng_, context};
     ++numInvocations_;
 
     return calcRandValue(rng_, maxExcl);
@@ -91,7 +91,10 @@ std::vector<typename Random<T_PRNG>::RandomEntry> Random<T_PRNG>::GetAsyncLog()
 
     ret.reserve(end - begin);
     for(unsigned i = begin; i < end; ++i)
-        ret.push_back(history_[i % history_.size()]);
+    {
+        const HistoryEntry& entry = history_[i % history_.size()];
+        ret.emplace_back(entry.counter, entry.maxExcl, entry.rngState, entry.context);
+    }
 
     return ret;
 }
@@ -78,8 +78,16 @@ private:
     PRNG rng_; /// the PRNG
     /// Number of invocations to the PRNG
     unsigned numInvocations_;
+    /// Compact entry of the history. The source name is only copied when the log is requested
+    struct HistoryEntry
+    {
+        unsigned counter;
+        int maxExcl;
+        PRNG rngState;
+        RandomContext context;
+    };
     /// History
-    std::array<RandomEntry, 1024> history_; //-V730_NOINIT
+    std::array<HistoryEntry, 1024> history_; //-V730_NOINIT
 };
 
 /// The actual PRNG used for the ingame RNG
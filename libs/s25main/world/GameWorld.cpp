@@ -26,6 +26,7 @@
 #include "notifications/RoadNote.h"
 #include "pathfinding/PathConditionHuman.h"
 #include "pathfinding/PathConditionRoad.h"
+#include "pathfinding/WalkableComponents.h"
 #include "postSystem/PostMsgWithBuilding.h"
 #include "world/MapGeometry.h"
 #include "world/TerritoryRegion.h"
@@ -120,6 +121,8 @@ void GameWorld::SetPointRoad(MapPoint pt, const Direction dir, const PointRoad t
 {
     const RoadDir rDir = toRoadDir(pt, dir);
     SetRoad(pt, rDir, type);
+    if(type != PointRoad::None && type != PointRoad::Boat)
+        GetWalkableComponents().roadAdded(pt, dir);
 
     if(gi)
         gi->GI_UpdateMinimap(pt);
@@ -1033,24 +1036,18 @@ bool GameWorld::IsValidPointForFighting(MapPoint pt, const nofActiveSoldier& sol
 bool GameWorld::IsPointCompletelyVisible(const MapPoint& pt, unsigned char player,
                                          const noBaseBuilding* exception) const
 {
-    sortedMilitaryBlds buildings = LookForMilitaryBuildings(pt, 3);
-
     // Sichtbereich von Militärgebäuden
-    for(const nobBaseMilitary* milBld : buildings)
-    {
-        if(milBld->GetPlayer() == player && milBld != exception)
-        {
-            // Prüfen, obs auch unbesetzt ist
-            if(milBld->GetGOT() == GO_Type::NobMilitary)
-            {
-                if(static_cast<const nobMilitary*>(milBld)->IsNewBuilt())
-                    continue;
-            }
-
-            if(CalcDistance(pt, milBld->GetPos()) <= unsigned(milBld->GetMilitaryRadius() + VISUALRANGE_MILITARY))
-                return true;
-        }
-    }
+    const bool visibleByMilBld =
+      CheckMilitaryBuildings(pt, 3, [this, pt, player, exception](const nobBaseMilitary* milBld) {
+          if(milBld->GetPlayer() != player || milBld == exception)
+              return false;
+          // Prüfen, obs auch unbesetzt ist
+          if(milBld->GetGOT() == GO_Type::NobMilitary && static_cast<const nobMilitary*>(milBld)->IsNewBuilt())
+              return false;
+          return CalcDistance(pt, milBld->GetPos()) <= unsigned(milBld->GetMilitaryRadius() + VISUALRANGE_MILITARY);
+      });
+    if(visibleByMilBld)
+        return true;
 
     // Sichtbereich von Hafenbaustellen
     for(const noBuildingSite* bldSite : harbor_building_sites_from_sea)
@@ -1141,7 +1138,7 @@ bool GameWorld::IsPointScoutedByShip(const MapPoint& pt, unsigned player) const
 void GameWorld::RecalcVisibility(const MapPoint pt, const unsigned char player, const noBaseBuilding* const exception)
 {
     /// Zustand davor merken
-    Visibility visibility_before = GetNode(pt).fow[player].visibility;
+    Visibility visibility_before = GetFoWNode(pt, player).visibility;
 
     /// Herausfinden, ob vollständig sichtbar
     bool visible = IsPointCompletelyVisible(pt, player, exception);
@@ -1215,7 +1212,7 @@ void GameWorld::RecalcMovingVisibilities(const MapPoint pt, const unsigned char
         // Sichtbarkeit und für FOW-Gebiet vorherigen Besitzer merken
         // (d.h. der dort  zuletzt war, als es für Spieler player sichtbar war)
         Visibility old_vis = CalcVisiblityWithAllies(tt, player);
-        unsigned char old_owner = GetNode(tt).fow[player].owner;
+        unsigned char old_owner = GetFoWNode(tt, player).owner;
         MakeVisible(tt, player);
         // Neues feindliches Gebiet entdeckt?
         // Muss vorher undaufgedeckt oder FOW gewesen sein, aber in dem Fall darf dort vorher noch kein
@@ -1239,7 +1236,7 @@ void GameWorld::RecalcMovingVisibilities(const MapPoint pt, const unsigned char
         // Sichtbarkeit und für FOW-Gebiet vorherigen Besitzer merken
         // (d.h. der dort  zuletzt war, als es für Spieler player sichtbar war)
         Visibility old_vis = CalcVisiblityWithAllies(tt, player);
-        unsigned char old_owner = GetNode(tt).fow[player].owner;
+        unsigned char old_owner = GetFoWNode(tt, player).owner;
         MakeVisible(tt, player);
         // Neues feindliches Gebiet entdeckt?
         // Muss vorher undaufgedeckt oder FOW gewesen sein, aber in dem Fall darf dort vorher noch kein
@@ -1420,9 +1417,16 @@ std::vector<unsigned> GameWorld::GetUnexploredHarborPoints(const unsigned hbIdTo
 
 MapNode& GameWorld::GetNodeWriteable(const MapPoint pt)
 {
+    // Terrain might be changed
+    GetWalkableComponents().invalidate();
     return GetNodeInt(pt);
 }
 
+FoWNode& GameWorld::GetFoWNodeWriteable(const MapPoint pt, unsigned char player)
+{
+    return GetFoWNodeInt(pt, player);
+}
+
 void GameWorld::VisibilityChanged(const MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis)
 {
     GameWorldBase::VisibilityChanged(pt, player, oldVis, newVis);
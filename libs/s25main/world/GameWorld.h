@@ -170,6 +170,8 @@ public:
 
     /// Writeable access to node. Use only for initial map setup!
     MapNode& GetNodeWriteable(MapPoint pt);
+    /// Writeable access to the FoW state of a node. Use only for initial map setup!
+    FoWNode& GetFoWNodeWriteable(MapPoint pt, unsigned char player);
     /// Recalculates where border stones should be done after a change in the given region
     void RecalcBorderStones(Position startPt, Extent areaSize);
 
@@ -21,6 +21,7 @@
 #include "notifications/PlayerNodeNote.h"
 #include "pathfinding/FreePathFinder.h"
 #include "pathfinding/RoadPathFinder.h"
+#include "pathfinding/WalkableComponents.h"
 #include "nodeObjs/noFlag.h"
 #include "gameData/BuildingProperties.h"
 #include "gameData/GameConsts.h"
@@ -28,7 +29,8 @@
 #include <utility>
 
 GameWorldBase::GameWorldBase(std::vector<GamePlayer> players, const GlobalGameSettings& gameSettings, EventManager& em)
-    : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)), players(std::move(players)),
+    : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)),
+      walkableComponents(std::make_unique<WalkableComponents>(*this)), players(std::move(players)),
       gameSettings(gameSettings), em(em), soundManager(std::make_unique<SoundManager>()), lua(nullptr), gi(nullptr)
 {}
 
@@ -39,10 +41,12 @@ void GameWorldBase::Init(const MapExtent& mapSize, DescIdx<LandscapeDesc> lt)
     RTTR_Assert(GetDescription().terrain.size() > 0); // Must have game data initialized
     World::Init(mapSize, lt);
     freePathFinder->Init(mapSize);
+    walkableComponents->invalidate();
 }
 
 void GameWorldBase::InitAfterLoad()
 {
+    walkableComponents->invalidate();
     RTTR_FOREACH_PT(MapPoint, GetSize())
         RecalcBQ(pt);
 }
@@ -286,8 +290,7 @@ void GameWorldBase::RecalcBQAroundPointBig(const MapPoint pt)
 
 Visibility GameWorldBase::CalcVisiblityWithAllies(const MapPoint pt, const unsigned char player) const
 {
-    const MapNode& node = GetNode(pt);
-    Visibility best_visibility = node.fow[player].visibility;
+    Visibility best_visibility = GetFoWNode(pt, player).visibility;
 
     if(best_visibility == Visibility::Visible)
         return best_visibility;
@@ -301,8 +304,8 @@ Visibility GameWorldBase::CalcVisiblityWithAllies(const MapPoint pt, const unsig
         {
             if(i != player && curPlayer.IsAlly(i))
             {
-                if(node.fow[i].visibility > best_visibility)
-                    best_visibility = node.fow[i].visibility;
+                if(GetFoWNode(pt, i).visibility > best_visibility)
+                    best_visibility = GetFoWNode(pt, i).visibility;
             }
         }
     }
@@ -13,6 +13,7 @@
 #include "postSystem/PostManager.h"
 #include "world/World.h"
 #include <memory>
+#include <utility>
 #include <vector>
 
 class EventManager;
@@ -25,6 +26,7 @@ class noBuildingSite;
 class noFlag;
 class nofPassiveSoldier;
 class RoadPathFinder;
+class WalkableComponents;
 class SoundManager;
 class TradePathCache;
 
@@ -51,6 +53,7 @@ class GameWorldBase : public World
 {
     std::unique_ptr<RoadPathFinder> roadPathFinder;
     std::unique_ptr<FreePathFinder> freePathFinder;
+    std::unique_ptr<WalkableComponents> walkableComponents;
     PostManager postManager;
     mutable NotificationManager notifications;
 
@@ -104,6 +107,13 @@ public:
     /// Erstellt eine Liste mit allen Milit�rgeb�uden in der Umgebung, radius bestimmt wie viele K�stchen nach einer
     /// Richtung im Umkreis
     sortedMilitaryBlds LookForMilitaryBuildings(MapPoint pt, unsigned short radius) const;
+    /// Like LookForMilitaryBuildings but calls the functor for each building till it returns true and returns true if it
+    /// did. Does not allocate but the order of the buildings is unspecified
+    template<class T_IsValidBld>
+    bool CheckMilitaryBuildings(MapPoint pt, unsigned short radius, T_IsValidBld&& isValid) const
+    {
+        return militarySquares.CheckBuildingsInRange(pt, radius, std::forward<T_IsValidBld>(isValid));
+    }
 
     /// Finds a path for figures. Returns first direction to walk in if found
     helpers::OptionalEnum<Direction> FindHumanPath(MapPoint start, MapPoint dest, unsigned max_route = 0xFFFFFFFF,
@@ -117,6 +127,7 @@ public:
                       unsigned* length);
     RoadPathFinder& GetRoadPathFinder() const { return *roadPathFinder; }
     FreePathFinder& GetFreePathFinder() const { return *freePathFinder; }
+    WalkableComponents& GetWalkableComponents() const { return *walkableComponents; }
 
     /// Return flag that is on road at given point. dir will be set to the direction of the road from the returned flag
     /// prevDir (if set) will be skipped when searching for the road points
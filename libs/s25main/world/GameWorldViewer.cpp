@@ -95,13 +95,12 @@ unsigned GameWorldViewer::GetNumSoldiersForAttack(const MapPoint pt) const
     // Militärgebäude in der Nähe finden
     unsigned total_count = 0;
 
-    sortedMilitaryBlds buildings = GetWorld().LookForMilitaryBuildings(pt, 3);
-    for(auto& building : buildings)
-    {
+    GetWorld().CheckMilitaryBuildings(pt, 3, [this, pt, &total_count](const nobBaseMilitary* building) {
         // Muss ein Gebäude von uns sein und darf nur ein "normales Militärgebäude" sein (kein HQ etc.)
         if(building->GetPlayer() == playerId_ && BuildingProperties::IsMilitary(building->GetBuildingType()))
-            total_count += static_cast<nobMilitary*>(building)->GetNumSoldiersForAttack(pt);
-    }
+            total_count += static_cast<const nobMilitary*>(building)->GetNumSoldiersForAttack(pt);
+        return false;
+    });
 
     return total_count;
 }
@@ -305,8 +304,7 @@ const FOWObject* GameWorldViewer::GetYoungestFOWObject(const MapPoint pos) const
 /// with the local player via team view
 const FoWNode& GameWorldViewer::GetYoungestFOWNode(const MapPoint pos) const
 {
-    const MapNode& node = GetWorld().GetNode(pos);
-    const FoWNode* bestNode = &node.fow[playerId_];
+    const FoWNode* bestNode = &GetWorld().GetFoWNode(pos, playerId_);
     unsigned youngest_time = bestNode->last_update_time;
 
     // Shared team view enabled?
@@ -319,7 +317,7 @@ const FoWNode& GameWorldViewer::GetYoungestFOWNode(const MapPoint pos) const
             if(!player.IsAlly(i))
                 continue;
             // Has the player FOW at this point at all?
-            const FoWNode* curNode = &node.fow[i];
+            const FoWNode* curNode = &GetWorld().GetFoWNode(pos, i);
             if(curNode->visibility == Visibility::FogOfWar)
             {
                 // Younger than the youngest or no object at all?
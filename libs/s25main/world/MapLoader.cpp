@@ -122,7 +122,7 @@ void MapLoader::SetMapExplored(World& world)
         for(unsigned i = 0; i < MAX_PLAYERS; ++i)
         {
             // If we have FoW here, save it
-            if(world.GetNode(pt).fow[i].visibility == Visibility::FogOfWar)
+            if(world.GetFoWNode(pt, i).visibility == Visibility::FogOfWar)
                 world.SaveFOWNode(pt, i, 0);
         }
     }
@@ -198,8 +198,9 @@ bool MapLoader::InitNodes(const libsiedler2::ArchivItem_Map& map, Exploration ex
         }
 
         // FOW-Zeug initialisieren
-        for(auto& fow : node.fow)
+        for(unsigned i = 0; i < MAX_PLAYERS; ++i)
         {
+            FoWNode& fow = world_.GetFoWNodeInt(pt, i);
             fow = FoWNode();
             fow.visibility = fowVisibility;
         }
@@ -23,9 +23,9 @@ void MapSerializer::Serialize(const GameWorldBase& world, SerializedGameData& sg
 
     // Alle Weltpunkte serialisieren
     const unsigned numPlayers = world.GetNumPlayers();
-    for(const auto& node : world.nodes)
+    for(unsigned i = 0; i < world.nodes.size(); ++i)
     {
-        node.Serialize(sgd, numPlayers, world.GetDescription());
+        world.nodes[i].Serialize(sgd, numPlayers, world.GetDescription(), &world.fowNodes[i * MAX_PLAYERS]);
     }
 
     // Katapultsteine serialisieren
@@ -122,9 +122,11 @@ void MapSerializer::Deserialize(GameWorldBase& world, SerializedGameData& sgd, G
     // Alle Weltpunkte
     MapPoint curPos(0, 0);
     const unsigned numPlayers = world.GetNumPlayers();
-    for(auto& node : world.nodes)
+    for(unsigned i = 0; i < world.nodes.size(); ++i)
     {
-        node.Deserialize(sgd, numPlayers, world.GetDescription(), landscapeTerrains);
+        MapNode& node = world.nodes[i];
+        node.Deserialize(sgd, numPlayers, world.GetDescription(), landscapeTerrains,
+                         &world.fowNodes[i * MAX_PLAYERS]);
         if(node.harborId)
         {
             HarborPos p(curPos);
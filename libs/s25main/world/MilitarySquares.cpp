@@ -4,8 +4,8 @@
 
 #include "world/MilitarySquares.h"
 #include "buildings/nobBaseMilitary.h"
-#include "helpers/containerUtils.h"
 #include "gameData/MilitaryConsts.h"
+#include <algorithm>
 
 MilitarySquares::MilitarySquares() : size_(MapExtent::all(0)) {}
 
@@ -24,7 +24,7 @@ void MilitarySquares::Clear()
     size_ = MapExtent::all(0);
 }
 
-std::list<nobBaseMilitary*>& MilitarySquares::GetSquare(const MapPoint pt)
+MilitarySquares::Square& MilitarySquares::GetSquare(const MapPoint pt)
 {
     MapPoint milPt = pt / MILITARY_SQUARE_SIZE;
     return squares[milPt.y * size_.x + milPt.x];
@@ -37,47 +37,32 @@ void MilitarySquares::Add(nobBaseMilitary* const bld)
 
 void MilitarySquares::Remove(nobBaseMilitary* const bld)
 {
-    RTTR_Assert(helpers::contains(GetSquare(bld->GetPos()), bld));
-    GetSquare(bld->GetPos()).remove(bld);
+    Square& square = GetSquare(bld->GetPos());
+    const auto it = std::find(square.begin(), square.end(), bld);
+    RTTR_Assert(it != square.end());
+    square.erase(it);
 }
 
-sortedMilitaryBlds MilitarySquares::GetBuildingsInRange(const MapPoint pt, unsigned short radius) const
+void MilitarySquares::GetSquareRange(const MapPoint pt, unsigned short radius, MapPoint& firstSquare,
+                                     MapExtent& numSquares) const
 {
-    // maximum radius is half the size (rounded up) to avoid overlapping
-    const Position offsets = elMin((size_ + Position::all(1)) / 2, Position::all(radius));
-
     // Convert to military coords
-    const Position milPos(pt / MILITARY_SQUARE_SIZE);
-
-    const Position firstPt = milPos - offsets;
-    const Position lastPt = milPos + offsets;
-
-    // List with unique(!) military buildings
-    sortedMilitaryBlds buildings;
-
-    // Create list
-    for(int cy = firstPt.y; cy <= lastPt.y; ++cy)
-    {
-        // Handle wrap-around
-        int realY = cy;
-        if(realY < 0)
-            realY += size_.y;
-        else if(realY >= static_cast<int>(size_.y))
-            realY -= size_.y;
-        RTTR_Assert(realY >= 0 && realY < static_cast<int>(size_.y));
-        for(int cx = firstPt.x; cx <= lastPt.x; ++cx)
-        {
-            int realX = cx;
-            if(realX < 0)
-                realX += size_.x;
-            else if(realX >= static_cast<int>(size_.x))
-                realX -= size_.x;
-            RTTR_Assert(realX >= 0 && realX < static_cast<int>(size_.x));
-            const std::list<nobBaseMilitary*>& milBuildings = squares[realY * size_.x + realX];
-            for(auto* milBuilding : milBuildings)
-                buildings.insert(milBuilding);
-        }
-    }
+    const MapPoint milPt = pt / MILITARY_SQUARE_SIZE;
+    numSquares = elMin(MapExtent::all(static_cast<MapCoord>(2 * radius + 1)), size_);
+    // Start radius squares before (with wrap-around). If the whole map is covered it doesn't matter where we start
+    firstSquare.x = static_cast<MapCoord>((milPt.x + size_.x - radius % size_.x) % size_.x);
+    firstSquare.y = static_cast<MapCoord>((milPt.y + size_.y - radius % size_.y) % size_.y);
+}
 
-    return buildings;
+sortedMilitaryBlds MilitarySquares::GetBuildingsInRange(const MapPoint pt, unsigned short radius) const
+{
+    // Every building is found only once, so just sort them
+    sortedMilitaryBlds::sequence_type buildings;
+    CheckBuildingsInRange(pt, radius, [&buildings](nobBaseMilitary* bld) {
+        buildings.push_back(bld);
+        return false;
+    });
+    sortedMilitaryBlds result;
+    result.adopt_sequence(std::move(buildings));
+    return result;
 }
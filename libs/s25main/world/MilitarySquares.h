@@ -5,7 +5,7 @@
 #pragma once
 
 #include "gameTypes/MapCoordinates.h"
-#include <list>
+#include <boost/container/small_vector.hpp>
 #include <vector>
 
 class nobBaseMilitary;
@@ -13,11 +13,16 @@ class sortedMilitaryBlds;
 
 class MilitarySquares
 {
+    /// Usually only a few military buildings are in each square, so they are stored inline
+    using Square = boost::container::small_vector<nobBaseMilitary*, 4>;
     /// military buildings (including HQs and harbors) per military square
-    std::vector<std::list<nobBaseMilitary*>> squares;
+    std::vector<Square> squares;
     MapExtent size_;
     // Liefert das entsprechende Militärquadrat für einen bestimmten Punkt auf der Karte zurück (normale Koordinaten)
-    std::list<nobBaseMilitary*>& GetSquare(MapPoint pt);
+    Square& GetSquare(MapPoint pt);
+    /// Get the first square and the number of squares in each direction for the given range.
+    /// Every square is included only once even if the range is bigger than the map
+    void GetSquareRange(MapPoint pt, unsigned short radius, MapPoint& firstSquare, MapExtent& numSquares) const;
 
 public:
     MilitarySquares();
@@ -25,5 +30,38 @@ public:
     void Clear();
     void Add(nobBaseMilitary* bld);
     void Remove(nobBaseMilitary* bld);
+    /// Return all buildings in the range sorted by their creation (see nobBaseMilitary::Comparer)
     sortedMilitaryBlds GetBuildingsInRange(MapPoint pt, unsigned short radius) const;
+    /// Call the functor for every building in the range (once each, in no particular order) till it returns true.
+    /// Returns true if the functor returned true
+    template<class T_IsValidBld>
+    bool CheckBuildingsInRange(MapPoint pt, unsigned short radius, T_IsValidBld&& isValid) const;
 };
+
+template<class T_IsValidBld>
+bool MilitarySquares::CheckBuildingsInRange(const MapPoint pt, unsigned short radius, T_IsValidBld&& isValid) const
+{
+    MapPoint firstSquare;
+    MapExtent numSquares;
+    GetSquareRange(pt, radius, firstSquare, numSquares);
+    unsigned y = firstSquare.y;
+    for(unsigned i = 0; i < numSquares.y; ++i)
+    {
+        const Square* row = &squares[y * size_.x];
+        unsigned x = firstSquare.x;
+        for(unsigned j = 0; j < numSquares.x; ++j)
+        {
+            for(nobBaseMilitary* bld : row[x])
+            {
+                if(isValid(bld))
+                    return true;
+            }
+            // Handle wrap-around
+            if(++x == size_.x)
+                x = 0;
+        }
+        if(++y == size_.y)
+            y = 0;
+    }
+    return false;
+}
@@ -12,9 +12,9 @@
 #include "RoadSegment.h"
 #include "enum_cast.hpp"
 #include "helpers/containerUtils.h"
-#include "helpers/pointerContainerUtils.h"
 #include "gameTypes/ShipDirection.h"
 #include "gameData/TerrainDesc.h"
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <stdexcept>
@@ -67,7 +67,7 @@ void World::Unload()
 
     // Figuren vernichten
     for(auto& node : nodes)
-        node.figures.clear();
+        node.clearFigures();
 
     catapult_stones.clear();
     harbor_pos.clear();
@@ -80,10 +80,12 @@ void World::Resize(const MapExtent& newSize)
 {
     MapBase::Resize(newSize);
     nodes.clear();
+    fowNodes.clear();
     militarySquares.Clear();
     if(GetSize().x > 0)
     {
         nodes.resize(prodOfComponents(GetSize()));
+        fowNodes.resize(nodes.size() * MAX_PLAYERS);
         militarySquares.Init(GetSize());
     }
 }
@@ -92,21 +94,20 @@ noBase& World::AddFigureImpl(const MapPoint pt, std::unique_ptr<noBase> fig)
 {
     RTTR_Assert(fig);
 
-    auto& figures = GetNodeInt(pt).figures;
-#if RTTR_ENABLE_ASSERTS
-    RTTR_Assert(!helpers::containsPtr(figures, fig.get()));
-    for(const MapPoint nb : GetNeighbours(pt))
-        RTTR_Assert(!helpers::containsPtr(GetNode(nb).figures, fig.get())); // Added figure that is in surrounding?
-#endif
+    // A figure can only be in one list (node) at a time
+    RTTR_Assert(!static_cast<const FigureListHook&>(*fig).is_linked());
 
-    noBase& result = *fig;
-    figures.push_back(std::move(fig));
+    noBase& result = *fig.release();
+    GetNodeInt(pt).figures.push_back(result);
     return result;
 }
 
 noBase* World::RemoveFigureImpl(const MapPoint pt, noBase& fig)
 {
-    return helpers::extractPtr(GetNodeInt(pt).figures, &fig).release();
+    RTTR_Assert(HasFigureAt(pt, fig));
+    auto& figures = GetNodeInt(pt).figures;
+    figures.erase(figures.iterator_to(fig));
+    return &fig;
 }
 
 noBase* World::GetNO(const MapPoint pt)
@@ -173,7 +174,7 @@ void World::SetReserved(const MapPoint pt, const bool reserved)
 
 void World::SetVisibility(const MapPoint pt, unsigned char player, Visibility vis, unsigned fowTime)
 {
-    FoWNode& node = GetNodeInt(pt).fow[player];
+    FoWNode& node = GetFoWNodeInt(pt, player);
     Visibility oldVis = node.visibility;
     if(oldVis == vis)
         return;
@@ -241,7 +242,8 @@ BuildingQuality World::AdjustBQ(const MapPoint pt, unsigned char player, Buildin
 
 bool World::HasFigureAt(const MapPoint pt, const noBase& figure) const
 {
-    return helpers::containsPtr(GetNode(pt).figures, &figure);
+    const FigureList& figures = GetNode(pt).figures;
+    return std::any_of(figures.begin(), figures.end(), [&figure](const noBase& cur) { return &cur == &figure; });
 }
 
 WalkTerrain World::GetTerrain(MapPoint pt, Direction dir) const
@@ -312,7 +314,7 @@ helpers::EnumArray<DescIdx<TerrainDesc>, Direction> World::GetTerrainsAround(Map
 
 void World::SaveFOWNode(const MapPoint pt, const unsigned player, unsigned curTime)
 {
-    FoWNode& fow = GetNodeInt(pt).fow[player];
+    FoWNode& fow = GetFoWNodeInt(pt, player);
     fow.last_update_time = curTime;
 
     // FOW-Objekt erzeugen
@@ -386,7 +388,7 @@ PointRoad World::GetPointRoad(MapPoint pt, Direction dir) const
 PointRoad World::GetPointFOWRoad(MapPoint pt, Direction dir, const unsigned char viewing_player) const
 {
     const RoadDir rDir = toRoadDir(pt, dir);
-    return GetNode(pt).fow[viewing_player].roads[rDir];
+    return GetFoWNode(pt, viewing_player).roads[rDir];
 }
 
 void World::AddCatapultStone(CatapultStone* cs)
@@ -487,12 +489,9 @@ void World::RecalcShadow(const MapPoint pt)
 
 void World::MakeWholeMapVisibleForAllPlayers()
 {
-    for(auto& mapNode : nodes)
+    for(auto& fowNode : fowNodes)
     {
-        for(auto& fowNode : mapNode.fow)
-        {
-            fowNode.visibility = Visibility::Visible;
-            fowNode.object.reset();
-        }
+        fowNode.visibility = Visibility::Visible;
+        fowNode.object.reset();
     }
 }
@@ -5,16 +5,17 @@
 #pragma once
 
 #include "enum_cast.hpp"
-#include "helpers/PtrSpan.h"
 #include "world/MapBase.h"
 #include "world/MilitarySquares.h"
 #include "gameTypes/Direction.h"
+#include "gameTypes/FoWNode.h"
 #include "gameTypes/GO_Type.h"
 #include "gameTypes/HarborPos.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/MapNode.h"
 #include "gameTypes/MapTypes.h"
 #include "gameData/DescIdx.h"
+#include "gameData/MaxPlayers.h"
 #include "gameData/WorldDescription.h"
 #include <list>
 #include <memory>
@@ -52,6 +53,9 @@ class World : public MapBase
 
     /// Eigenschaften von einem Punkt auf der Map
     std::vector<MapNode> nodes;
+    /// FoW state of each player for each node. Kept apart from the nodes as it is rarely accessed but big.
+    /// Stored per node: MAX_PLAYERS consecutive entries
+    std::vector<FoWNode> fowNodes;
 
     std::vector<Sea> seas;
 
@@ -93,6 +97,8 @@ public:
     const MapNode& GetNode(MapPoint pt) const;
     /// Return the neighboring node
     const MapNode& GetNeighbourNode(MapPoint pt, Direction dir) const;
+    /// Return how the player sees the node
+    const FoWNode& GetFoWNode(MapPoint pt, unsigned char player) const;
 
     // Add a figure to a node (taking ownership) and returns a reference to it
     template<typename T>
@@ -141,8 +147,8 @@ public:
     /// Incorporates node ownership into the given BQ
     BuildingQuality AdjustBQ(MapPoint pt, unsigned char player, BuildingQuality nodeBQ) const;
 
-    /// Return the figures currently on the node
-    auto GetFigures(const MapPoint pt) const { return helpers::nonNullPtrSpan(GetNode(pt).figures); }
+    /// Return the figures currently on the node. The figures can be modified, the list itself not
+    FigureRange GetFigures(const MapPoint pt) const { return FigureRange(const_cast<FigureList&>(GetNode(pt).figures)); }
     bool HasFigureAt(MapPoint pt, const noBase& figure) const;
 
     /// Return a specific object or nullptr
@@ -235,6 +241,7 @@ protected:
     /// Internal method for access to nodes with write access
     MapNode& GetNodeInt(MapPoint pt);
     MapNode& GetNeighbourNodeInt(MapPoint pt, Direction dir);
+    FoWNode& GetFoWNodeInt(MapPoint pt, unsigned char player);
 
     /// Notify derived classes of changed altitude
     virtual void AltitudeChanged(MapPoint pt) = 0;
@@ -269,6 +276,18 @@ inline const MapNode& World::GetNeighbourNode(const MapPoint pt, Direction dir)
     return GetNode(GetNeighbour(pt, dir));
 }
 
+inline const FoWNode& World::GetFoWNode(const MapPoint pt, unsigned char player) const
+{
+    RTTR_Assert(player < MAX_PLAYERS);
+    return fowNodes[GetIdx(pt) * MAX_PLAYERS + player];
+}
+
+inline FoWNode& World::GetFoWNodeInt(const MapPoint pt, unsigned char player)
+{
+    RTTR_Assert(player < MAX_PLAYERS);
+    return fowNodes[GetIdx(pt) * MAX_PLAYERS + player];
+}
+
 inline MapNode& World::GetNeighbourNodeInt(const MapPoint pt, Direction dir)
 {
     return GetNodeInt(GetNeighbour(pt, dir));
@@ -0,0 +1,79 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/LRUCache.hpp"
+#include <boost/test/unit_test.hpp>
+#include <boost/utility/string_view.hpp>
+#include <functional>
+#include <string>
+
+namespace {
+/// Hashes std::string and boost::string_view equally
+struct StringHash
+{
+    std::size_t operator()(boost::string_view str) const { return boost::hash_range(str.begin(), str.end()); }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(LRUCacheTests)
+
+BOOST_AUTO_TEST_CASE(FindAndInsert)
+{
+    helpers::LRUCache<std::string, int> cache(3);
+    BOOST_TEST(cache.max_size() == 3u);
+    BOOST_TEST(cache.size() == 0u);
+    BOOST_TEST(!cache.find("a"));
+    BOOST_TEST(cache.insert("a", 1) == 1);
+    BOOST_TEST(cache.insert("b", 2) == 2);
+    BOOST_TEST(cache.size() == 2u);
+    BOOST_TEST_REQUIRE(cache.find("a"));
+    BOOST_TEST(*cache.find("a") == 1);
+    BOOST_TEST_REQUIRE(cache.find("b"));
+    BOOST_TEST(*cache.find("b") == 2);
+    // Values are modifiable
+    *cache.find("b") = 5;
+    BOOST_TEST(*cache.find("b") == 5);
+    cache.clear();
+    BOOST_TEST(cache.size() == 0u);
+    BOOST_TEST(!cache.find("a"));
+}
+
+BOOST_AUTO_TEST_CASE(EvictsLeastRecentlyUsed)
+{
+    helpers::LRUCache<int, int> cache(3);
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    cache.insert(3, 30);
+    // Use 1 -> 2 is now the oldest
+    BOOST_TEST(cache.find(1));
+    cache.insert(4, 40);
+    BOOST_TEST(cache.size() == 3u);
+    BOOST_TEST(!cache.find(2));
+    BOOST_TEST(*cache.find(1) == 10);
+    BOOST_TEST(*cache.find(3) == 30);
+    BOOST_TEST(*cache.find(4) == 40);
+    // 1 is oldest now
+    cache.insert(5, 50);
+    BOOST_TEST(!cache.find(1));
+    BOOST_TEST(*cache.find(5) == 50);
+    BOOST_TEST(cache.size() == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(FindCompatibleKey)
+{
+    helpers::LRUCache<std::string, int, StringHash> cache(2);
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    const std::string text = "xab";
+    const boost::string_view viewA = boost::string_view(text).substr(1, 1);
+    BOOST_TEST_REQUIRE(cache.find(viewA, StringHash(), std::equal_to<>()));
+    BOOST_TEST(*cache.find(viewA, StringHash(), std::equal_to<>()) == 1);
+    BOOST_TEST(!cache.find(boost::string_view(text), StringHash(), std::equal_to<>()));
+    // Lookup marks as used -> b is evicted
+    cache.insert("c", 3);
+    BOOST_TEST(!cache.find("b"));
+    BOOST_TEST(*cache.find(std::string("a")) == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/ParallelFor.h"
+#include "helpers/ThreadPool.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(ParallelForTests)
+
+BOOST_AUTO_TEST_CASE(VisitsEachItemOnce)
+{
+    for(unsigned numThreads : {0u, 1u, 2u, 3u, 7u, 100u})
+    {
+        for(int numItems : {0, 1, 2, 5, 13, 100})
+        {
+            std::vector<int> visits(numItems, 0);
+            helpers::parallelFor(0, numItems, [&visits](int i) { ++visits[i]; }, numThreads);
+            BOOST_TEST(std::accumulate(visits.begin(), visits.end(), 0) == numItems);
+            BOOST_TEST(std::count(visits.begin(), visits.end(), 1) == numItems);
+        }
+    }
+    // Offset range
+    std::vector<unsigned> visits(20, 0);
+    helpers::parallelFor(5u, 15u, [&visits](unsigned i) { visits[i] = i; }, 4);
+    for(unsigned i = 0; i < visits.size(); i++)
+        BOOST_TEST(visits[i] == ((i >= 5 && i < 15) ? i : 0u));
+}
+
+BOOST_AUTO_TEST_CASE(RethrowsExceptions)
+{
+    const auto throwAt = [](int i) {
+        if(i == 17)
+            throw std::runtime_error("Test");
+    };
+    BOOST_CHECK_THROW(helpers::parallelFor(0, 20, throwAt, 1), std::runtime_error);
+    BOOST_CHECK_THROW(helpers::parallelFor(0, 20, throwAt, 4), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(ReusesPoolThreads)
+{
+    std::mutex mutex;
+    std::set<std::thread::id> usedThreads;
+    for(unsigned i = 0; i < 50; i++)
+    {
+        helpers::parallelFor(0, 64, [&](int) {
+            std::lock_guard<std::mutex> lock(mutex);
+            usedThreads.insert(std::this_thread::get_id());
+        });
+    }
+    // Calling thread and the threads of the pool, no new ones per call
+    BOOST_TEST(usedThreads.size() <= helpers::ThreadPool::getDefault().getNumThreads() + 1u);
+    BOOST_TEST(helpers::getDefaultNumThreads() == helpers::ThreadPool::getDefault().getNumThreads() + 1u);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadPoolExecutesAllTasks)
+{
+    std::atomic<unsigned> numExecuted(0);
+    {
+        helpers::ThreadPool pool(3);
+        BOOST_TEST(pool.getNumThreads() == 3u);
+        for(unsigned i = 0; i < 100; i++)
+            pool.push([&numExecuted]() { ++numExecuted; });
+        // Calling thread may help
+        while(pool.runPendingTask()) {}
+    }
+    // Destructor waits for pending tasks
+    BOOST_TEST(numExecuted == 100u);
+
+    // Without threads only the caller executes the tasks
+    helpers::ThreadPool emptyPool(0);
+    emptyPool.push([&numExecuted]() { ++numExecuted; });
+    BOOST_TEST(numExecuted == 100u);
+    BOOST_TEST(emptyPool.runPendingTask());
+    BOOST_TEST(numExecuted == 101u);
+    BOOST_TEST(!emptyPool.runPendingTask());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Rect.h"
+#include "ogl/glArchivItem_Bitmap_Direct.h"
+#include "uiHelper/uiHelpers.hpp"
+#include "libsiedler2/PixelBufferBGRA.h"
+#include <boost/test/unit_test.hpp>
+#include <glad/glad.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+/// Content of the texture as updated by glTexSubImage2D
+libsiedler2::PixelBufferBGRA* curTexture = nullptr;
+std::vector<Rect> uploadedAreas;
+
+void APIENTRY captureTexSubImage2D(GLenum, GLint, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum,
+                                   GLenum, const GLvoid* pixels)
+{
+    uploadedAreas.emplace_back(Position(xoffset, yoffset), Extent(width, height));
+    const auto* srcPixels = static_cast<const uint8_t*>(pixels);
+    for(int y = 0; y < height; y++)
+    {
+        std::memcpy(curTexture->getPixelPtr() + ((yoffset + y) * curTexture->getWidth() + xoffset) * 4u,
+                    srcPixels + y * width * 4u, width * 4u);
+    }
+}
+
+struct TexUploadFixture : uiHelper::Fixture
+{
+    PFNGLTEXSUBIMAGE2DPROC origTexSubImage2D;
+    TexUploadFixture() : origTexSubImage2D(glTexSubImage2D)
+    {
+        glTexSubImage2D = captureTexSubImage2D;
+        uploadedAreas.clear();
+    }
+    ~TexUploadFixture()
+    {
+        glTexSubImage2D = origTexSubImage2D;
+        curTexture = nullptr;
+    }
+};
+
+libsiedler2::ColorBGRA getTestColor(unsigned x, unsigned y)
+{
+    return libsiedler2::ColorBGRA(x % 256, y % 256, (x + y) % 256, 0xFF);
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(BitmapDirect, TexUploadFixture)
+
+BOOST_AUTO_TEST_CASE(UploadsOnlyChangedTiles)
+{
+    // 4x3 tiles of 32x32 pixels, last column and row are not full
+    const Extent size(100, 70);
+    libsiedler2::PixelBufferBGRA buffer(size.x, size.y);
+    for(unsigned y = 0; y < size.y; y++)
+    {
+        for(unsigned x = 0; x < size.x; x++)
+            buffer.set(x, y, getTestColor(x, y));
+    }
+    glArchivItem_Bitmap_Direct bmp;
+    bmp.create(buffer);
+    BOOST_TEST_REQUIRE(bmp.GetTexture() != 0u);
+    // Texture has the initial content
+    libsiedler2::PixelBufferBGRA texture = buffer;
+    curTexture = &texture;
+
+    // Nothing changed -> Nothing uploaded
+    bmp.beginUpdate();
+    bmp.endUpdate();
+    BOOST_TEST(uploadedAreas.empty());
+
+    const libsiedler2::ColorBGRA newColor(1, 2, 3, 0xFF);
+    bmp.beginUpdate();
+    // Tile (0, 0)
+    bmp.updatePixel(DrawPoint(0, 0), newColor);
+    // Tile (1, 0) twice and its right neighbour -> One run
+    bmp.updatePixel(DrawPoint(33, 5), newColor);
+    bmp.updatePixel(DrawPoint(40, 31), newColor);
+    bmp.updatePixel(DrawPoint(64, 10), newColor);
+    // Partial tile in the corner
+    bmp.updatePixel(DrawPoint(99, 69), newColor);
+    bmp.endUpdate();
+
+    // Tiles 0-2 of the first row form a single run, plus the corner tile
+    BOOST_TEST_REQUIRE(uploadedAreas.size() == 2u);
+    BOOST_TEST((uploadedAreas[0] == Rect(Position(0, 0), Extent(96, 32))));
+    BOOST_TEST((uploadedAreas[1] == Rect(Position(96, 64), Extent(4, 6))));
+
+    // Texture matches the full bitmap, i.e. what a full recreation would upload
+    unsigned numChangedPixels = 0;
+    for(unsigned y = 0; y < size.y; y++)
+    {
+        for(unsigned x = 0; x < size.x; x++)
+        {
+            BOOST_TEST_INFO("Position: " << x << "," << y);
+            BOOST_TEST_REQUIRE((texture.get(x, y) == bmp.getPixel(x, y)));
+            if(!(texture.get(x, y) == getTestColor(x, y)))
+                ++numChangedPixels;
+        }
+    }
+    BOOST_TEST(numChangedPixels == 5u);
+
+    // Following updates only upload their own tiles
+    uploadedAreas.clear();
+    bmp.beginUpdate();
+    bmp.updatePixel(DrawPoint(50, 40), getTestColor(50, 40));
+    bmp.endUpdate();
+    BOOST_TEST_REQUIRE(uploadedAreas.size() == 1u);
+    BOOST_TEST((uploadedAreas[0] == Rect(Position(32, 32), Extent(32, 32))));
+    BOOST_TEST((texture.get(50, 40) == getTestColor(50, 40)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
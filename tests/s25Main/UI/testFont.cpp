@@ -3,10 +3,78 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "Loader.h"
+#include "Point.h"
+#include "ogl/FontStyle.h"
 #include "ogl/glFont.h"
 #include "uiHelper/uiHelpers.hpp"
 #include "rttr/test/LogAccessor.hpp"
 #include <boost/test/unit_test.hpp>
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+
+namespace {
+using GlPoint = Point<GLfloat>;
+/// Vertices and texture coordinates passed to the last glDrawArrays call
+struct DrawnQuads
+{
+    std::vector<GlPoint> vertices, texCoords;
+};
+const GLvoid* curVertices = nullptr;
+const GLvoid* curTexCoords = nullptr;
+DrawnQuads lastDrawn;
+
+void APIENTRY captureVertexPointer(GLint, GLenum, GLsizei, const GLvoid* pointer)
+{
+    curVertices = pointer;
+}
+void APIENTRY captureTexCoordPointer(GLint, GLenum, GLsizei, const GLvoid* pointer)
+{
+    curTexCoords = pointer;
+}
+void APIENTRY captureDrawArrays(GLenum, GLint first, GLsizei count)
+{
+    const auto* vertices = static_cast<const GlPoint*>(curVertices) + first;
+    const auto* texCoords = static_cast<const GlPoint*>(curTexCoords) + first;
+    lastDrawn.vertices.assign(vertices, vertices + count);
+    lastDrawn.texCoords.assign(texCoords, texCoords + count);
+}
+
+/// Records what the fonts draw
+struct DrawCaptureFixture : uiHelper::Fixture
+{
+    PFNGLVERTEXPOINTERPROC origVertexPointer = glVertexPointer;
+    PFNGLTEXCOORDPOINTERPROC origTexCoordPointer = glTexCoordPointer;
+    PFNGLDRAWARRAYSPROC origDrawArrays = glDrawArrays;
+
+    DrawCaptureFixture()
+    {
+        glVertexPointer = captureVertexPointer;
+        glTexCoordPointer = captureTexCoordPointer;
+        glDrawArrays = captureDrawArrays;
+    }
+    ~DrawCaptureFixture()
+    {
+        glVertexPointer = origVertexPointer;
+        glTexCoordPointer = origTexCoordPointer;
+        glDrawArrays = origDrawArrays;
+    }
+
+    /// Draw the text and return the drawn quads
+    static DrawnQuads draw(const glFont& font, DrawPoint pos, const std::string& text, FontStyle format = {},
+                           unsigned short maxWidth = 0xFFFF, const std::string& end = "...")
+    {
+        lastDrawn = DrawnQuads();
+        font.Draw(pos, text, format, COLOR_WHITE, maxWidth, end);
+        return lastDrawn;
+    }
+};
+
+bool operator==(const DrawnQuads& lhs, const DrawnQuads& rhs)
+{
+    return lhs.vertices == rhs.vertices && lhs.texCoords == rhs.texCoords;
+}
+} // namespace
 
 BOOST_AUTO_TEST_SUITE(Font)
 
@@ -41,4 +109,58 @@ BOOST_FIXTURE_TEST_CASE(WrapInfoWithTrailingNewlines, uiHelper::Fixture)
     BOOST_TEST(wrapInfo.CreateSingleStrings(input) == output, boost::test_tools::per_element{});
 }
 
+BOOST_FIXTURE_TEST_CASE(CachedLayoutsMatchNewLayouts, DrawCaptureFixture)
+{
+    const auto& font = *SmallFont;
+    const DrawPoint origin(0, 0);
+    const std::string text = "Hello World";
+    const DrawnQuads firstDraw = draw(font, origin, text);
+    BOOST_TEST_REQUIRE(firstDraw.vertices.size() == text.size() * 4u);
+    BOOST_TEST(firstDraw.texCoords.size() == firstDraw.vertices.size());
+
+    // From the cache, also with a copy of the text
+    BOOST_TEST((draw(font, origin, text) == firstDraw));
+    BOOST_TEST((draw(font, origin, std::string(text)) == firstDraw));
+    // Suffix is irrelevant if the width is unlimited
+    BOOST_TEST((draw(font, origin, text, FontStyle{}, 0xFFFF, "~") == firstDraw));
+
+    // Cached layout is moved to the drawing position
+    const DrawPoint pos(13, 42);
+    const DrawnQuads movedDraw = draw(font, pos, text);
+    BOOST_TEST_REQUIRE(movedDraw.vertices.size() == firstDraw.vertices.size());
+    BOOST_TEST((movedDraw.texCoords == firstDraw.texCoords));
+    for(unsigned i = 0; i < movedDraw.vertices.size(); i++)
+        BOOST_TEST((movedDraw.vertices[i] == firstDraw.vertices[i] + GlPoint(pos)));
+
+    // Each part of the key results in a different layout
+    const DrawnQuads rightAligned = draw(font, origin, text, FontStyle::RIGHT);
+    BOOST_TEST_REQUIRE(rightAligned.vertices.size() == firstDraw.vertices.size());
+    BOOST_TEST(rightAligned.vertices.back().x == 0.f);
+    BOOST_TEST(rightAligned.vertices.front().x == -static_cast<GLfloat>(font.getWidth(text)));
+    const DrawnQuads noOutline = draw(font, origin, text, FontStyle::NO_OUTLINE);
+    BOOST_TEST((noOutline.vertices == firstDraw.vertices));
+
+    const unsigned short maxWidth = font.getWidth(text) / 2;
+    const DrawnQuads truncated = draw(font, origin, text, FontStyle{}, maxWidth);
+    BOOST_TEST(truncated.vertices.size() < firstDraw.vertices.size());
+    BOOST_TEST(truncated.vertices.back().x <= maxWidth);
+    const DrawnQuads truncatedOtherSuffix = draw(font, origin, text, FontStyle{}, maxWidth, "-");
+    BOOST_TEST_REQUIRE(!truncatedOtherSuffix.texCoords.empty());
+    BOOST_TEST((truncatedOtherSuffix.texCoords.back() != truncated.texCoords.back()));
+    BOOST_TEST((draw(font, origin, text, FontStyle{}, maxWidth) == truncated));
+
+    // Changed text is layouted again
+    std::string changedText = text;
+    changedText.back() = 'D';
+    const DrawnQuads changedDraw = draw(font, origin, changedText);
+    BOOST_TEST_REQUIRE(changedDraw.vertices.size() == firstDraw.vertices.size());
+    BOOST_TEST((changedDraw.texCoords != firstDraw.texCoords));
+
+    // Evict everything, the new layout is the same
+    for(unsigned i = 0; i < 1000; i++)
+        draw(font, origin, std::to_string(i));
+    BOOST_TEST((draw(font, origin, text) == firstDraw));
+    BOOST_TEST((draw(font, origin, text, FontStyle{}, maxWidth) == truncated));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
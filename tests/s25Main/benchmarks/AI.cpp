@@ -0,0 +1,81 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkGame.h"
+#include "EventManager.h"
+#include "ai/AIInterface.h"
+#include "ai/AIPlayer.h"
+#include "factories/AIFactory.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace {
+std::unique_ptr<Game> createGame(benchmark::State& state, const unsigned numAIs)
+{
+    std::vector<PlayerInfo> players = createPlayers(numAIs, PlayerState::AI);
+    for(PlayerInfo& player : players)
+        player.aiInfo = AI::Info(AI::Type::Default, AI::Level::Hard);
+    // Enough space for up to 3x3 AIs
+    return createBenchmarkGame(state, players, CreateEmptyWorld(MapExtent(96, 96)), [&players](Game& newGame) {
+        for(unsigned id = 0; id < players.size(); id++)
+            newGame.AddAIPlayer(AIFactory::Create(players[id].aiInfo, id, newGame.world_));
+        return true;
+    });
+}
+} // namespace
+
+/// Let AI players build up on an empty map. Emulates the network: GCs are executed in the next NWF
+static void BM_AIJH(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto numGFs = static_cast<unsigned>(state.range(0));
+    const auto numAIs = static_cast<unsigned>(state.range(1));
+    constexpr unsigned nwfLength = 5;
+    unsigned totalFreePathSearches = 0, totalRoadPathSearches = 0;
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        std::unique_ptr<Game> game = createGame(state, numAIs);
+        if(!game)
+            break;
+        state.ResumeTiming();
+
+        std::vector<std::vector<gc::GameCommandPtr>> pendingGCs(numAIs);
+        for(unsigned gf = 0; gf < numGFs; gf++)
+        {
+            game->em_->ExecuteNextGF();
+            const bool isNWF = gf % nwfLength == 0;
+            for(AIPlayer& ai : game->aiPlayers_)
+            {
+                if(isNWF)
+                {
+                    for(gc::GameCommandPtr& gc : pendingGCs[ai.GetPlayerId()])
+                        gc->Execute(game->world_, ai.GetPlayerId());
+                    pendingGCs[ai.GetPlayerId()] = ai.FetchGameCommands();
+                }
+                ai.RunGF(game->em_->GetCurrentGF(), isNWF);
+            }
+        }
+
+        state.PauseTiming();
+        for(AIPlayer& ai : game->aiPlayers_)
+        {
+            totalFreePathSearches += ai.getAIInterface().GetNumFreePathSearches();
+            totalRoadPathSearches += ai.getAIInterface().GetNumRoadPathSearches();
+        }
+        game.reset();
+        state.ResumeTiming();
+    }
+    const auto totalGFs = static_cast<double>(state.iterations() * numGFs);
+    state.counters["freePathSearches/GF"] = benchmark::Counter(totalFreePathSearches / totalGFs);
+    state.counters["roadPathSearches/GF"] = benchmark::Counter(totalRoadPathSearches / totalGFs);
+    state.counters["time/GF"] =
+      benchmark::Counter(numGFs, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.SetItemsProcessed(state.iterations() * numGFs);
+}
+BENCHMARK(BM_AIJH)->Args({2000, 2})->Args({5000, 2})->Args({5000, 7})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,89 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkGame.h"
+#include "RttrForeachPt.h"
+#include "ai/AIInterface.h"
+#include "ai/aijh/AIMap.h"
+#include "ai/aijh/AIResourceMap.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noTree.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+struct ResourceMapSetup
+{
+    std::unique_ptr<Game> game;
+    std::vector<gc::GameCommandPtr> gcs;
+    std::unique_ptr<AIInterface> aii;
+    AIJH::AIMap aiMap;
+    std::unique_ptr<AIJH::AIResourceMap> resMap;
+
+    /// Create a 512x512 map owned by the player with randomly placed trees
+    bool init(benchmark::State& state)
+    {
+        game = createBenchmarkGame(state, createPlayers(1), CreateEmptyWorld(MapExtent(512, 512)), [](Game& newGame) {
+            GameWorld& world = newGame.world_;
+            std::mt19937 rng(42);
+            RTTR_FOREACH_PT(MapPoint, world.GetSize())
+            {
+                world.SetOwner(pt, 1);
+                if(!world.GetNode(pt).obj && rng() % 8 == 0)
+                    world.SetNO(pt, new noTree(pt, 0, 3));
+            }
+            world.InitAfterLoad();
+            return true;
+        });
+        if(!game)
+            return false;
+        GameWorld& world = game->world_;
+
+        aii = std::make_unique<AIInterface>(world, gcs, 0);
+        aiMap.Resize(world.GetSize());
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            AIJH::Node& node = aiMap[pt];
+            node.bq = world.GetBQ(pt, 0);
+            node.owned = node.reachable = true;
+            node.farmed = false;
+        }
+        resMap = std::make_unique<AIJH::AIResourceMap>(AIResource::Wood, false, *aii, aiMap);
+        resMap->init();
+        const unsigned radius = RES_RADIUS[AIResource::Wood];
+        for(MapPoint pt(0, 0); pt.y < world.GetHeight(); pt.y += radius)
+        {
+            for(pt.x = 0; pt.x < world.GetWidth(); pt.x += radius)
+                resMap->updateAround(pt, radius);
+        }
+        return true;
+    }
+};
+} // namespace
+
+/// Search the best position for a woodcutter around random points
+static void BM_FindBestPosition(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    ResourceMapSetup setup;
+    if(!setup.init(state))
+        return;
+    const auto radius = static_cast<unsigned>(state.range(0));
+    std::mt19937 rng(1337);
+    std::vector<MapPoint> searchPts(1000);
+    for(MapPoint& pt : searchPts)
+        pt = MapPoint(rng() % 512, rng() % 512);
+
+    for(auto _ : state)
+    {
+        for(const MapPoint pt : searchPts)
+            benchmark::DoNotOptimize(setup.resMap->findBestPosition(pt, BuildingQuality::Hut, radius, 1));
+    }
+    state.SetItemsProcessed(state.iterations() * searchPts.size());
+}
+BENCHMARK(BM_FindBestPosition)->Arg(5)->Arg(15)->Arg(30)->Unit(benchmark::kMillisecond);
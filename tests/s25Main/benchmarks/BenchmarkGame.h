@@ -0,0 +1,43 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Game.h"
+#include "GlobalGameSettings.h"
+#include "PlayerInfo.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+/// Create the given number of players with the given state
+inline std::vector<PlayerInfo> createPlayers(unsigned numPlayers, PlayerState ps = PlayerState::Occupied)
+{
+    std::vector<PlayerInfo> players(numPlayers);
+    for(PlayerInfo& player : players)
+        player.ps = ps;
+    return players;
+}
+
+/// Create a game whose world is created by createWorld (e.g. CreateEmptyWorld) and then prepared by setupGame.
+/// Both return false on failure in which case the benchmark is marked as failed and nullptr is returned
+template<class T_CreateWorld, class T_SetupGame>
+std::unique_ptr<Game> createBenchmarkGame(benchmark::State& state, const std::vector<PlayerInfo>& players,
+                                          const T_CreateWorld& createWorld, T_SetupGame&& setupGame)
+{
+    auto game = std::make_unique<Game>(GlobalGameSettings(), 0, players);
+    if(!createWorld(game->world_) || !setupGame(*game))
+    {
+        state.SkipWithError("World creation failed");
+        return nullptr;
+    }
+    return game;
+}
+
+template<class T_CreateWorld>
+std::unique_ptr<Game> createBenchmarkGame(benchmark::State& state, const std::vector<PlayerInfo>& players,
+                                          const T_CreateWorld& createWorld)
+{
+    return createBenchmarkGame(state, players, createWorld, [](Game&) { return true; });
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Replay.h"
+#include "network/GameMessage_GameCommand.h"
+#include "network/PlayerGameCommands.h"
+#include "worldFixtures/ReplayHelpers.h"
+#include "gameTypes/MapInfo.h"
+#include "s25util/Serializer.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <test/testConfig.h>
+#include <vector>
+
+namespace {
+constexpr unsigned numPlayers = 8;
+
+/// Read all game commands of a recorded game
+std::vector<gc::GameCommandPtr> readGameCommands()
+{
+    std::vector<gc::GameCommandPtr> result;
+    Replay replay;
+    MapInfo mapInfo;
+    if(!replay.LoadHeader(rttr::test::rttrBaseDir / "tests" / "testData" / "200kGFs.rpl")
+       || !replay.LoadGameData(mapInfo))
+        return result;
+    readReplayCommands(replay, nullptr, [&result](unsigned, uint8_t, const PlayerGameCommands& cmds) {
+        result.insert(result.end(), cmds.gcs.begin(), cmds.gcs.end());
+    });
+    return result;
+}
+} // namespace
+
+/// Server side handling of the game command messages of one NWF with 8 players:
+/// Receive the message of each player and send it to all players (incl. the sender).
+/// Only the message handling is measured: Messages are passed as bytes instead of over sockets
+/// and there is no GameServer involved.
+/// forward=0: Decode and encode the commands (as before), forward=1: Forward the serialized commands
+/// cmds: Number of commands per player and NWF
+static void BM_ServerGameCommandsPerNWF(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const bool forward = state.range(0) != 0;
+    const auto cmdsPerPlayer = static_cast<unsigned>(state.range(1));
+    const std::vector<gc::GameCommandPtr> allGCs = readGameCommands();
+    if(allGCs.empty())
+    {
+        state.SkipWithError("Replay failed to load");
+        return;
+    }
+
+    // What the clients send
+    std::vector<Serializer> clientMsgs(numPlayers);
+    for(unsigned i = 0; i < numPlayers; i++)
+    {
+        std::vector<gc::GameCommandPtr> gcs;
+        for(unsigned j = 0; j < cmdsPerPlayer; j++)
+            gcs.push_back(allGCs[(i * cmdsPerPlayer + j) % allGCs.size()]);
+        GameMessage_GameCommand(0xFF, AsyncChecksum(), gcs).Serialize(clientMsgs[i]);
+    }
+
+    Serializer sendBuffer;
+    for(auto _ : state)
+    {
+        for(unsigned player = 0; player < numPlayers; player++)
+        {
+            const Serializer& clientMsg = clientMsgs[player];
+            Serializer recvBuffer(clientMsg.GetData(), clientMsg.GetLength());
+            GameMessage_GameCommand msg;
+            msg.Deserialize(recvBuffer);
+            const auto fwdMsg = forward ? std::make_unique<GameMessage_GameCommand>(player, msg) :
+                                          std::make_unique<GameMessage_GameCommand>(player, msg.checksum,
+                                                                                    msg.decodeGCs());
+            // Same as GameServer::SendToAll
+            for(unsigned receiver = 0; receiver < numPlayers; receiver++)
+            {
+                std::unique_ptr<Message> sentMsg(fwdMsg->clone());
+                sendBuffer.Clear();
+                sentMsg->Serialize(sendBuffer);
+            }
+        }
+        benchmark::DoNotOptimize(sendBuffer.GetLength());
+    }
+    state.SetItemsProcessed(state.iterations() * numPlayers * cmdsPerPlayer);
+}
+BENCHMARK(BM_ServerGameCommandsPerNWF)
+  ->ArgsProduct({{0, 1}, {1, 10, 50}})
+  ->ArgNames({"forward", "cmds"})
+  ->Unit(benchmark::kMicrosecond);
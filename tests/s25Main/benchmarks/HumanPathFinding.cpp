@@ -0,0 +1,47 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkGame.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "gameData/MilitaryConsts.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+/// Search paths as done for attackers and defenders.
+/// Arg 0: Goals on the other island (no path), Arg 1: Goals on the same island
+static void BM_HumanPathFinding(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const bool sameIsland = state.range(0) != 0;
+    state.SetLabel(sameIsland ? "same island" : "other island");
+    // 2 islands separated by water stripes at x in [30, 33] and [94, 97]
+    std::unique_ptr<Game> game =
+      createBenchmarkGame(state, createPlayers(1), CreateEmptyWorld(MapExtent(128, 64)),
+                          [](Game& newGame) { return setWaterStripes(newGame.world_, {{30, 33}, {94, 97}}); });
+    if(!game)
+        return;
+    const GameWorld& world = game->world_;
+    std::mt19937 rng(42);
+    std::vector<std::pair<MapPoint, MapPoint>> queries(100);
+    for(auto& query : queries)
+    {
+        // Start close to the water on the island in the middle
+        const auto y = static_cast<MapCoord>(rng() % 64);
+        query.first = MapPoint(static_cast<MapCoord>(36 + rng() % 10), y);
+        const auto goalX = static_cast<MapCoord>(sameIsland ? 50 + rng() % 10 : 18 + rng() % 10);
+        query.second = MapPoint(goalX, static_cast<MapCoord>((y + rng() % 10) % 64));
+    }
+
+    for(auto _ : state)
+    {
+        for(const auto& query : queries)
+            benchmark::DoNotOptimize(world.FindHumanPath(query.first, query.second, MAX_ATTACKING_RUN_DISTANCE));
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_HumanPathFinding)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
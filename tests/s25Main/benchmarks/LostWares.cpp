@@ -0,0 +1,137 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkGame.h"
+#include "GamePlayer.h"
+#include "Ware.h"
+#include "buildings/nobBaseWarehouse.h"
+#include "factories/BuildingFactory.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noFlag.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace {
+/// Create a world with a grid of flags connected by roads around the HQ and return all flags
+std::unique_ptr<Game> createGame(benchmark::State& state, std::vector<noFlag*>& flags)
+{
+    return createBenchmarkGame(state, createPlayers(1), CreateEmptyWorld(MapExtent(64, 64)), [&flags](Game& newGame) {
+        GameWorld& world = newGame.world_;
+        const MapPoint hqFlagPos = world.GetNeighbour(world.GetPlayer(0).GetHQPos(), Direction::SouthEast);
+        // Rows of flags below the HQ connected horizontally and in the middle of each row
+        const std::vector<Direction> down{Direction::SouthEast, Direction::SouthWest};
+        for(unsigned row = 0; row < 4; row++)
+        {
+            const MapPoint rowCenter(hqFlagPos.x, hqFlagPos.y + row * 2);
+            for(int offset = -4; offset <= 4; offset += 2)
+            {
+                const MapPoint pt(rowCenter.x + offset, rowCenter.y);
+                if(!world.GetSpecObj<noFlag>(pt))
+                    world.SetFlag(pt, 0);
+                if(offset > -4)
+                    world.BuildRoad(0, false, MapPoint(pt.x - 2, pt.y), {Direction::East, Direction::East});
+                flags.push_back(world.GetSpecObj<noFlag>(pt));
+                if(!flags.back())
+                    return false;
+            }
+            if(row > 0)
+                world.BuildRoad(0, false, MapPoint(rowCenter.x, rowCenter.y - 2), down);
+        }
+        return true;
+    });
+}
+} // namespace
+
+/// Order lost wares (e.g. after many warehouses were destroyed) till none is left
+static void BM_OrderLostWares(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    // At most 8 wares per flag
+    const auto numWares = static_cast<unsigned>(state.range(0));
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<noFlag*> flags;
+        auto game = createGame(state, flags);
+        if(!game)
+            break;
+        GamePlayer& player = game->world_.GetPlayer(0);
+        auto* hq = game->world_.GetSpecObj<nobBaseWarehouse>(player.GetHQPos());
+        for(unsigned i = 0; i < numWares; i++)
+        {
+            noFlag& flag = *flags[(i * 7) % flags.size()];
+            auto ware = std::make_unique<Ware>(GoodType::Gold, nullptr, &flag);
+            ware->WaitAtFlag(&flag);
+            flag.AddWare(std::move(ware));
+        }
+        state.ResumeTiming();
+
+        while(player.OrderWare(GoodType::Gold, hq)) {}
+
+        state.PauseTiming();
+        game.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * numWares);
+}
+BENCHMARK(BM_OrderLostWares)->Arg(40)->Arg(150)->Unit(benchmark::kMillisecond);
+
+/// Destroy many warehouses, one per GF, to which the wares at the flags are delivered, so those wares get lost.
+/// Then allow the HQ to take them again, which makes them look for a warehouse
+static void BM_DestroyWarehouses(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto numWares = static_cast<unsigned>(state.range(0));
+    unsigned numGFs = 0;
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<noFlag*> flags;
+        auto game = createGame(state, flags);
+        if(!game)
+            break;
+        GameWorld& world = game->world_;
+        auto* hq = world.GetSpecObj<nobBaseWarehouse>(world.GetPlayer(0).GetHQPos());
+        // Storehouses at all flags but those in the middle (HQ and roads between the rows)
+        std::vector<nobBaseWarehouse*> warehouses;
+        const MapPoint hqFlagPos = hq->GetFlagPos();
+        for(const noFlag* flag : flags)
+        {
+            if(flag->GetPos().x != hqFlagPos.x)
+            {
+                warehouses.push_back(static_cast<nobBaseWarehouse*>(BuildingFactory::CreateBuilding(
+                  world, BuildingType::Storehouse, world.GetNeighbour(flag->GetPos(), Direction::NorthWest), 0,
+                  Nation::Romans)));
+            }
+        }
+        // No warehouse left for the wares after all storehouses got destroyed
+        hq->SetInventorySetting(GoodType::Gold, EInventorySetting::Stop);
+        for(unsigned i = 0; i < numWares; i++)
+        {
+            noFlag& flag = *flags[(i * 7) % flags.size()];
+            auto ware = std::make_unique<Ware>(GoodType::Gold, warehouses[i % warehouses.size()], &flag);
+            ware->WaitAtFlag(&flag);
+            flag.AddWare(std::move(ware));
+        }
+        state.ResumeTiming();
+
+        for(const nobBaseWarehouse* wh : warehouses)
+        {
+            world.DestroyBuilding(wh->GetPos(), 0);
+            game->RunGF();
+        }
+        hq->SetInventorySetting(GoodType::Gold, InventorySetting());
+        game->RunGF();
+        numGFs += static_cast<unsigned>(warehouses.size()) + 1;
+
+        state.PauseTiming();
+        game.reset();
+        state.ResumeTiming();
+    }
+    state.counters["time/GF"] = benchmark::Counter(numGFs, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_DestroyWarehouses)->Arg(40)->Arg(150)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,76 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkGame.h"
+#include "RttrForeachPt.h"
+#include "buildings/nobBaseMilitary.h"
+#include "factories/BuildingFactory.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+/// Fill the map with military buildings of 2 players as in a late game
+bool addMilitaryBuildings(GameWorld& world)
+{
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        world.SetOwner(pt, pt.x < 128 ? 1 : 2);
+    world.InitAfterLoad();
+    for(MapPoint pt(0, 0); pt.y < world.GetHeight(); pt.y += 4)
+    {
+        for(pt.x = 0; pt.x < world.GetWidth(); pt.x += 6)
+        {
+            const auto owner = static_cast<unsigned char>(world.GetNode(pt).owner - 1);
+            if(world.GetBQ(pt, owner) == BuildingQuality::Castle)
+                BuildingFactory::CreateBuilding(world, BuildingType::Barracks, pt, owner, Nation::Romans);
+        }
+    }
+    return true;
+}
+} // namespace
+
+/// Query the military buildings around random points as done e.g. for visibility and attacks
+/// Arg 0: Sorted list of buildings, Arg 1: Visitor without allocations
+static void BM_LookForMilitaryBuildings(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const bool useVisitor = state.range(0) != 0;
+    state.SetLabel(useVisitor ? "visitor" : "sorted");
+    std::unique_ptr<Game> game =
+      createBenchmarkGame(state, createPlayers(2), CreateEmptyWorld(MapExtent(256, 256)),
+                          [](Game& newGame) { return addMilitaryBuildings(newGame.world_); });
+    if(!game)
+        return;
+    const GameWorld& world = game->world_;
+    std::mt19937 rng(42);
+    std::vector<MapPoint> queryPts(5000);
+    for(MapPoint& pt : queryPts)
+        pt = MapPoint(rng() % world.GetWidth(), rng() % world.GetHeight());
+
+    for(auto _ : state)
+    {
+        unsigned numFound = 0;
+        for(const MapPoint pt : queryPts)
+        {
+            if(useVisitor)
+            {
+                world.CheckMilitaryBuildings(pt, 3, [&numFound](const nobBaseMilitary* bld) {
+                    numFound += bld->GetPlayer() == 0;
+                    return false;
+                });
+            } else
+            {
+                for(const nobBaseMilitary* bld : world.LookForMilitaryBuildings(pt, 3))
+                    numFound += bld->GetPlayer() == 0;
+            }
+        }
+        benchmark::DoNotOptimize(numFound);
+    }
+    state.SetItemsProcessed(state.iterations() * queryPts.size());
+}
+BENCHMARK(BM_LookForMilitaryBuildings)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,80 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkGame.h"
+#include "IngameMinimap.h"
+#include "RttrForeachPt.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "nodeObjs/noTree.h"
+#include "world/GameWorld.h"
+#include "world/GameWorldViewer.h"
+#include "libsiedler2/PixelBufferBGRA.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace {
+class BenchmarkMinimap : public IngameMinimap
+{
+public:
+    using IngameMinimap::IngameMinimap;
+    void calcColors(libsiedler2::PixelBufferBGRA& buffer, unsigned numThreads) { CalcMapColors(buffer, numThreads); }
+};
+
+/// Create a 1024x1024 map with trees, visible for the first player
+std::unique_ptr<Game> createGame(benchmark::State& state)
+{
+    return createBenchmarkGame(state, createPlayers(2), CreateEmptyWorld(MapExtent(1024, 1024)), [](Game& newGame) {
+        GameWorld& world = newGame.world_;
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            if(pt.x % 3 == 0 && pt.y % 2 == 0 && !world.GetNode(pt).obj)
+                world.SetNO(pt, new noTree(pt, 0, 3));
+            world.SetVisibility(pt, 0, Visibility::Visible);
+        }
+        return true;
+    });
+}
+} // namespace
+
+/// Calculation of all minimap colors of a 1024x1024 map with 1 (serial) or the default number of threads
+static void BM_MinimapColors(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto game = createGame(state);
+    if(!game)
+        return;
+    const auto numThreads = static_cast<unsigned>(state.range(0));
+    state.SetLabel(numThreads == 1 ? "serial" : "parallel");
+    GameWorldViewer gwv(0, game->world_);
+    BenchmarkMinimap minimap(gwv);
+    libsiedler2::PixelBufferBGRA buffer(minimap.GetMapSize().x * 2, minimap.GetMapSize().y);
+
+    for(auto _ : state)
+    {
+        minimap.calcColors(buffer, numThreads);
+        benchmark::DoNotOptimize(buffer);
+    }
+    state.SetItemsProcessed(state.iterations() * minimap.GetMapSize().x * minimap.GetMapSize().y);
+}
+BENCHMARK(BM_MinimapColors)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond);
+
+/// Full update of the minimap, e.g. on ToggleTerritory
+static void BM_MinimapUpdateAll(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto game = createGame(state);
+    if(!game)
+        return;
+    GameWorldViewer gwv(0, game->world_);
+    BenchmarkMinimap minimap(gwv);
+
+    for(auto _ : state)
+    {
+        minimap.UpdateAll();
+        benchmark::DoNotOptimize(minimap);
+    }
+}
+BENCHMARK(BM_MinimapUpdateAll)->Unit(benchmark::kMillisecond);
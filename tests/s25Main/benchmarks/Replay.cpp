@@ -0,0 +1,179 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GamePlayer.h"
+#include "ObjectPool.h"
+#include "Replay.h"
+#include "network/PlayerGameCommands.h"
+#include "ogl/glAllocator.h"
+#include "random/Random.h"
+#include "world/GameWorld.h"
+#include "world/MapLoader.h"
+#include "worldFixtures/ReplayHelpers.h"
+#include "gameTypes/MapInfo.h"
+#include "libsiedler2/libsiedler2.h"
+#include "s25util/tmpFile.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <test/testConfig.h>
+
+namespace {
+std::atomic<size_t> numGlobalAllocs(0);
+} // namespace
+
+// Count all allocations using the global allocator to see the effect of pooling
+void* operator new(size_t size)
+{
+    ++numGlobalAllocs;
+    if(void* result = std::malloc(size ? size : 1))
+        return result;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+/// Load the replay and run the game up to numGFs or the end of the replay. Returns the number of GFs executed
+unsigned runReplay(benchmark::State& state, const boost::filesystem::path& replayPath, unsigned numGFs)
+{
+    state.PauseTiming();
+    Replay replay;
+    MapInfo mapInfo;
+    TmpFile mapfile;
+    mapfile.close();
+    if(!replay.LoadHeader(replayPath) || !replay.LoadGameData(mapInfo) || mapInfo.savegame
+       || !mapInfo.mapData.DecompressToFile(mapfile.filePath))
+    {
+        state.SkipWithError("Replay failed to load");
+        state.ResumeTiming();
+        return 0;
+    }
+
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < replay.GetNumPlayers(); i++)
+        players.emplace_back(replay.GetPlayer(i));
+    auto game = std::make_unique<Game>(replay.ggs, /*startGF*/ 0, players);
+    RANDOM.Init(replay.random_init);
+    GameWorld& gameWorld = game->world_;
+    for(unsigned i = 0; i < gameWorld.GetNumPlayers(); ++i)
+        gameWorld.GetPlayer(i).MakeStartPacts();
+
+    MapLoader loader(gameWorld);
+    unsigned nextGF;
+    if(!loader.Load(mapfile.filePath) || !replay.ReadGF(&nextGF))
+    {
+        state.SkipWithError("Map failed to load");
+        state.ResumeTiming();
+        return 0;
+    }
+    gameWorld.SetupResources();
+    gameWorld.InitAfterLoad();
+    state.ResumeTiming();
+
+    bool endOfReplay = false;
+    unsigned curGF = 0;
+    while(!endOfReplay && curGF < numGFs)
+    {
+        curGF = game->em_->GetCurrentGF();
+        while(nextGF == curGF)
+        {
+            const ReplayCommand rc = replay.ReadRCType();
+            if(rc == ReplayCommand::Chat)
+            {
+                uint8_t player, dest;
+                std::string message;
+                replay.ReadChatCommand(player, dest, message);
+            } else if(rc == ReplayCommand::Game)
+            {
+                PlayerGameCommands msg;
+                uint8_t gcPlayer;
+                replay.ReadGameCommand(gcPlayer, msg);
+                for(const gc::GameCommandPtr& gc : msg.gcs)
+                    gc->Execute(gameWorld, gcPlayer);
+            }
+            if(!replay.ReadGF(&nextGF))
+            {
+                endOfReplay = true;
+                break;
+            }
+        }
+        game->RunGF();
+    }
+    // Don't measure destruction of the world
+    state.PauseTiming();
+    game.reset();
+    state.ResumeTiming();
+    return curGF;
+}
+} // namespace
+
+/// Load a replay and read all commands without executing them.
+/// Arg 0: Old format compressed as a whole, Arg 1: Compressed in chunks
+static void BM_LoadReplay(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const bool chunked = state.range(0) != 0;
+    state.SetLabel(chunked ? "chunked" : "whole");
+    const boost::filesystem::path oldReplayPath = rttr::test::rttrBaseDir / "tests" / "testData" / "200kGFs.rpl";
+    TmpFile newReplayFile(".rpl");
+    newReplayFile.close();
+    boost::filesystem::remove(newReplayFile.filePath);
+    Replay newReplay;
+    if(chunked && !convertReplay(oldReplayPath, newReplay, newReplayFile.filePath))
+    {
+        state.SkipWithError("Replay conversion failed");
+        return;
+    }
+    const boost::filesystem::path& replayPath = chunked ? newReplayFile.filePath : oldReplayPath;
+
+    unsigned numCmds = 0;
+    for(auto _ : state)
+    {
+        Replay replay;
+        MapInfo mapInfo;
+        if(!replay.LoadHeader(replayPath) || !replay.LoadGameData(mapInfo))
+        {
+            state.SkipWithError("Replay failed to load");
+            break;
+        }
+        readReplayCommands(
+          replay, [&numCmds](unsigned, uint8_t, ChatDestination, const std::string&) { numCmds++; },
+          [&numCmds](unsigned, uint8_t, const PlayerGameCommands&) { numCmds++; });
+    }
+    state.SetItemsProcessed(numCmds);
+}
+BENCHMARK(BM_LoadReplay)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/// Run the first N GFs of a real game (7 AIs on "Big Slaughter v2") including all game logic
+static void BM_ReplayGFs(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    libsiedler2::setAllocator(new GlAllocator);
+    const boost::filesystem::path replayPath = rttr::test::rttrBaseDir / "tests" / "testData" / "200kGFs.rpl";
+    const auto numGFs = static_cast<unsigned>(state.range());
+    int64_t totalGFs = 0;
+    const size_t allocsBefore = numGlobalAllocs;
+    for(auto _ : state)
+        totalGFs += runReplay(state, replayPath, numGFs);
+    state.SetItemsProcessed(totalGFs);
+    // Includes the allocations during loading
+    state.counters["mallocs/GF"] =
+      benchmark::Counter(static_cast<double>(numGlobalAllocs - allocsBefore) / std::max<int64_t>(totalGFs, 1));
+    ObjectPool::printStats(std::cout);
+}
+BENCHMARK(BM_ReplayGFs)->Arg(5000)->Arg(10000)->Arg(20000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,157 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Game.h"
+#include "GlobalGameSettings.h"
+#include "ILocalGameState.h"
+#include "PlayerInfo.h"
+#include "RttrForeachPt.h"
+#include "Savegame.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noTree.h"
+#include "gameTypes/CompressedData.h"
+#include "s25util/BinaryFile.h"
+#include "s25util/tmpFile.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+std::atomic<size_t> curHeapBytes(0), peakHeapBytes(0);
+/// Each allocation stores its size in front of the returned memory
+constexpr size_t headerSize = alignof(std::max_align_t);
+} // namespace
+
+// Track the heap usage to get the peak memory usage while loading
+void* operator new(size_t size)
+{
+    auto* ptr = static_cast<char*>(std::malloc(size + headerSize));
+    if(!ptr)
+        throw std::bad_alloc();
+    *reinterpret_cast<size_t*>(ptr) = size;
+    const size_t newHeapBytes = curHeapBytes += size;
+    size_t peak = peakHeapBytes;
+    while(newHeapBytes > peak && !peakHeapBytes.compare_exchange_weak(peak, newHeapBytes)) {}
+    return ptr + headerSize;
+}
+void operator delete(void* ptr) noexcept
+{
+    if(!ptr)
+        return;
+    char* origPtr = static_cast<char*>(ptr) - headerSize;
+    curHeapBytes -= *reinterpret_cast<size_t*>(origPtr);
+    std::free(origPtr);
+}
+void operator delete(void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+namespace {
+struct DummyLocalGameState : ILocalGameState
+{
+    unsigned GetPlayerId() const override { return 0; }
+    bool IsHost() const override { return true; }
+    std::string FormatGFTime(unsigned) const override { return ""; }
+    void SystemChat(const std::string&) override {}
+};
+
+/// Save a big world with a forest on a third of the nodes
+bool createSavegame(const boost::filesystem::path& filePath, MapCoord size)
+{
+    std::vector<PlayerInfo> players(2);
+    for(PlayerInfo& player : players)
+        player.ps = PlayerState::Occupied;
+    Game game(GlobalGameSettings(), 0, players);
+    GameWorld& world = game.world_;
+    if(!CreateEmptyWorld(MapExtent(size, size))(world))
+        return false;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(!world.GetNode(pt).obj && (pt.x + pt.y) % 3 == 0)
+            world.SetNO(pt, new noTree(pt, 0, 3));
+    }
+    Savegame save;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        save.AddPlayer(world.GetPlayer(i));
+    save.ggs = game.ggs_;
+    save.sgd.MakeSnapshot(game);
+    return save.Save(filePath, "Benchmark");
+}
+
+/// Load as done before: Read all compressed data, decompress it as a whole and copy it to the game data
+bool loadWhole(const boost::filesystem::path& filePath, Savegame& save)
+{
+    BinaryFile file;
+    if(!file.Open(filePath, OFM_READ) || !save.Load(file, SaveGameDataToLoad::HeaderAndSettings))
+        return false;
+    if(file.ReadUnsignedInt() != 1u)
+        return false;
+    const auto uncompressedLength = file.ReadUnsignedInt();
+    std::vector<char> data(file.ReadUnsignedInt());
+    file.ReadRawData(data.data(), data.size());
+    data = CompressedData::decompress(data, uncompressedLength);
+    save.sgd.Clear();
+    save.sgd.PushRawData(data.data(), data.size());
+    return true;
+}
+} // namespace
+
+/// Load a savegame and deserialize the game from it.
+/// Arg 0: Map size, Arg 1: 0 = Decompress as a whole (old), 1 = Streaming decompression
+static void BM_LoadSavegame(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const auto mapSize = static_cast<MapCoord>(state.range(0));
+    const bool streaming = state.range(1) != 0;
+    TmpFile saveFile(".sav");
+    saveFile.close();
+    if(!createSavegame(saveFile.filePath, mapSize))
+    {
+        state.SkipWithError("Savegame creation failed");
+        return;
+    }
+
+    size_t maxPeakBytes = 0, gameDataBytes = 0;
+    for(auto _ : state)
+    {
+        const size_t heapBytesBefore = curHeapBytes;
+        peakHeapBytes = heapBytesBefore;
+        auto save = std::make_unique<Savegame>();
+        const bool loaded =
+          streaming ? save->Load(saveFile.filePath, SaveGameDataToLoad::All) : loadWhole(saveFile.filePath, *save);
+        if(!loaded)
+        {
+            state.SkipWithError("Savegame loading failed");
+            break;
+        }
+        gameDataBytes = save->sgd.GetLength();
+        std::vector<PlayerInfo> players;
+        for(unsigned i = 0; i < save->GetNumPlayers(); i++)
+            players.push_back(PlayerInfo(save->GetPlayer(i)));
+        auto game = std::make_unique<Game>(save->ggs, save->start_gf, players);
+        DummyLocalGameState localGameState;
+        save->sgd.ReadSnapshot(*game, localGameState);
+        maxPeakBytes = std::max<size_t>(maxPeakBytes, peakHeapBytes - heapBytesBefore);
+        // Don't measure destruction
+        state.PauseTiming();
+        game.reset();
+        save.reset();
+        state.ResumeTiming();
+    }
+    constexpr double bytesPerMB = 1024. * 1024.;
+    state.counters["peakHeapMB"] = benchmark::Counter(maxPeakBytes / bytesPerMB);
+    state.counters["gameDataMB"] = benchmark::Counter(gameDataBytes / bytesPerMB);
+}
+BENCHMARK(BM_LoadSavegame)
+  ->ArgsProduct({{256, 1024}, {0, 1}})
+  ->ArgNames({"size", "streaming"})
+  ->Unit(benchmark::kMillisecond);
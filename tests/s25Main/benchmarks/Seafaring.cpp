@@ -0,0 +1,71 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkGame.h"
+#include "GamePlayer.h"
+#include "buildings/nobHarborBuilding.h"
+#include "factories/BuildingFactory.h"
+#include "worldFixtures/CreateSeaWorld.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noFlag.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace {
+/// Create a water world with harbors at all harbor spots of the player
+std::unique_ptr<Game> createGame(benchmark::State& state, std::vector<nobHarborBuilding*>& harbors)
+{
+    return createBenchmarkGame(state, createPlayers(1), CreateWaterWorld(MapExtent(64, 64)), [&harbors](Game& newGame) {
+        GameWorld& world = newGame.world_;
+        for(unsigned hbPosId = 1; hbPosId <= world.GetNumHarborPoints(); hbPosId++)
+        {
+            harbors.push_back(static_cast<nobHarborBuilding*>(BuildingFactory::CreateBuilding(
+              world, BuildingType::HarborBuilding, world.GetHarborPoint(hbPosId), 0, Nation::Romans)));
+        }
+        return harbors.size() >= 2u;
+    });
+}
+} // namespace
+
+/// Route wares between all harbors which requires expanding the ship connections.
+/// Arg 0: Ship connections cached, Arg 1: Recalculated for every search (as without the cache)
+/// Reports how often the ship connections of a harbor got calculated per search
+static void BM_WarePathsOverSea(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const bool recalcConnections = state.range(0) != 0;
+    state.SetLabel(recalcConnections ? "uncached" : "cached");
+    std::vector<nobHarborBuilding*> harbors;
+    std::unique_ptr<Game> game = createGame(state, harbors);
+    if(!game)
+        return;
+    GameWorld& world = game->world_;
+    GamePlayer& player = world.GetPlayer(0);
+
+    unsigned numSearches = 0;
+    for(auto _ : state)
+    {
+        for(const nobHarborBuilding* start : harbors)
+        {
+            for(const nobHarborBuilding* goal : harbors)
+            {
+                if(start == goal)
+                    continue;
+                if(recalcConnections)
+                    player.InvalidateShipConnections();
+                benchmark::DoNotOptimize(world.FindPathForWareOnRoads(*start->GetFlag(), *goal));
+                numSearches++;
+            }
+        }
+    }
+    state.SetItemsProcessed(numSearches);
+    unsigned numCalcs = 0;
+    for(const nobHarborBuilding* harbor : harbors)
+        numCalcs += harbor->GetNumShipConnectionCalcs();
+    state.counters["shipConnectionCalcs/search"] =
+      benchmark::Counter(numSearches ? static_cast<double>(numCalcs) / numSearches : 0.);
+}
+BENCHMARK(BM_WarePathsOverSea)->Arg(0)->Arg(1);
@@ -0,0 +1,133 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Loader.h"
+#include "WindowManager.h"
+#include "drivers/VideoDriverWrapper.h"
+#include "ogl/FontStyle.h"
+#include "ogl/glAllocator.h"
+#include "ogl/glFont.h"
+#include "libsiedler2/libsiedler2.h"
+#include <mockupDrivers/MockupVideoDriver.h>
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+/// Same charset as the text test in dskBenchmark
+const std::string asciiCharset =
+  "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789!@#$%^&*()`~-_=+[{]{\\|;:'\",<.>/? ";
+/// Mixed latin, umlauts and cyrillic chars (UTF-8 encoded, 1 char each)
+const std::array<std::string, 12> utf8Charset = {
+  {"a", "Z", " ", "\xC3\xA4", "\xC3\xB6", "\xC3\x9F", "\xD0\x96", "\xD0\xB4", "\xD1\x8F", "\xE2\x82\xAC", "?", "9"}};
+
+std::vector<std::string> createTexts(bool useUTF8, unsigned numTexts = 1000)
+{
+    std::mt19937 rng(0x1337);
+    std::uniform_int_distribution<unsigned> distrLen(1, 30);
+    std::uniform_int_distribution<size_t> distrAscii(0, asciiCharset.size() - 1);
+    std::uniform_int_distribution<size_t> distrUTF8(0, utf8Charset.size() - 1);
+    std::vector<std::string> result(numTexts);
+    for(std::string& txt : result)
+    {
+        const unsigned len = distrLen(rng);
+        for(unsigned i = 0; i < len; i++)
+        {
+            if(useUTF8)
+                txt += utf8Charset[distrUTF8(rng)];
+            else
+                txt += asciiCharset[distrAscii(rng)];
+        }
+    }
+    return result;
+}
+
+const glFont* loadFont()
+{
+    libsiedler2::setAllocator(new GlAllocator);
+    LOADER.LoadDummyGUIFiles();
+    LOADER.initResourceFolders();
+    if(!LOADER.LoadFonts())
+        return nullptr;
+    return NormalFont;
+}
+
+/// Drawing requires a (dummy) OpenGL context
+bool initVideoDriver()
+{
+    if(VIDEODRIVER.GetDriver())
+        return true;
+    return VIDEODRIVER.LoadDriver(new MockupVideoDriver(&WINDOWMANAGER))
+           && VIDEODRIVER.CreateScreen(VideoMode(800, 600), false);
+}
+} // namespace
+
+static void BM_TextWidth(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const glFont* font = loadFont();
+    if(!font)
+    {
+        state.SkipWithError("Fonts failed to load");
+        return;
+    }
+    const auto texts = createTexts(state.range(0) != 0);
+    state.SetLabel(state.range(0) ? "UTF-8" : "ASCII");
+
+    for(auto _ : state)
+    {
+        for(const std::string& txt : texts)
+            benchmark::DoNotOptimize(font->getWidth(txt));
+    }
+    state.SetItemsProcessed(state.iterations() * texts.size());
+}
+BENCHMARK(BM_TextWidth)->Arg(0)->Arg(1);
+
+static void BM_TextWrapInfo(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const glFont* font = loadFont();
+    if(!font)
+    {
+        state.SkipWithError("Fonts failed to load");
+        return;
+    }
+    const auto texts = createTexts(state.range(0) != 0);
+    state.SetLabel(state.range(0) ? "UTF-8" : "ASCII");
+    const auto lineWidth = static_cast<unsigned short>(font->getDx() * 10);
+
+    for(auto _ : state)
+    {
+        for(const std::string& txt : texts)
+            benchmark::DoNotOptimize(font->GetWrapInfo(txt, lineWidth, lineWidth));
+    }
+    state.SetItemsProcessed(state.iterations() * texts.size());
+}
+BENCHMARK(BM_TextWrapInfo)->Arg(0)->Arg(1);
+
+/// Arg 0: Same texts each frame (layouts come from the cache), Arg 1: More texts than fit into the cache
+static void BM_TextDraw(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    const glFont* font = initVideoDriver() ? loadFont() : nullptr;
+    if(!font)
+    {
+        state.SkipWithError("Video driver or fonts failed to load");
+        return;
+    }
+    const bool uncached = state.range(0) != 0;
+    const auto texts = createTexts(true, uncached ? 1000 : 100);
+    state.SetLabel(uncached ? "uncached" : "cached");
+
+    for(auto _ : state)
+    {
+        for(const std::string& txt : texts)
+            font->Draw(DrawPoint(10, 10), txt, FontStyle::CENTER, COLOR_WHITE, 200);
+    }
+    state.SetItemsProcessed(state.iterations() * texts.size());
+}
+BENCHMARK(BM_TextDraw)->Arg(0)->Arg(1);
@@ -0,0 +1,94 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BenchmarkGame.h"
+#include "RttrForeachPt.h"
+#include "Ware.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noFlag.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr unsigned gridSize = 20;
+
+/// Create a grid of gridSize x gridSize flags connected by roads with some wares lying at the flags
+bool setupGrid(GameWorld& world, std::vector<noFlag*>& flags)
+{
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        world.SetOwner(pt, 1);
+    world.InitAfterLoad();
+
+    const std::vector<Direction> down{Direction::SouthEast, Direction::SouthWest};
+    for(unsigned y = 0; y < gridSize; y++)
+    {
+        for(unsigned x = 0; x < gridSize; x++)
+        {
+            const MapPoint pt(4 + x * 2, 4 + y * 2);
+            world.SetFlag(pt, 0);
+            if(x > 0)
+                world.BuildRoad(0, false, MapPoint(pt.x - 2, pt.y), {Direction::East, Direction::East});
+            if(y > 0)
+                world.BuildRoad(0, false, MapPoint(pt.x, pt.y - 2), down);
+            flags.push_back(world.GetSpecObj<noFlag>(pt));
+            if(!flags.back())
+                return false;
+        }
+    }
+
+    // Wares waiting for the roads make the punishment points differ
+    std::mt19937 rng(42);
+    for(noFlag* flag : flags)
+    {
+        const unsigned numWares = rng() % 4;
+        for(unsigned i = 0; i < numWares; i++)
+        {
+            const auto dir = Direction(rng() % helpers::NumEnumValues_v<Direction>);
+            if(!flag->GetRoute(dir) || dir == Direction::NorthWest)
+                continue;
+            auto ware = std::make_unique<Ware>(GoodType::Boards, nullptr, flag);
+            ware->WaitAtFlag(flag);
+            ware->SetNextDir(dir);
+            flag->AddWare(std::move(ware));
+        }
+    }
+    return true;
+}
+} // namespace
+
+/// Search ware paths between flags at opposite sides of the grid, i.e. relax nearly all edges of the road network
+static void BM_WarePathFinding(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    std::vector<noFlag*> flags;
+    std::unique_ptr<Game> game =
+      createBenchmarkGame(state, createPlayers(1), CreateEmptyWorld(MapExtent(96, 96)),
+                          [&flags](Game& newGame) { return setupGrid(newGame.world_, flags); });
+    if(!game)
+        return;
+    const GameWorld& world = game->world_;
+    // Each flag has up to 4 roads, each counted from both sides
+    const unsigned numEdges = 2 * 2 * gridSize * (gridSize - 1);
+
+    unsigned numSearches = 0;
+    for(auto _ : state)
+    {
+        for(unsigned i = 0; i < gridSize; i++)
+        {
+            const noFlag& start = *flags[i];
+            const noFlag& goal = *flags[flags.size() - 1 - i];
+            unsigned length;
+            benchmark::DoNotOptimize(world.FindPathForWareOnRoads(start, goal, &length));
+            numSearches++;
+        }
+    }
+    state.SetItemsProcessed(numSearches);
+    state.counters["edges"] =
+      benchmark::Counter(static_cast<double>(numSearches) * numEdges, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_WarePathFinding)->Unit(benchmark::kMicrosecond);
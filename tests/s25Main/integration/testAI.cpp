@@ -4,8 +4,11 @@
 
 #include "PointOutput.h"
 #include "RttrForeachPt.h"
+#include "ai/AIInterface.h"
 #include "ai/AIPlayer.h"
 #include "ai/aijh/AIPlayerJH.h"
+#include "ai/aijh/AIResourceMap.h"
+#include "ai/aijh/PositionSearch.h"
 #include "buildings/noBuilding.h"
 #include "buildings/noBuildingSite.h"
 #include "buildings/nobBaseWarehouse.h"
@@ -16,11 +19,14 @@
 #include "notifications/NodeNote.h"
 #include "worldFixtures/WorldWithGCExecution.h"
 #include "nodeObjs/noFlag.h"
+#include "nodeObjs/noGranite.h"
 #include "nodeObjs/noTree.h"
 #include "gameTypes/GameTypesOutput.h"
+#include "gameData/BuildingConsts.h"
 #include "gameData/BuildingProperties.h"
 #include "rttr/test/random.hpp"
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <memory>
 #include <set>
 
@@ -29,6 +35,7 @@ namespace {
 using BiggerWorldWithGCExecution = WorldWithGCExecution<1, 24, 22>;
 using EmptyWorldFixture1P = WorldFixture<CreateEmptyWorld, 1>;
 using EmptyWorldFixture2P = WorldFixture<CreateEmptyWorld, 2>;
+using EmptyWorldFixture1PBig = WorldFixture<CreateEmptyWorld, 1, 32, 32>;
 
 template<class T_Col>
 inline bool containsBldType(const T_Col& collection, BuildingType type)
@@ -128,6 +135,7 @@ BOOST_FIXTURE_TEST_CASE(KeepBQUpdated, BiggerWorldWithGCExecution)
         {
             BOOST_TEST_INFO(pt);
             BOOST_TEST_REQUIRE(this->world.GetBQ(pt, curPlayer) == aijh.GetAINode(pt).bq);
+            BOOST_TEST_REQUIRE((this->world.GetNode(pt).owner == curPlayer + 1) == aijh.GetAINode(pt).owned);
         }
     };
     const auto assertBqEqualAround = [this, &aijh](const unsigned lineNr, MapPoint pt, unsigned radius) {
@@ -137,6 +145,7 @@ BOOST_FIXTURE_TEST_CASE(KeepBQUpdated, BiggerWorldWithGCExecution)
           [&](const MapPoint curPt, unsigned) {
               BOOST_TEST_INFO(curPt);
               BOOST_TEST_REQUIRE(this->world.GetBQ(curPt, curPlayer) == aijh.GetAINode(curPt).bq);
+              BOOST_TEST_REQUIRE((this->world.GetNode(curPt).owner == curPlayer + 1) == aijh.GetAINode(curPt).owned);
               return false;
           },
           true);
@@ -264,6 +273,113 @@ BOOST_FIXTURE_TEST_CASE(KeepBQUpdated, BiggerWorldWithGCExecution)
     assertBqEqualOnWholeMap(__LINE__);
 }
 
+BOOST_FIXTURE_TEST_CASE(KeepReachabilityUpdated, BiggerWorldWithGCExecution)
+{
+    auto ai = AIFactory::Create(AI::Info(AI::Type::Default, AI::Level::Hard), curPlayer, world);
+    AIJH::AIPlayerJH& aijh = static_cast<AIJH::AIPlayerJH&>(*ai);
+
+    // The updated state must match the one of a newly created AI
+    const auto assertReachableEqualOnWholeMap = [this, &aijh](const unsigned lineNr) {
+        const auto newAi = AIFactory::Create(AI::Info(AI::Type::Default, AI::Level::Hard), curPlayer, world);
+        const AIJH::AIPlayerJH& newAijh = static_cast<AIJH::AIPlayerJH&>(*newAi);
+        BOOST_TEST_CONTEXT("Line #" << lineNr)
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            BOOST_TEST_INFO(pt);
+            BOOST_TEST_REQUIRE(aijh.GetAINode(pt).reachable == newAijh.GetAINode(pt).reachable);
+        }
+    };
+
+    // Enclose an area in our territory with granite
+    const MapPoint center = world.MakeMapPoint(hqPos + Position(5, 0));
+    std::vector<MapPoint> enclosedPts, wallPts;
+    world.CheckPointsInRadius(
+      center, 2,
+      [&](const MapPoint pt, unsigned distance) {
+          (distance < 2 ? enclosedPts : wallPts).push_back(pt);
+          return false;
+      },
+      true);
+    for(const MapPoint pt : enclosedPts)
+    {
+        BOOST_TEST_REQUIRE(world.GetNode(pt).owner == curPlayer + 1);
+        BOOST_TEST_REQUIRE(aijh.GetAINode(pt).reachable);
+    }
+    for(const MapPoint pt : wallPts)
+    {
+        world.SetNO(pt, new noGranite(GraniteType::One, 5));
+        world.RecalcBQAroundPointBig(pt);
+    }
+    aijh.UpdateOutdatedNodes();
+    for(const MapPoint pt : enclosedPts)
+    {
+        BOOST_TEST_INFO(pt);
+        BOOST_TEST(!aijh.GetAINode(pt).reachable);
+    }
+    assertReachableEqualOnWholeMap(__LINE__);
+
+    // Open the wall again
+    const MapPoint gapPt = wallPts.front();
+    world.DestroyNO(gapPt);
+    world.RecalcBQAroundPointBig(gapPt);
+    aijh.UpdateOutdatedNodes();
+    for(const MapPoint pt : enclosedPts)
+    {
+        BOOST_TEST_INFO(pt);
+        BOOST_TEST(aijh.GetAINode(pt).reachable);
+    }
+    assertReachableEqualOnWholeMap(__LINE__);
+
+    // Roads block nodes too and their flags make nodes reachable
+    const MapPoint roadStart = world.GetNeighbour(hqPos, Direction::SouthEast);
+    this->BuildRoad(roadStart, false, std::vector<Direction>(4, Direction::SouthWest));
+    aijh.UpdateOutdatedNodes();
+    assertReachableEqualOnWholeMap(__LINE__);
+    MapPoint roadEnd = roadStart;
+    for(unsigned i = 0; i < 4; i++)
+        roadEnd = world.GetNeighbour(roadEnd, Direction::SouthWest);
+    BOOST_TEST_REQUIRE(world.GetSpecObj<noFlag>(roadEnd));
+    this->DestroyFlag(roadEnd);
+    aijh.UpdateOutdatedNodes();
+    assertReachableEqualOnWholeMap(__LINE__);
+}
+
+BOOST_FIXTURE_TEST_CASE(PositionSearchTestsWholeTerritory, WorldWithGCExecution<1>)
+{
+    // Place some trees away from the HQ
+    for(const MapPoint& pt : world.GetPointsInRadius(hqPos + MapPoint(5, 0), 1))
+    {
+        if(!world.GetNode(pt).obj)
+            world.SetNO(pt, new noTree(pt, 0, 3));
+    }
+    world.InitAfterLoad();
+
+    auto ai = AIFactory::Create(AI::Info(AI::Type::Default, AI::Level::Hard), curPlayer, world);
+    const AIJH::AIPlayerJH& aijh = static_cast<AIJH::AIPlayerJH&>(*ai);
+    const AIJH::AIResourceMap& resMap = aijh.GetResMap(AIResource::Wood);
+    const BuildingQuality size = BUILDING_SIZE[BuildingType::Woodcutter];
+
+    unsigned numOwnedNodes = 0;
+    int bestValue = 0;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        const AIJH::Node& node = aijh.GetAINode(pt);
+        if(!node.owned)
+            continue;
+        numOwnedNodes++;
+        if(node.reachable && !node.farmed && canUseBq(node.bq, size))
+            bestValue = std::max(bestValue, resMap[pt]);
+    }
+    BOOST_TEST_REQUIRE(bestValue > 0);
+
+    AIJH::PositionSearch search(aijh, hqPos, AIResource::Wood, 1, BuildingType::Woodcutter, true);
+    BOOST_TEST_REQUIRE((search.execute(aijh, numOwnedNodes + 1) == AIJH::PositionSearchState::Successfull));
+    // All nodes of the territory are tested once and the best one is found
+    BOOST_TEST(search.GetNumTestedNodes() == numOwnedNodes);
+    BOOST_TEST_REQUIRE(search.GetResultPt().isValid());
+    BOOST_TEST(resMap[search.GetResultPt()] == bestValue);
+}
+
 BOOST_FIXTURE_TEST_CASE(BuildWoodIndustry, WorldWithGCExecution<1>)
 {
     // Place a few trees
@@ -298,6 +414,47 @@ BOOST_FIXTURE_TEST_CASE(BuildWoodIndustry, WorldWithGCExecution<1>)
     BOOST_TEST_REQUIRE(playerHasBld(player, BuildingType::Forester));
 }
 
+BOOST_FIXTURE_TEST_CASE(WorkStaysWithinBudget, WorldWithGCExecution<1>)
+{
+    // Place a few trees so the AI has something to do
+    for(const MapPoint& pt : world.GetPointsInRadius(hqPos + MapPoint(4, 0), 2))
+    {
+        if(!world.GetNode(pt).obj)
+            world.SetNO(pt, new noTree(pt, 0, 3));
+    }
+    world.InitAfterLoad();
+
+    auto ai = AIFactory::Create(AI::Info(AI::Type::Default, AI::Level::Hard), curPlayer, world);
+    const AIJH::AIWorkBudget& budget = static_cast<AIJH::AIPlayerJH&>(*ai).GetWorkBudget();
+    BOOST_TEST_REQUIRE(budget.GetBudgetPerGF() == AIJH::WORK_BUDGET_PER_GF);
+    unsigned totalWork = 0, maxWork = 0;
+    for(unsigned gf = 0; gf < 1000;)
+    {
+        std::vector<gc::GameCommandPtr> aiGcs = ai->FetchGameCommands();
+        for(unsigned i = 0; i < 5; i++, gf++)
+        {
+            em.ExecuteNextGF();
+            ai->RunGF(em.GetCurrentGF(), i == 0);
+            // At most the budget of this GF plus the saved up one is available
+            BOOST_TEST_REQUIRE(budget.GetBudgetAtGFStart() <= AIJH::MAX_WORK_BUDGET);
+            // Only the events handled in every GF may be started without budget
+            BOOST_TEST_REQUIRE(budget.GetNumJobsWithoutBudget() <= AIJH::MIN_EVENTS_PER_GF);
+            // Jobs are only started with budget left, so only the last of them can exceed it
+            BOOST_TEST_REQUIRE(budget.GetWorkInCurrentGF()
+                               <= budget.GetBudgetAtGFStart() + budget.GetMaxJobWork() + budget.GetWorkWithoutBudget());
+            totalWork += budget.GetWorkInCurrentGF();
+            maxWork = std::max(maxWork, budget.GetWorkInCurrentGF());
+        }
+        for(gc::GameCommandPtr& gc : aiGcs)
+        {
+            gc->Execute(world, curPlayer);
+        }
+    }
+    // Work got done but spread over the GFs
+    BOOST_TEST(totalWork > 0u);
+    BOOST_TEST(maxWork < totalWork);
+}
+
 BOOST_FIXTURE_TEST_CASE(ExpandWhenNoSpace, BiggerWorldWithGCExecution)
 {
     const GamePlayer& player = world.GetPlayer(curPlayer);
@@ -333,4 +490,70 @@ BOOST_FIXTURE_TEST_CASE(ExpandWhenNoSpace, BiggerWorldWithGCExecution)
       (containsBldType(bldSites, BuildingType::Barracks) || containsBldType(bldSites, BuildingType::Guardhouse)));
 }
 
+BOOST_FIXTURE_TEST_CASE(ResourceMapFindBestPosition, EmptyWorldFixture1PBig)
+{
+    const MapPoint hqPos = world.GetPlayer(0).GetHQPos();
+    // Trees give different but often equal values
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(!world.GetNode(pt).obj && world.CalcDistance(pt, hqPos) > 2 && rttr::test::randomValue(0, 3) == 0)
+            world.SetNO(pt, new noTree(pt, 0, 3));
+    }
+    world.InitAfterLoad();
+
+    std::vector<gc::GameCommandPtr> gcs;
+    AIInterface aii(world, gcs, 0);
+    AIJH::AIMap aiMap;
+    aiMap.Resize(world.GetSize());
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        AIJH::Node& node = aiMap[pt];
+        node.bq = world.GetBQ(pt, 0);
+        node.owned = world.GetNode(pt).owner == 1;
+        node.reachable = rttr::test::randomValue(0, 9) != 0;
+        node.farmed = rttr::test::randomValue(0, 9) == 0;
+    }
+    AIJH::AIResourceMap resMap(AIResource::Wood, false, aii, aiMap);
+    resMap.init();
+    for(MapPoint pt(0, 0); pt.y < world.GetHeight(); pt.y += 3)
+    {
+        for(pt.x = 0; pt.x < world.GetWidth(); pt.x += 3)
+            resMap.updateAround(pt, RES_RADIUS[AIResource::Wood]);
+    }
+    resMap.avoidPosition(world.MakeMapPoint(hqPos + Position(3, 1)));
+
+    // First position with the best value when searching around the point
+    const auto findBestPositionRef = [&](const MapPoint pt, BuildingQuality size, unsigned radius, int minimum) {
+        MapPoint best = MapPoint::Invalid();
+        int bestValue = minimum - 1;
+        for(const MapPoint curPt : world.GetPointsInRadiusWithCenter(pt, radius))
+        {
+            const AIJH::Node& node = aiMap[curPt];
+            if(resMap[curPt] > bestValue && node.reachable && node.owned && !node.farmed
+               && canUseBq(world.GetBQ(curPt, 0), size))
+            {
+                best = curPt;
+                bestValue = resMap[curPt];
+            }
+        }
+        return best;
+    };
+    // Radius 16 wraps around the map
+    for(const unsigned radius : {0u, 1u, 4u, 9u, 15u, 16u})
+    {
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            for(const BuildingQuality size : {BuildingQuality::Flag, BuildingQuality::Hut, BuildingQuality::Castle})
+            {
+                for(const int minimum : {1, 20})
+                {
+                    BOOST_TEST_INFO("Pt: " << pt << " Radius: " << radius << " Minimum: " << minimum);
+                    BOOST_TEST(resMap.findBestPosition(pt, size, radius, minimum)
+                               == findBestPositionRef(pt, size, radius, minimum));
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
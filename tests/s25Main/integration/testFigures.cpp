@@ -12,6 +12,7 @@
 #include "figures/nofScout_Free.h"
 #include "notifications/ResourceNote.h"
 #include "worldFixtures/WorldWithGCExecution.h"
+#include "nodeObjs/noAnimal.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noSign.h"
 #include "gameTypes/GameTypesOutput.h"
@@ -146,4 +147,39 @@ BOOST_FIXTURE_TEST_CASE(GeologistPlacesSigns, EmptyWorldFixture1P)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(FiguresOnNodeKeepOrder, EmptyWorldFixture1P)
+{
+    const MapPoint pt(5, 5);
+    const MapPoint otherPt = world.GetNeighbour(pt, Direction::East);
+    BOOST_TEST_REQUIRE(world.GetFigures(pt).empty());
+    std::vector<noBase*> expected;
+    const auto getFigures = [this](MapPoint curPt) {
+        std::vector<noBase*> result;
+        for(noBase& fig : world.GetFigures(curPt))
+            result.push_back(&fig);
+        return result;
+    };
+    for(const Species species : {Species::Deer, Species::Fox, Species::RabbitWhite, Species::Sheep})
+        expected.push_back(&world.AddFigure(pt, std::make_unique<noAnimal>(species, pt)));
+    BOOST_TEST(getFigures(pt) == expected, boost::test_tools::per_element());
+    BOOST_TEST(world.GetFigures(pt).size() == 4u);
+    BOOST_TEST(&world.GetFigures(pt).front() == expected.front());
+    BOOST_TEST(&world.GetFigures(pt).back() == expected.back());
+
+    // Removing keeps the order of the others, adding appends
+    auto& animal = static_cast<noAnimal&>(*expected[1]);
+    BOOST_TEST(world.HasFigureAt(pt, animal));
+    auto ownedAnimal = world.RemoveFigure(pt, animal);
+    BOOST_TEST(ownedAnimal.get() == &animal);
+    BOOST_TEST(!world.HasFigureAt(pt, animal));
+    expected.erase(expected.begin() + 1);
+    BOOST_TEST(getFigures(pt) == expected, boost::test_tools::per_element());
+    world.AddFigure(otherPt, std::move(ownedAnimal));
+    BOOST_TEST(world.HasFigureAt(otherPt, animal));
+    world.AddFigure(pt, world.RemoveFigure(otherPt, animal));
+    expected.push_back(&animal);
+    BOOST_TEST(getFigures(pt) == expected, boost::test_tools::per_element());
+    BOOST_TEST(world.GetFigures(otherPt).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
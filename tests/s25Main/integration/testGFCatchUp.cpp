@@ -0,0 +1,157 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AsyncChecksum.h"
+#include "EventManager.h"
+#include "FramesInfo.h"
+#include "GFTimeBudget.h"
+#include "Game.h"
+#include "GamePlayer.h"
+#include "PlayerInfo.h"
+#include "Replay.h"
+#include "network/PlayerGameCommands.h"
+#include "random/Random.h"
+#include "world/GameWorld.h"
+#include "world/MapLoader.h"
+#include "gameTypes/MapInfo.h"
+#include "test/testConfig.h"
+#include "s25util/tmpFile.h"
+#include <rttr/test/MockClock.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using std::chrono::milliseconds;
+
+namespace {
+/// Number of GFs of the replay to run. Enough for the AIs to send lots of commands
+constexpr unsigned numGFs = 2000;
+
+/// Game started from a replay which executes the recorded commands and checks the recorded checksums
+class ReplayGame
+{
+public:
+    explicit ReplayGame(const boost::filesystem::path& replayPath)
+    {
+        BOOST_TEST_REQUIRE(replay.LoadHeader(replayPath));
+        MapInfo mapInfo;
+        BOOST_TEST_REQUIRE(replay.LoadGameData(mapInfo));
+        BOOST_TEST_REQUIRE(!mapInfo.savegame);
+        TmpFile mapFile;
+        mapFile.close();
+        BOOST_TEST_REQUIRE(mapInfo.mapData.DecompressToFile(mapFile.filePath));
+
+        std::vector<PlayerInfo> players;
+        for(unsigned i = 0; i < replay.GetNumPlayers(); i++)
+            players.emplace_back(replay.GetPlayer(i));
+        game = std::make_unique<Game>(replay.ggs, /*startGF*/ 0, players);
+        RANDOM.Init(replay.random_init);
+        GameWorld& gameWorld = game->world_;
+        for(unsigned i = 0; i < gameWorld.GetNumPlayers(); ++i)
+            gameWorld.GetPlayer(i).MakeStartPacts();
+        MapLoader loader(gameWorld);
+        BOOST_TEST_REQUIRE(loader.Load(mapFile.filePath));
+        gameWorld.SetupResources();
+        gameWorld.InitAfterLoad();
+        hasMoreCmds = replay.ReadGF(&nextGF);
+    }
+
+    unsigned getCurrentGF() const { return game->em_->GetCurrentGF(); }
+    AsyncChecksum getChecksum() const { return AsyncChecksum::create(*game); }
+    unsigned getNumCheckedChecksums() const { return numCheckedChecksums; }
+
+    /// Execute the commands of the current GF and run it
+    void runGF()
+    {
+        const unsigned curGF = getCurrentGF();
+        AsyncChecksum checksum;
+        if(hasMoreCmds && nextGF == curGF)
+            checksum = getChecksum();
+        while(hasMoreCmds && nextGF == curGF)
+        {
+            if(replay.ReadRCType() == ReplayCommand::Chat)
+            {
+                uint8_t player, dest;
+                std::string message;
+                replay.ReadChatCommand(player, dest, message);
+            } else
+            {
+                PlayerGameCommands cmds;
+                uint8_t player;
+                replay.ReadGameCommand(player, cmds);
+                for(const gc::GameCommandPtr& gc : cmds.gcs)
+                    gc->Execute(game->world_, player);
+                if(cmds.checksum.randChecksum != 0)
+                {
+                    BOOST_TEST_INFO("GF: " << curGF);
+                    BOOST_TEST_REQUIRE(cmds.checksum == checksum);
+                    ++numCheckedChecksums;
+                }
+            }
+            hasMoreCmds = replay.ReadGF(&nextGF);
+        }
+        game->RunGF();
+    }
+
+private:
+    Replay replay;
+    std::unique_ptr<Game> game;
+    bool hasMoreCmds;
+    unsigned nextGF;
+    unsigned numCheckedChecksums = 0;
+};
+
+const boost::filesystem::path& getReplayPath()
+{
+    static const boost::filesystem::path replayPath = rttr::test::rttrBaseDir / "tests" / "testData" / "200kGFs.rpl";
+    return replayPath;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(GFCatchUpSuite)
+
+BOOST_FIXTURE_TEST_CASE(CatchingUpIsSameAsSequentialExecution, rttr::test::MockClockFixture)
+{
+    unsigned sequentialGF;
+    AsyncChecksum sequentialChecksum;
+    {
+        ReplayGame game(getReplayPath());
+        while(game.getCurrentGF() < numGFs)
+            game.runGF();
+        sequentialGF = game.getCurrentGF();
+        sequentialChecksum = game.getChecksum();
+        BOOST_TEST(game.getNumCheckedChecksums() > 0u);
+    }
+
+    // Run the due GFs in batches limited by the time budget as the client does when it is behind.
+    // Each drawn frame takes 100ms and each GF 9ms so more GFs get due than fit into the budget
+    ReplayGame game(getReplayPath());
+    const milliseconds gfLength(20), gfTime(9), frameTime(100), maxTimePerCall(40);
+    FramesInfo::UsedClock::time_point lastGFTime = FramesInfo::UsedClock::now();
+    unsigned numCalls = 0, maxGFsPerCall = 0;
+    while(game.getCurrentGF() < numGFs)
+    {
+        currentTime += frameTime;
+        const FramesInfo::UsedClock::time_point callTime = FramesInfo::UsedClock::now();
+        GFTimeBudget budget(maxTimePerCall);
+        while(game.getCurrentGF() < numGFs && callTime - lastGFTime >= gfLength && budget.startGF())
+        {
+            lastGFTime += gfLength;
+            game.runGF();
+            currentTime += gfTime;
+        }
+        BOOST_TEST_REQUIRE((FramesInfo::UsedClock::now() - callTime <= maxTimePerCall));
+        maxGFsPerCall = std::max(maxGFsPerCall, budget.getNumGFs());
+        ++numCalls;
+    }
+    // The game fell behind and was executed in batches
+    BOOST_TEST(maxGFsPerCall > 1u);
+    BOOST_TEST(numCalls < numGFs);
+    BOOST_TEST(game.getCurrentGF() == sequentialGF);
+    BOOST_TEST(game.getChecksum() == sequentialChecksum);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
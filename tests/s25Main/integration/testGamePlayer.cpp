@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "GamePlayer.h"
+#include "Ware.h"
 #include "buildings/nobBaseWarehouse.h"
 #include "buildings/nobMilitary.h"
 #include "buildings/nobUsual.h"
@@ -11,11 +12,14 @@
 #include "ingameWindows/iwBuildingProductivities.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
+#include "nodeObjs/noFlag.h"
 #include "gameData/BuildingProperties.h"
 #include "rttr/test/random.hpp"
 #include "s25util/warningSuppression.h"
 #include <boost/test/unit_test.hpp>
+#include <memory>
 #include <numeric>
+#include <vector>
 
 using WorldFixtureEmpty2P = WorldFixture<CreateEmptyWorld, 2>;
 
@@ -111,3 +115,69 @@ BOOST_FIXTURE_TEST_CASE(ProductivityStats, WorldFixtureEmpty1P)
     BOOST_TEST(buildingRegister.CalcProductivities() == expectedProductivity, per_element());
     BOOST_TEST(buildingRegister.CalcAverageProductivity() == avgProd);
 }
+
+using WorldFixtureEmpty1PBig = WorldFixture<CreateEmptyWorld, 1>;
+
+BOOST_FIXTURE_TEST_CASE(OrderLostWare, WorldFixtureEmpty1PBig)
+{
+    GamePlayer& player = world.GetPlayer(0);
+    const MapPoint hqPos = player.GetHQPos();
+    auto* hq = world.GetSpecObj<nobBaseWarehouse>(hqPos);
+    // No warehouse can deliver it
+    BOOST_TEST_REQUIRE(hq->GetNumRealWares(GoodType::Gold) == 0u);
+    // Flags east of the HQ flag connected by roads
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    std::vector<noFlag*> flags;
+    for(unsigned i = 1; i <= 3; i++)
+    {
+        const MapPoint pt(hqFlagPos.x + 2 * i, hqFlagPos.y);
+        world.SetFlag(pt, 0);
+        world.BuildRoad(0, false, MapPoint(pt.x - 2, pt.y), {Direction::East, Direction::East});
+        flags.push_back(world.GetSpecObj<noFlag>(pt));
+        BOOST_TEST_REQUIRE(flags.back());
+    }
+    const auto addLostWare = [](noFlag& flag) {
+        auto ware = std::make_unique<Ware>(GoodType::Gold, nullptr, &flag);
+        ware->WaitAtFlag(&flag);
+        Ware* result = ware.get();
+        flag.AddWare(std::move(ware));
+        return result;
+    };
+    // Not connected -> never used
+    const MapPoint unconnectedFlagPos(hqFlagPos.x + 2, hqFlagPos.y + 4);
+    world.SetFlag(unconnectedFlagPos, 0);
+    Ware* unconnectedWare = addLostWare(*world.GetSpecObj<noFlag>(unconnectedFlagPos));
+    // Nearest one is used first, on equal distance the one registered first
+    Ware* farWare = addLostWare(*flags[2]);
+    Ware* nearWare1 = addLostWare(*flags[0]);
+    Ware* midWare = addLostWare(*flags[1]);
+    Ware* nearWare2 = addLostWare(*flags[0]);
+    for(const Ware* ware : {unconnectedWare, farWare, nearWare1, midWare, nearWare2})
+        BOOST_TEST_REQUIRE(ware->IsLostWare());
+
+    for(const Ware* ware : {nearWare1, nearWare2, midWare, farWare})
+    {
+        BOOST_TEST(player.OrderWare(GoodType::Gold, hq) == ware);
+        BOOST_TEST(ware->GetGoal() == hq);
+    }
+    BOOST_TEST(!player.OrderWare(GoodType::Gold, hq));
+    BOOST_TEST(unconnectedWare->IsLostWare());
+
+    // Flags keep track of the wares going in each direction
+    BOOST_TEST(flags[0]->GetNumWaresForRoad(Direction::West) == 2u);
+    BOOST_TEST(flags[1]->GetNumWaresForRoad(Direction::West) == 1u);
+    BOOST_TEST(flags[1]->GetNumWaresForRoad(Direction::East) == 0u);
+    BOOST_TEST(flags[1]->GetPunishmentPoints(Direction::West) >= 2u);
+    // Wares which can't reach the HQ anymore don't want to go anywhere
+    flags[0]->DestroyRoad(Direction::West);
+    for(const noFlag* flag : flags)
+    {
+        for(const auto dir : helpers::EnumRange<Direction>{})
+            BOOST_TEST(flag->GetNumWaresForRoad(dir) == 0u);
+    }
+    // Lost wares go to the HQ again when they can reach it
+    world.BuildRoad(0, false, hqFlagPos, {Direction::East, Direction::East});
+    for(const Ware* ware : {nearWare1, nearWare2, midWare, farWare})
+        BOOST_TEST(ware->GetGoal() == hq);
+    BOOST_TEST(unconnectedWare->IsLostWare());
+}
@@ -0,0 +1,74 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "IngameMinimap.h"
+#include "RttrForeachPt.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "worldFixtures/WorldFixture.h"
+#include "nodeObjs/noGranite.h"
+#include "nodeObjs/noTree.h"
+#include "world/GameWorldViewer.h"
+#include "libsiedler2/PixelBufferBGRA.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+
+BOOST_AUTO_TEST_SUITE(MinimapTests)
+
+namespace {
+using EmptyWorldFixture2P = WorldFixture<CreateEmptyWorld, 2>;
+
+/// Minimap which allows calculating the colors with a given number of threads
+class TestMinimap : public IngameMinimap
+{
+public:
+    using IngameMinimap::IngameMinimap;
+    libsiedler2::PixelBufferBGRA calcColors(unsigned numThreads)
+    {
+        libsiedler2::PixelBufferBGRA buffer(GetMapSize().x * 2, GetMapSize().y);
+        CalcMapColors(buffer, numThreads);
+        return buffer;
+    }
+};
+
+bool buffersEqual(const libsiedler2::PixelBufferBGRA& lhs, const libsiedler2::PixelBufferBGRA& rhs)
+{
+    return lhs.getWidth() == rhs.getWidth() && lhs.getHeight() == rhs.getHeight()
+           && std::memcmp(lhs.getPixelPtr(), rhs.getPixelPtr(), lhs.getWidth() * lhs.getHeight() * 4u) == 0;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(ParallelColorsMatchSerial, EmptyWorldFixture2P)
+{
+    // Add some objects with varying brightness
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(world.GetNode(pt).obj || world.GetNode(pt).bq != BuildingQuality::Castle)
+            continue;
+        if(pt.x % 3 == 0 && pt.y % 2 == 0)
+            world.SetNO(pt, new noTree(pt, 0, 3));
+        else if(pt.x % 5 == 1 && pt.y % 3 == 1)
+            world.SetNO(pt, new noGranite(GraniteType::One, 1));
+    }
+    // Mix of visible, fogged and invisible nodes for the viewing player
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(pt.y < world.GetSize().y / 3)
+            world.SetVisibility(pt, 0, Visibility::Visible);
+        else if(pt.y < world.GetSize().y / 2)
+            world.SetVisibility(pt, 0, Visibility::FogOfWar, 0);
+    }
+
+    GameWorldViewer gwv(0, world);
+    TestMinimap minimap(gwv);
+    const libsiedler2::PixelBufferBGRA serialColors = minimap.calcColors(1);
+    for(unsigned numThreads : {2u, 3u, 8u, 0u})
+    {
+        BOOST_TEST_INFO("Threads: " << numThreads);
+        BOOST_TEST(buffersEqual(minimap.calcColors(numThreads), serialColors));
+    }
+    // Recalculating yields the same result (no random brightness)
+    BOOST_TEST(buffersEqual(minimap.calcColors(1), serialColors));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,7 @@
 
 #include "RttrForeachPt.h"
 #include "helpers/OptionalIO.h"
+#include "pathfinding/WalkableComponents.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
 #include "nodeObjs/noGranite.h"
@@ -24,6 +25,7 @@ BOOST_AUTO_TEST_SUITE(PathfindingSuite)
 namespace {
 using WorldFixtureEmpty0P = WorldFixture<CreateEmptyWorld, 0>;
 using WorldFixtureEmpty1P = WorldFixture<CreateEmptyWorld, 1>;
+using WorldFixtureIslands = WorldFixture<CreateEmptyWorld, 0, 20, 8>;
 
 /// Sets all terrain to the given terrain
 void clearWorld(GameWorld& world, DescIdx<TerrainDesc> terrain)
@@ -290,4 +292,47 @@ BOOST_FIXTURE_TEST_CASE(BlockedPaths, WorldFixtureEmpty0P)
     BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, surroundingPts2[0]));
 }
 
+BOOST_FIXTURE_TEST_CASE(SeparatedIslands, WorldFixtureIslands)
+{
+    const WorldDescription& desc = world.GetDescription();
+    DescIdx<TerrainDesc> tLand(0);
+    for(; tLand.value < desc.terrain.size(); tLand.value++)
+    {
+        if(desc.get(tLand).kind == TerrainKind::Land && desc.get(tLand).Is(ETerrain::Walkable))
+            break;
+    }
+    clearWorld(world, tLand);
+    // 2 stripes of water (map wraps around) wide enough that no node in between is walkable
+    // -> Islands with x in [6, 11] and [16, 1]
+    BOOST_TEST_REQUIRE(setWaterStripes(world, {{2, 5}, {12, 15}}));
+    WalkableComponents& components = world.GetWalkableComponents();
+    const MapPoint startPt(7, 3), sameIslandPt(10, 5), otherIslandPt(18, 3);
+    BOOST_TEST(components.mayBeReachable(startPt, sameIslandPt));
+    BOOST_TEST(world.FindHumanPath(startPt, sameIslandPt));
+    BOOST_TEST(!components.mayBeReachable(startPt, otherIslandPt));
+    BOOST_TEST(!components.mayBeReachable(otherIslandPt, startPt));
+    BOOST_TEST(!world.FindHumanPath(startPt, otherIslandPt));
+    BOOST_TEST(!world.FindHumanPath(otherIslandPt, startPt));
+
+    // Objects are ignored: Still "reachable" but no path
+    for(unsigned y = 0; y < world.GetHeight(); y++)
+        world.SetNO(MapPoint(8, y), new noGranite(GraniteType::One, 1));
+    BOOST_TEST(components.mayBeReachable(startPt, sameIslandPt));
+    BOOST_TEST(!world.FindHumanPath(startPt, sameIslandPt));
+    for(unsigned y = 0; y < world.GetHeight(); y++)
+        world.DestroyNO(MapPoint(8, y));
+
+    // Changing the terrain connects the islands
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        if(pt.x >= 12 && pt.x <= 15)
+        {
+            MapNode& node = world.GetNodeWriteable(pt);
+            node.t1 = node.t2 = tLand;
+        }
+    }
+    BOOST_TEST(components.mayBeReachable(startPt, otherIslandPt));
+    BOOST_TEST(world.FindHumanPath(startPt, otherIslandPt));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "PointOutput.h"
+#include "pathfinding/RoadNetworkComponents.h"
+#include "worldFixtures/WorldWithGCExecution.h"
+#include "nodeObjs/noFlag.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace {
+using RoadNetworkFixture = WorldWithGCExecution<1, 24, 24>;
+
+/// Check that the components give the same answer as the path finding for all pairs of road nodes
+void checkMatchesPathfinding(GameWorld& world, const std::vector<MapPoint>& nodePositions)
+{
+    RoadNetworkComponents components;
+    for(const MapPoint startPt : nodePositions)
+    {
+        const auto* start = world.GetSpecObj<noRoadNode>(startPt);
+        if(!start)
+            continue;
+        for(const MapPoint goalPt : nodePositions)
+        {
+            const auto* goal = world.GetSpecObj<noRoadNode>(goalPt);
+            if(!goal || goal == start)
+                continue;
+            BOOST_TEST_CONTEXT("Start: " << startPt << ", Goal: " << goalPt)
+            {
+                const bool pathExists = world.FindPathForWareOnRoads(*start, *goal) != RoadPathDirection::None;
+                BOOST_TEST(components.isReachable(*start, *goal) == pathExists);
+                BOOST_TEST(components.isUnreachable(*start, *goal) == !pathExists);
+            }
+        }
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(RoadNetworkComponentsSuite)
+
+BOOST_FIXTURE_TEST_CASE(MatchesPathfinding, RoadNetworkFixture)
+{
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    // 2 rows of flags connected horizontally and vertically:
+    // HQ
+    //  |
+    // F-F-F-F-F
+    // |   |   |
+    // F-F-F-F-F
+    const std::vector<Direction> down{Direction::SouthEast, Direction::SouthWest, Direction::SouthEast,
+                                      Direction::SouthWest};
+    const MapPoint row1Center = world.GetNeighbour(world.GetNeighbour(hqFlagPos, Direction::SouthEast),
+                                                   Direction::SouthWest);
+    std::vector<MapPoint> nodePositions{hqPos, hqFlagPos};
+    std::vector<std::vector<MapPoint>> rows(2);
+    for(unsigned row = 0; row < rows.size(); row++)
+    {
+        for(int offset = -4; offset <= 4; offset += 2)
+        {
+            MapPoint pt(row1Center.x + offset, row1Center.y + row * 4);
+            world.SetFlag(pt, curPlayer);
+            BOOST_TEST_REQUIRE(world.GetSpecObj<noFlag>(pt));
+            rows[row].push_back(pt);
+            nodePositions.push_back(pt);
+        }
+    }
+    world.BuildRoad(curPlayer, false, hqFlagPos, {Direction::SouthEast, Direction::SouthWest});
+    for(unsigned row = 0; row < rows.size(); row++)
+    {
+        for(unsigned i = 0; i + 1 < rows[row].size(); i++)
+            world.BuildRoad(curPlayer, false, rows[row][i], {Direction::East, Direction::East});
+    }
+    for(unsigned i = 0; i < rows[0].size(); i += 2)
+        world.BuildRoad(curPlayer, false, rows[0][i], down);
+    // A separate part of the network (between the rows)
+    const MapPoint isolatedFlag(row1Center.x - 2, row1Center.y + 2);
+    world.SetFlag(isolatedFlag, curPlayer);
+    BOOST_TEST_REQUIRE(world.GetSpecObj<noFlag>(isolatedFlag));
+    nodePositions.push_back(isolatedFlag);
+
+    checkMatchesPathfinding(world, nodePositions);
+    // Demolish roads which splits the network step by step
+    for(const MapPoint flagToDestroy : {rows[0][1], rows[0][2], rows[1][3], rows[1][0]})
+    {
+        BOOST_TEST_CONTEXT("Destroyed: " << flagToDestroy)
+        {
+            world.DestroyFlag(flagToDestroy, curPlayer);
+            BOOST_TEST_REQUIRE(!world.GetSpecObj<noFlag>(flagToDestroy));
+            checkMatchesPathfinding(world, nodePositions);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
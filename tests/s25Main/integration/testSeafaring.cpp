@@ -212,13 +212,13 @@ BOOST_FIXTURE_TEST_CASE(ExplorationExpedition, ShipReadyFixture<>)
     BOOST_TEST_REQUIRE(ship->GetHomeHarbor() == 0u);
 
     // We want the ship to only scout unexplored harbors, so set all but one to visible
-    world.GetNodeWriteable(world.GetHarborPoint(6)).fow[curPlayer].visibility = Visibility::Visible; //-V807
+    world.GetFoWNodeWriteable(world.GetHarborPoint(6), curPlayer).visibility = Visibility::Visible; //-V807
     // Team visibility, so set one to own team
     world.GetPlayer(curPlayer).team = Team::Team1;
     world.GetPlayer(1).team = Team::Team1;
     world.GetPlayer(curPlayer).MakeStartPacts();
     world.GetPlayer(1).MakeStartPacts();
-    world.GetNodeWriteable(world.GetHarborPoint(3)).fow[1].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(3), 1).visibility = Visibility::Visible;
     unsigned targetHbId = 8u;
 
     // Start again (everything is here)
@@ -236,7 +236,7 @@ BOOST_FIXTURE_TEST_CASE(ExplorationExpedition, ShipReadyFixture<>)
     BOOST_TEST_REQUIRE(ship->IsOnExplorationExpedition());
     BOOST_TEST_REQUIRE(world.CalcDistance(world.GetHarborPoint(targetHbId), ship->GetPos()) <= 2u);
     // Now the ship waits and will select the next harbor. We allow another one:
-    world.GetNodeWriteable(world.GetHarborPoint(6)).fow[curPlayer].visibility = Visibility::FogOfWar;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(6), curPlayer).visibility = Visibility::FogOfWar;
     targetHbId = 6u;
     RTTR_EXEC_TILL(350, ship->IsMoving());
     BOOST_TEST_REQUIRE(ship->GetHomeHarbor() == hbId);
@@ -248,7 +248,7 @@ BOOST_FIXTURE_TEST_CASE(ExplorationExpedition, ShipReadyFixture<>)
     BOOST_TEST_REQUIRE(world.CalcDistance(world.GetHarborPoint(targetHbId), ship->GetPos()) <= 2u);
 
     // Now disallow the first harbor so ship returns home
-    world.GetNodeWriteable(world.GetHarborPoint(8)).fow[curPlayer].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(8), curPlayer).visibility = Visibility::Visible;
 
     RTTR_EXEC_TILL(350, ship->IsMoving());
     BOOST_TEST_REQUIRE(ship->GetHomeHarbor() == hbId);
@@ -261,7 +261,7 @@ BOOST_FIXTURE_TEST_CASE(ExplorationExpedition, ShipReadyFixture<>)
     BOOST_TEST_REQUIRE(ship->GetPos() == world.GetCoastalPoint(hbId, 1));
 
     // Now try to start an expedition but all harbors are explored -> Load, Unload, Idle
-    world.GetNodeWriteable(world.GetHarborPoint(6)).fow[curPlayer].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(6), curPlayer).visibility = Visibility::Visible;
     this->StartStopExplorationExpedition(hbPos, true);
     BOOST_TEST_REQUIRE(ship->IsOnExplorationExpedition());
     RTTR_EXEC_TILL(2 * 200 + 5, ship->IsIdling());
@@ -286,8 +286,8 @@ BOOST_FIXTURE_TEST_CASE(DestroyHomeOnExplExp, ShipReadyFixture<2>)
     world.GetPlayer(curPlayer).MakeStartPacts();
     world.GetPlayer(1).MakeStartPacts();
 
-    world.GetNodeWriteable(world.GetHarborPoint(6)).fow[1].visibility = Visibility::Visible;
-    world.GetNodeWriteable(world.GetHarborPoint(3)).fow[1].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(6), 1).visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(3), 1).visibility = Visibility::Visible;
     unsigned targetHbId = 8u;
     this->StartStopExplorationExpedition(hbPos, true);
 
@@ -303,7 +303,7 @@ BOOST_FIXTURE_TEST_CASE(DestroyHomeOnExplExp, ShipReadyFixture<2>)
     // Run till ship is coming back
     RTTR_EXEC_TILL(1000, ship->GetTargetHarbor() == hbId);
     // Avoid that it goes back to that point
-    world.GetNodeWriteable(world.GetHarborPoint(targetHbId)).fow[1].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(targetHbId), 1).visibility = Visibility::Visible;
 
     // Destroy home harbor
     world.DestroyNO(hbPos);
@@ -461,8 +461,8 @@ BOOST_FIXTURE_TEST_CASE(LongDistanceTravel, ShipReadyFixtureBig)
     harbor.AddGoods(newScouts, true);
     // We want the ship to only scout unexplored harbors, so set all but one to visible
     for(unsigned i = 1; i <= 8; i++)
-        world.GetNodeWriteable(world.GetHarborPoint(i)).fow[curPlayer].visibility = Visibility::Visible;
-    world.GetNodeWriteable(world.GetHarborPoint(targetHbId)).fow[curPlayer].visibility = Visibility::Invisible;
+        world.GetFoWNodeWriteable(world.GetHarborPoint(i), curPlayer).visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(targetHbId), curPlayer).visibility = Visibility::Invisible;
     // Start an exploration expedition
     this->StartStopExplorationExpedition(hbPos, true);
     BOOST_TEST_REQUIRE(harbor.IsExplorationExpeditionActive());
@@ -535,6 +535,37 @@ void destroyBldAndFire(GameWorldBase& world, const MapPoint& pos)
 }
 } // namespace
 
+BOOST_FIXTURE_TEST_CASE(ShipConnectionsUpdated, ShipAndHarborsReadyFixture<1>)
+{
+    const auto* hb1 = world.GetSpecObj<nobHarborBuilding>(world.GetHarborPoint(1));
+    const auto* hb2 = world.GetSpecObj<nobHarborBuilding>(world.GetHarborPoint(2));
+    BOOST_TEST_REQUIRE(hb1);
+    BOOST_TEST_REQUIRE(hb2);
+    const auto checkConnections = [this, hb1](const std::vector<const nobHarborBuilding*>& expectedHarbors) {
+        const auto& connections = hb1->GetShipConnections();
+        BOOST_TEST_REQUIRE(connections.size() == expectedHarbors.size());
+        for(unsigned i = 0; i < connections.size(); i++)
+        {
+            BOOST_TEST(connections[i].dest == expectedHarbors[i]);
+            const unsigned distance =
+              world.CalcHarborDistance(hb1->GetHarborPosID(), expectedHarbors[i]->GetHarborPosID());
+            BOOST_TEST(connections[i].way_costs == 2 * distance + 10);
+        }
+    };
+    // Own harbor is included
+    checkConnections({hb1, hb2});
+    const unsigned numCalcs = hb1->GetNumShipConnectionCalcs();
+    BOOST_TEST(numCalcs >= 1u);
+    // Cached result stays the same
+    checkConnections({hb1, hb2});
+    BOOST_TEST(hb1->GetNumShipConnectionCalcs() == numCalcs);
+    const nobHarborBuilding& hb3 = createHarbor(3);
+    checkConnections({hb1, hb2, &hb3});
+    BOOST_TEST(hb1->GetNumShipConnectionCalcs() > numCalcs);
+    destroyBldAndFire(world, world.GetHarborPoint(2));
+    checkConnections({hb1, &hb3});
+}
+
 BOOST_FIXTURE_TEST_CASE(HarborDestroyed, ShipAndHarborsReadyFixture<1>)
 {
     const GamePlayer& player = world.GetPlayer(curPlayer);
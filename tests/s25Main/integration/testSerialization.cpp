@@ -19,9 +19,11 @@
 #include "figures/nofHunter.h"
 #include "helpers/format.hpp"
 #include "network/GameMessage_Chat.h"
+#include "network/GameMessage_GameCommand.h"
 #include "network/PlayerGameCommands.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/MockLocalGameState.h"
+#include "worldFixtures/ReplayHelpers.h"
 #include "worldFixtures/WorldFixture.h"
 #include "world/MapLoader.h"
 #include "nodeObjs/noAnimal.h"
@@ -29,12 +31,16 @@
 #include "nodeObjs/noFlag.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "gameTypes/MapInfo.h"
+#include "test/testConfig.h"
 #include "s25util/tmpFile.h"
 #include <rttr/test/random.hpp>
 #include <rttr/test/testHelpers.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <memory>
+#include <stdexcept>
 
 // LCOV_EXCL_START
 BOOST_TEST_DONT_PRINT_LOG_VALUE(Resource)
@@ -164,6 +170,28 @@ void CheckReplayCmds(Replay& loadReplay, const PlayerGameCommands& recordedCmds)
     BOOST_TEST_REQUIRE(!loadReplay.ReadGF(&gf));
     BOOST_TEST_REQUIRE(gf == 0xFFFFFFFF);
 }
+
+/// Records a replay, sums up the sizes of the game commands in the compact and the previous encoding and counts the
+/// elided checksums
+struct ReplaySizeCounter : Replay
+{
+    size_t numCompactBytes = 0, numLegacyBytes = 0;
+    unsigned numElidedChecksums = 0;
+
+    void addGameCommand(unsigned gf, uint8_t player, const PlayerGameCommands& cmds)
+    {
+        if(!StoresChecksum(gf, cmds.checksum))
+            ++numElidedChecksums;
+        // A full chunk is written before the command is added
+        const unsigned oldLength = StartsChunk(gf) ? 0u : chunkData_.GetLength();
+        AddGameCommand(gf, player, cmds);
+        numCompactBytes += chunkData_.GetLength() - oldLength;
+        Serializer ser;
+        cmds.Serialize(ser);
+        // GF, type and player followed by checksum, number of commands and the commands
+        numLegacyBytes += sizeof(uint32_t) + 2 * sizeof(uint8_t) + ser.GetLength();
+    }
+};
 } // namespace
 
 BOOST_AUTO_TEST_SUITE(Serialization)
@@ -375,6 +403,37 @@ BOOST_FIXTURE_TEST_CASE(BaseSaveLoad, RandWorldFixture)
     }
 }
 
+BOOST_AUTO_TEST_CASE(SavegameGameDataIsDecompressedWhileReading)
+{
+    // Bigger than the buffers used for reading and decompressing
+    std::vector<unsigned char> gameData(300 * 1024);
+    for(unsigned char& value : gameData)
+        value = static_cast<unsigned char>(rttr::test::randomValue(0, 15));
+    Savegame save;
+    save.sgd.PushRawData(gameData.data(), gameData.size());
+    TmpFile tmpFile;
+    BOOST_TEST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    BOOST_TEST_REQUIRE(save.Save(tmpFile.filePath, "MapTitle"));
+    {
+        Savegame loadSave;
+        BOOST_TEST_REQUIRE(loadSave.Load(tmpFile.filePath, SaveGameDataToLoad::All));
+        BOOST_REQUIRE_EQUAL_COLLECTIONS(loadSave.sgd.GetData(), loadSave.sgd.GetData() + loadSave.sgd.GetLength(),
+                                        gameData.begin(), gameData.end());
+    }
+    // Corrupt the compressed game data at the end of the file
+    {
+        boost::nowide::fstream file(tmpFile.filePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-1000, std::ios::end);
+        const auto value = static_cast<char>(~file.get());
+        file.seekp(-1000, std::ios::end);
+        file.put(value);
+        BOOST_TEST_REQUIRE(file.good());
+    }
+    Savegame loadSave;
+    BOOST_TEST(!loadSave.Load(tmpFile.filePath, SaveGameDataToLoad::All));
+}
+
 struct ReplayMapFixture
 {
     MapInfo map;
@@ -547,6 +606,151 @@ BOOST_FIXTURE_TEST_CASE(BrokenReplayWithMap, ReplayMapFixture)
     CheckReplayCmds(loadReplay, cmds);
 }
 
+BOOST_FIXTURE_TEST_CASE(ReplayWithManyChunks, ReplayMapFixture)
+{
+    Game game(GlobalGameSettings(), 0u, players);
+    const PlayerGameCommands cmds = GetTestCommands().create(game).result;
+    TmpFile tmpFile;
+    BOOST_TEST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    bfs::remove(tmpFile.filePath);
+
+    const unsigned lastGF = 3 * Replay::GFS_PER_CHUNK + 42;
+    {
+        ReplaySizeCounter replay;
+        for(const BasePlayerInfo& player : players)
+            replay.AddPlayer(player);
+        BOOST_TEST_REQUIRE(replay.StartRecording(tmpFile.filePath, map));
+        unsigned numCmds = 0;
+        for(unsigned gf = 0; gf <= lastGF; gf += 7)
+        {
+            replay.addGameCommand(gf, gf % 4, cmds);
+            ++numCmds;
+            if(gf % 100 == 0)
+                replay.AddChatCommand(gf, 1, ChatDestination::All, std::to_string(gf));
+            replay.UpdateLastGF(gf);
+        }
+        replay.UpdateLastGF(lastGF);
+        BOOST_TEST_REQUIRE(replay.StopRecording());
+        // Same checksum everywhere: Only stored by the first game command of each of the 4 chunks
+        BOOST_TEST(replay.numElidedChecksums == numCmds - 4u);
+    }
+
+    Replay loadReplay;
+    BOOST_TEST_REQUIRE(loadReplay.LoadHeader(tmpFile.filePath));
+    BOOST_TEST_REQUIRE(loadReplay.GetLastGF() == lastGF);
+    MapInfo newMap;
+    BOOST_TEST_REQUIRE(loadReplay.LoadGameData(newMap));
+    BOOST_TEST(newMap.mapData.data == map.mapData.data, boost::test_tools::per_element());
+    for(unsigned gf = 0; gf <= lastGF; gf += 7)
+    {
+        unsigned readGF;
+        BOOST_TEST_REQUIRE(loadReplay.ReadGF(&readGF));
+        BOOST_TEST_REQUIRE(readGF == gf);
+        BOOST_TEST_REQUIRE(loadReplay.ReadRCType() == ReplayCommand::Game);
+        uint8_t player;
+        PlayerGameCommands readCmds;
+        loadReplay.ReadGameCommand(player, readCmds);
+        BOOST_TEST_REQUIRE(player == gf % 4);
+        BOOST_TEST_REQUIRE(readCmds.checksum == cmds.checksum);
+        BOOST_TEST_REQUIRE(readCmds.gcs.size() == cmds.gcs.size());
+        if(gf % 100 == 0)
+        {
+            BOOST_TEST_REQUIRE(loadReplay.ReadGF(&readGF));
+            BOOST_TEST_REQUIRE(readGF == gf);
+            BOOST_TEST_REQUIRE(loadReplay.ReadRCType() == ReplayCommand::Chat);
+            uint8_t dst;
+            std::string txt;
+            loadReplay.ReadChatCommand(player, dst, txt);
+            BOOST_TEST_REQUIRE(player == 1u);
+            BOOST_TEST_REQUIRE(txt == std::to_string(gf));
+        }
+    }
+    unsigned readGF;
+    BOOST_TEST_REQUIRE(!loadReplay.ReadGF(&readGF));
+    BOOST_TEST_REQUIRE(readGF == 0xFFFFFFFF);
+}
+
+BOOST_AUTO_TEST_CASE(ConvertOldReplay)
+{
+    // Replays in the old format compressed as a whole
+    for(const char* replayName : {"200kGFs.rpl", "SeaMap300kGfs.rpl"})
+    {
+        BOOST_TEST_CONTEXT("Replay " << replayName)
+        {
+            const bfs::path oldReplayPath = rttr::test::rttrBaseDir / "tests" / "testData" / replayName;
+            TmpFile tmpFile;
+            BOOST_TEST_REQUIRE(tmpFile.isValid());
+            tmpFile.close();
+            bfs::remove(tmpFile.filePath);
+            {
+                ReplaySizeCounter newReplay;
+                BOOST_TEST_REQUIRE(convertReplay(
+                  oldReplayPath, newReplay, tmpFile.filePath,
+                  [&newReplay](unsigned gf, uint8_t player, const PlayerGameCommands& cmds) {
+                      newReplay.addGameCommand(gf, player, cmds);
+                  }));
+                BOOST_TEST_MESSAGE(replayName << ": Game commands take " << newReplay.numCompactBytes
+                                              << " bytes instead of " << newReplay.numLegacyBytes);
+                // GF deltas and elided checksums make the commands smaller before compression
+                BOOST_TEST(newReplay.numCompactBytes > 0u);
+                BOOST_TEST(newReplay.numCompactBytes < newReplay.numLegacyBytes);
+            }
+
+            // Both must contain the same commands
+            Replay oldReplay, newReplay;
+            MapInfo oldMap, newMap;
+            BOOST_TEST_REQUIRE(oldReplay.LoadHeader(oldReplayPath));
+            BOOST_TEST_REQUIRE(newReplay.LoadHeader(tmpFile.filePath));
+            // The chunked format has a new version so older programs reject it
+            BOOST_TEST(oldReplay.GetFileVersion() == oldReplay.GetMinReadableVersion());
+            BOOST_TEST(newReplay.GetFileVersion() == newReplay.GetVersion());
+            BOOST_TEST(newReplay.GetFileVersion() > oldReplay.GetFileVersion());
+            BOOST_TEST(newReplay.GetLastGF() == oldReplay.GetLastGF());
+            BOOST_TEST_REQUIRE(oldReplay.LoadGameData(oldMap));
+            BOOST_TEST_REQUIRE(newReplay.LoadGameData(newMap));
+            BOOST_TEST(newReplay.random_init == oldReplay.random_init);
+            BOOST_TEST(newMap.mapData.data == oldMap.mapData.data, boost::test_tools::per_element());
+            unsigned oldGF, newGF;
+            unsigned numCmds = 0;
+            while(oldReplay.ReadGF(&oldGF))
+            {
+                BOOST_TEST_REQUIRE(newReplay.ReadGF(&newGF));
+                BOOST_TEST_REQUIRE(newGF == oldGF);
+                const ReplayCommand rc = oldReplay.ReadRCType();
+                BOOST_TEST_REQUIRE(newReplay.ReadRCType() == rc);
+                uint8_t oldPlayer, newPlayer;
+                if(rc == ReplayCommand::Chat)
+                {
+                    uint8_t oldDst, newDst;
+                    std::string oldTxt, newTxt;
+                    oldReplay.ReadChatCommand(oldPlayer, oldDst, oldTxt);
+                    newReplay.ReadChatCommand(newPlayer, newDst, newTxt);
+                    BOOST_TEST_REQUIRE(newDst == oldDst);
+                    BOOST_TEST_REQUIRE(newTxt == oldTxt);
+                } else
+                {
+                    PlayerGameCommands oldCmds, newCmds;
+                    oldReplay.ReadGameCommand(oldPlayer, oldCmds);
+                    newReplay.ReadGameCommand(newPlayer, newCmds);
+                    // Including the elided checksums
+                    Serializer oldSer, newSer;
+                    oldCmds.Serialize(oldSer);
+                    newCmds.Serialize(newSer);
+                    BOOST_REQUIRE_EQUAL_COLLECTIONS(oldSer.GetData(), oldSer.GetData() + oldSer.GetLength(),
+                                                    newSer.GetData(), newSer.GetData() + newSer.GetLength());
+                }
+                BOOST_TEST_REQUIRE(newPlayer == oldPlayer);
+                ++numCmds;
+            }
+            BOOST_TEST(numCmds > 0u);
+            BOOST_TEST(!newReplay.ReadGF(&newGF));
+            // Compressed in chunks the replay should not be much bigger
+            BOOST_TEST(bfs::file_size(tmpFile.filePath) < bfs::file_size(oldReplayPath) * 2u);
+        }
+    }
+}
+
 BOOST_FIXTURE_TEST_CASE(ReplayWithSavegame, RandWorldFixture)
 {
     MapInfo map;
@@ -701,4 +905,95 @@ BOOST_AUTO_TEST_CASE(SerializeGameMessageChat)
     BOOST_TEST(newMsgChat->text == msg.text);
 }
 
+BOOST_FIXTURE_TEST_CASE(SerializeGameMessageGameCommand, EmptyWorldFixture1P)
+{
+    const PlayerGameCommands cmds = GetTestCommands().create(*game).result;
+    const GameMessage_GameCommand msg(1, cmds.checksum, cmds.gcs);
+    BOOST_TEST(msg.getNumGCs() == cmds.gcs.size());
+    Serializer ser;
+    msg.Serialize(ser);
+    std::unique_ptr<Message> newMsg(GameMessage::create_game(msg.getId()));
+    BOOST_TEST_REQUIRE(!!newMsg);
+    newMsg->Deserialize(ser);
+    BOOST_TEST(ser.GetBytesLeft() == 0u);
+    const auto* receivedMsg = dynamic_cast<GameMessage_GameCommand*>(newMsg.get());
+    BOOST_TEST_REQUIRE(receivedMsg);
+    BOOST_TEST(receivedMsg->player == 1u);
+    BOOST_TEST(receivedMsg->checksum == cmds.checksum);
+    BOOST_TEST(receivedMsg->getNumGCs() == cmds.gcs.size());
+
+    // Forwarding (as done by the server) must not change the commands
+    const GameMessage_GameCommand fwdMsg(3, *receivedMsg);
+    Serializer fwdSer;
+    fwdMsg.Serialize(fwdSer);
+    GameMessage_GameCommand finalMsg;
+    finalMsg.Deserialize(fwdSer);
+    BOOST_TEST(finalMsg.player == 3u);
+    const PlayerGameCommands finalCmds = finalMsg.decodeCmds();
+    BOOST_TEST(finalCmds.checksum == cmds.checksum);
+    BOOST_TEST_REQUIRE(finalCmds.gcs.size() == cmds.gcs.size());
+    BOOST_TEST(dynamic_cast<gc::SetFlag*>(finalCmds.gcs[0].get()));
+    BOOST_TEST(dynamic_cast<gc::SetCoinsAllowed*>(finalCmds.gcs[1].get()));
+    for(unsigned i = 0; i < cmds.gcs.size(); i++)
+    {
+        Serializer expected, actual;
+        cmds.gcs[i]->Serialize(expected);
+        finalCmds.gcs[i]->Serialize(actual);
+        BOOST_TEST_REQUIRE(actual.GetLength() == expected.GetLength());
+        BOOST_TEST(std::equal(actual.GetData(), actual.GetData() + actual.GetLength(), expected.GetData()));
+    }
+
+    // No commands
+    const GameMessage_GameCommand emptyMsg(0, cmds.checksum, {});
+    Serializer emptySer;
+    emptyMsg.Serialize(emptySer);
+    GameMessage_GameCommand receivedEmptyMsg;
+    receivedEmptyMsg.Deserialize(emptySer);
+    BOOST_TEST(receivedEmptyMsg.getNumGCs() == 0u);
+    BOOST_TEST(receivedEmptyMsg.decodeGCs().empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(InvalidGameMessageGameCommand, EmptyWorldFixture1P)
+{
+    const PlayerGameCommands cmds = GetTestCommands().create(*game).result;
+    Serializer gcSer;
+    for(const gc::GameCommandPtr& gc : cmds.gcs)
+        gc->Serialize(gcSer);
+    // Same layout as GameMessage_GameCommand::Serialize but with custom command data
+    const auto createMsg = [&cmds](unsigned numGCs, const Serializer& gcData, unsigned dataSize) {
+        Serializer ser;
+        ser.PushUnsignedChar(1);
+        cmds.checksum.Serialize(ser);
+        ser.PushUnsignedInt(numGCs);
+        ser.PushUnsignedInt(dataSize);
+        ser.PushRawData(gcData.GetData(), dataSize);
+        GameMessage_GameCommand msg;
+        msg.Deserialize(ser);
+        return msg;
+    };
+    const unsigned numGCs = cmds.gcs.size();
+    BOOST_TEST(createMsg(numGCs, gcSer, gcSer.GetLength()).decodeGCs().size() == numGCs);
+
+    // Truncated payload
+    BOOST_CHECK_THROW(createMsg(numGCs, gcSer, gcSer.GetLength() - 1u).decodeCmds(), std::exception);
+    // Less commands than in the data
+    BOOST_CHECK_THROW(createMsg(numGCs - 1u, gcSer, gcSer.GetLength()).decodeCmds(), std::length_error);
+    // More commands than in the data
+    BOOST_CHECK_THROW(createMsg(numGCs + 1u, gcSer, gcSer.GetLength()).decodeCmds(), std::exception);
+    // Invalid command type
+    Serializer invalidSer;
+    invalidSer.PushUnsignedChar(0xFF);
+    BOOST_CHECK_THROW(createMsg(1, invalidSer, invalidSer.GetLength()).decodeCmds(), std::exception);
+
+    // Announced data size larger than the message
+    Serializer ser;
+    ser.PushUnsignedChar(1);
+    cmds.checksum.Serialize(ser);
+    ser.PushUnsignedInt(numGCs);
+    ser.PushUnsignedInt(gcSer.GetLength() + 1u);
+    ser.PushRawData(gcSer.GetData(), gcSer.GetLength());
+    GameMessage_GameCommand msg;
+    BOOST_CHECK_THROW(msg.Deserialize(ser), std::length_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -261,6 +261,13 @@ BOOST_FIXTURE_TEST_CASE(CreateTerritoryRegion, WorldFixtureEmpty2P)
         TerritoryRegion region(Position(0, 0), Extent(world.GetSize()), world);
         sortedMilitaryBlds buildings = world.LookForMilitaryBuildings(MapPoint(0, 0), 99);
         BOOST_TEST_REQUIRE(buildings.size() == 5u);
+        // Visitor must find every building exactly once
+        std::multiset<const nobBaseMilitary*> visitedBlds;
+        world.CheckMilitaryBuildings(MapPoint(0, 0), 99, [&visitedBlds](const nobBaseMilitary* bld) {
+            visitedBlds.insert(bld);
+            return false;
+        });
+        BOOST_TEST_REQUIRE(visitedBlds == std::multiset<const nobBaseMilitary*>(buildings.begin(), buildings.end()));
         for(const nobBaseMilitary* bld : buildings)
             region.CalcTerritoryOfBuilding(*bld);
         // Check that TerritoryRegion assigned owners as expected
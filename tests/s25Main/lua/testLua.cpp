@@ -824,10 +824,9 @@ BOOST_AUTO_TEST_CASE(onExplored)
     std::map<int, Points> gamePtsPerPlayer;
     RTTR_FOREACH_PT(MapPoint, world.GetSize())
     {
-        const MapNode& node = world.GetNode(pt);
         for(unsigned i = 0; i < world.GetNumPlayers(); i++)
         {
-            if(node.fow[i].visibility == Visibility::Visible)
+            if(world.GetFoWNode(pt, i).visibility == Visibility::Visible)
                 gamePtsPerPlayer[i].push_back(std::pair<int, int>(pt.x, pt.y));
         }
     }
@@ -843,6 +842,89 @@ BOOST_AUTO_TEST_CASE(onExplored)
     }
 }
 
+BOOST_AUTO_TEST_CASE(BatchedEvents)
+{
+    executeLua("explored, exploredBatch, occupiedBatch, numBatches, numExploredCalls = {}, {}, {}, 0, 0\n\
+    function onExplored(player_id, x, y)\n\
+        numExploredCalls = numExploredCalls + 1\n\
+        points = explored[player_id] or {}\n\
+        table.insert(points, {x, y})\n\
+        explored[player_id] = points\n\
+    end\n\
+    function onExploredBatch(player_id, batch)\n\
+        numBatches = numBatches + 1\n\
+        points = exploredBatch[player_id] or {}\n\
+        for _, pt in ipairs(batch) do table.insert(points, {pt[1], pt[2]}) end\n\
+        exploredBatch[player_id] = points\n\
+    end");
+    initWorld();
+    // Only collected so far
+    BOOST_TEST(isLuaEqual("numBatches", "0"));
+    LuaInterfaceGame& lua = world.GetLua();
+    lua.SendBatchedEvents();
+    using Points = std::vector<std::pair<int, int>>;
+    const std::map<int, Points> luaPtsPerPlayer = getLuaState()["explored"];
+    const std::map<int, Points> batchPtsPerPlayer = getLuaState()["exploredBatch"];
+    BOOST_TEST_REQUIRE(luaPtsPerPlayer.size() == 2u);
+    // One call per point for the single event handler but only one batch per player with the same points in order
+    unsigned numPts = 0;
+    for(const auto& playerPts : luaPtsPerPlayer)
+        numPts += playerPts.second.size();
+    BOOST_TEST_REQUIRE(numPts > 2u);
+    BOOST_TEST(isLuaEqual("numExploredCalls", std::to_string(numPts)));
+    BOOST_TEST(isLuaEqual("numBatches", "2"));
+    BOOST_TEST_REQUIRE(batchPtsPerPlayer.size() == luaPtsPerPlayer.size());
+    for(const auto& playerPts : luaPtsPerPlayer)
+        BOOST_TEST(batchPtsPerPlayer.at(playerPts.first) == playerPts.second, boost::test_tools::per_element());
+    // Batches got cleared
+    lua.SendBatchedEvents();
+    BOOST_TEST(isLuaEqual("numBatches", "2"));
+    BOOST_TEST(isLuaEqual("numExploredCalls", std::to_string(numPts)));
+
+    // Handlers defined later are used too
+    executeLua("function onOccupiedBatch(player_id, batch)\n\
+        occupiedBatch[player_id] = batch\n\
+        end");
+    lua.EventOccupied(1, MapPoint(1, 2));
+    lua.EventOccupied(1, MapPoint(2, 3));
+    lua.EventOccupied(0, MapPoint(4, 5));
+    lua.SendBatchedEvents();
+    const std::map<int, Points> occupiedPts = getLuaState()["occupiedBatch"];
+    BOOST_TEST_REQUIRE(occupiedPts.size() == 2u);
+    BOOST_TEST((occupiedPts.at(0) == Points{{4, 5}}));
+    BOOST_TEST((occupiedPts.at(1) == Points{{1, 2}, {2, 3}}));
+
+    // Handlers defined by other handlers are used right away, i.e. in the same GF
+    executeLua("occupiedBatch = {}\n\
+    function onAttack(attacker, defender, count)\n\
+        function onOccupied(player_id, x, y) occupied = {player_id, x, y} end\n\
+    end");
+    lua.EventAttack(0, 1, 3);
+    lua.EventOccupied(1, MapPoint(3, 4));
+    BOOST_TEST(isLuaEqual("occupied[1]", "1"));
+    BOOST_TEST(isLuaEqual("occupied[2]", "3"));
+    BOOST_TEST(isLuaEqual("occupied[3]", "4"));
+    lua.SendBatchedEvents();
+    BOOST_TEST(isLuaEqual("#occupiedBatch[1]", "1"));
+    BOOST_TEST(isLuaEqual("occupiedBatch[1][1][1]", "3"));
+    BOOST_TEST(isLuaEqual("occupiedBatch[1][1][2]", "4"));
+
+    // Owner is passed as the player index or nil
+    executeLua("function onExploredBatch(player_id, batch)\n\
+        lastOwners = tostring(batch[1][3])..' '..tostring(batch[2][3])\n\
+        end");
+    lua.EventExplored(0, MapPoint(1, 2), 0);
+    lua.EventExplored(0, MapPoint(1, 3), 2);
+    lua.SendBatchedEvents();
+    BOOST_TEST(isLuaEqual("lastOwners", "'nil 1'"));
+
+    // Nothing collected after the handlers got removed
+    executeLua("onOccupied, onExploredBatch, onOccupiedBatch, occupiedBatch = nil, nil, nil, {}");
+    lua.EventOccupied(1, MapPoint(1, 2));
+    lua.SendBatchedEvents();
+    BOOST_TEST(isLuaEqual("next(occupiedBatch)", "nil"));
+}
+
 BOOST_AUTO_TEST_CASE(LuaPacts)
 {
     initWorld();
@@ -0,0 +1,17 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "TestServer.h"
+#include "network/GameMessage.h"
+
+/// Test server exchanging game messages
+struct GameMsgTestServer : public TestServer
+{
+    Connection acceptConnection(unsigned /*id*/, const Socket& so) override
+    {
+        return Connection(GameMessage::create_game, so);
+    }
+};
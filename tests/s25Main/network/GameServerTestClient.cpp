@@ -0,0 +1,164 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameServerTestClient.h"
+#include "RTTR_Version.h"
+#include "network/CreateServerInfo.h"
+#include "network/GameMessages.h"
+#include "gameData/MaxPlayers.h"
+#include "test/testConfig.h"
+#include "s25util/ProxySettings.h"
+#include <boost/filesystem/path.hpp>
+#include <chrono>
+#include <random>
+#include <thread>
+
+namespace {
+constexpr auto hostPassword = "HostPw";
+} // namespace
+
+bool waitFor(const std::function<bool()>& condition)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    while(!condition())
+    {
+        if(std::chrono::steady_clock::now() - startTime > std::chrono::seconds(10))
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+GameServerTestClient::GameServerTestClient(std::string name)
+    : player(GameMessageWithPlayer::NO_PLAYER_ID), name(std::move(name))
+{}
+
+bool GameServerTestClient::connect(unsigned short port)
+{
+    if(!player.socket.Connect("localhost", port, false, ProxySettings()))
+        return false;
+    player.startIOThread();
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_Player_Id& msg)
+{
+    player.playerId = msg.player;
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_Server_TypeOK& msg)
+{
+    typeStatusCodes.push_back(msg.err_code);
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_Map_ChecksumOK& msg)
+{
+    isJoined = msg.correct;
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_Player_Ready& msg)
+{
+    if(msg.ready)
+        readyPlayers.insert(msg.player);
+    else
+        readyPlayers.erase(msg.player);
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_Server_Start& /*msg*/)
+{
+    isStarted = true;
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_Server_Async& msg)
+{
+    asyncChecksums = msg.checksums;
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_GetAsyncLog& /*msg*/)
+{
+    isLogRequested = true;
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_Player_Kicked& msg)
+{
+    kicks.emplace_back(msg.player, msg.cause);
+    return true;
+}
+
+bool GameServerTestClient::OnGameMessage(const GameMessage_Chat& msg)
+{
+    chatTexts.push_back(msg.text);
+    return true;
+}
+
+GameServerTestFixture::~GameServerTestFixture()
+{
+    server.Stop();
+}
+
+bool GameServerTestFixture::startServer(const PlayerMsgLimits& msgLimits)
+{
+    const boost::filesystem::path mapPath =
+      rttr::test::rttrBaseDir / "tests" / "testData" / "maps" / "LuaFunctions.SWD";
+    if(!mapInfo.mapData.CompressFromFile(mapPath, &mapInfo.mapChecksum)
+       || !mapInfo.luaData.CompressFromFile(boost::filesystem::path(mapPath).replace_extension("lua"),
+                                            &mapInfo.luaChecksum))
+        return false;
+
+    std::mt19937 rng(std::random_device{}());
+    std::uniform_int_distribution<unsigned> portDist(49152, 65535);
+    for(unsigned i = 0; i < 10; i++)
+    {
+        const auto curPort = static_cast<unsigned short>(portDist(rng));
+        CreateServerInfo csi(ServerType::Local, curPort, "TestServer");
+        csi.msgLimits = msgLimits;
+        if(server.Start(csi, mapPath, MapType::OldMap, hostPassword))
+        {
+            port = curPort;
+            return true;
+        }
+    }
+    return false;
+}
+
+void GameServerTestFixture::runAll(const std::vector<GameServerTestClient*>& clients)
+{
+    server.Run();
+    for(GameServerTestClient* client : clients)
+        client->player.executeMsgs(*client);
+}
+
+bool GameServerTestFixture::join(const std::vector<GameServerTestClient*>& clients)
+{
+    for(GameServerTestClient* client : clients)
+    {
+        if(!client->connect(port) || !waitFor([this, &clients, client]() {
+               runAll(clients);
+               return client->hasId();
+           }))
+            return false;
+        NetworkPlayer& player = client->player;
+        player.sendMsgAsync(new GameMessage_Server_Type(ServerType::Local, rttr::version::GetRevision()));
+        player.sendMsgAsync(new GameMessage_Server_Password(client == clients.front() ? hostPassword : ""));
+        player.sendMsgAsync(new GameMessage_Player_Name(client->getId(), client->name));
+        player.sendMsgAsync(new GameMessage_Map_Checksum(mapInfo.mapChecksum, mapInfo.luaChecksum));
+        if(!waitFor([this, &clients, client]() {
+               runAll(clients);
+               return client->isJoined;
+           }))
+            return false;
+    }
+    // Only the joined players
+    GameServerTestClient& host = *clients.front();
+    for(auto id = static_cast<unsigned>(clients.size()); id < MAX_PLAYERS; id++)
+        host.player.sendMsgAsync(new GameMessage_Player_State(id, PlayerState::Locked, AI::Info()));
+    return true;
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "network/GameMessage.h"
+#include "network/GameMessageInterface.h"
+#include "network/GameMessages.h"
+#include "network/GameProtocol.h"
+#include "network/GameServer.h"
+#include "network/NetworkPlayer.h"
+#include "gameTypes/MapInfo.h"
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Wait till the condition is true. Only the failure case depends on the timeout
+bool waitFor(const std::function<bool()>& condition);
+
+/// Player connected to a GameServer doing what a GameClient would, but with a fake game
+struct GameServerTestClient : public GameMessageInterface
+{
+    NetworkPlayer player;
+    std::string name;
+    bool isJoined = false, isStarted = false, isLogRequested = false;
+    std::set<unsigned> readyPlayers;
+    std::vector<unsigned> asyncChecksums;
+    std::vector<GameMessage_Server_TypeOK::StatusCode> typeStatusCodes;
+    std::vector<std::pair<unsigned, KickReason>> kicks;
+    std::vector<std::string> chatTexts;
+
+    explicit GameServerTestClient(std::string name);
+
+    bool connect(unsigned short port);
+    uint8_t getId() const { return static_cast<uint8_t>(player.playerId); }
+    bool hasId() const { return player.playerId != GameMessageWithPlayer::NO_PLAYER_ID; }
+
+    bool OnGameMessage(const GameMessage_Player_Id& msg) override;
+    bool OnGameMessage(const GameMessage_Server_TypeOK& msg) override;
+    bool OnGameMessage(const GameMessage_Map_ChecksumOK& msg) override;
+    bool OnGameMessage(const GameMessage_Player_Ready& msg) override;
+    bool OnGameMessage(const GameMessage_Server_Start& msg) override;
+    bool OnGameMessage(const GameMessage_Server_Async& msg) override;
+    bool OnGameMessage(const GameMessage_GetAsyncLog& msg) override;
+    bool OnGameMessage(const GameMessage_Player_Kicked& msg) override;
+    bool OnGameMessage(const GameMessage_Chat& msg) override;
+};
+
+/// A GameServer running the test map with the clients joined to it
+struct GameServerTestFixture
+{
+    MapInfo mapInfo;
+    GameServer server;
+    unsigned short port = 0;
+
+    ~GameServerTestFixture();
+
+    /// Start the server on a free port. Returns false on failure
+    bool startServer(const PlayerMsgLimits& msgLimits = PlayerMsgLimits());
+    /// Run the server once and let the clients execute their received messages.
+    /// Kicked players can still handle the messages received before
+    void runAll(const std::vector<GameServerTestClient*>& clients);
+    /// Join the clients as the GameClient does. The first one is the host. Returns false on failure
+    bool join(const std::vector<GameServerTestClient*>& clients);
+};
@@ -0,0 +1,222 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameServerTestClient.h"
+#include "RttrConfig.h"
+#include "Savegame.h"
+#include "files.h"
+#include "network/AsyncLogWriter.h"
+#include "network/GameMessage_GameCommand.h"
+#include "network/GameMessages.h"
+#include "network/NetworkPlayer.h"
+#include "random/Random.h"
+#include "random/randomIO.h"
+#include "rttr/test/LogAccessor.hpp"
+#include "rttr/test/TmpFolder.hpp"
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace bfs = boost::filesystem;
+
+namespace {
+constexpr unsigned numEntries = 20;
+
+/// Fake RNG history of a player which is in sync with the others for the first numSyncEntries
+std::vector<RandomEntry> createRandomLog(unsigned numSyncEntries)
+{
+    RANDOM.Init(42);
+    for(unsigned i = 0; i < numEntries; i++)
+        RANDOM.Rand(RandomContext{__FILE__, __LINE__, i}, i < numSyncEntries ? 100 : 50);
+    return RANDOM.GetAsyncLog();
+}
+
+/// Send the log in parts as the GameClient does
+void sendAsyncLog(NetworkPlayer& player, const std::string& systemInfo, const std::vector<RandomEntry>& log)
+{
+    player.sendMsgAsync(new GameMessage_AsyncLog(systemInfo));
+    for(size_t i = 0; i < log.size(); i += 10)
+    {
+        const auto itEnd = log.begin() + std::min<size_t>(i + 10, log.size());
+        player.sendMsgAsync(
+          new GameMessage_AsyncLog(std::vector<RandomEntry>(log.begin() + i, itEnd), itEnd == log.end()));
+    }
+}
+
+/// Put the user data (e.g. logs) into a temporary folder
+struct TmpUserDataFixture
+{
+    bfs::path oldUserData;
+    rttr::test::TmpFolder tmpUserData;
+
+    TmpUserDataFixture()
+    {
+        oldUserData = RTTRCONFIG.ExpandPath("<RTTR_USERDATA>");
+        RTTRCONFIG.overridePathMapping("USERDATA", tmpUserData.get());
+        bfs::create_directories(RTTRCONFIG.ExpandPath(s25::folders::logs));
+        bfs::create_directories(RTTRCONFIG.ExpandPath(s25::folders::save));
+    }
+    ~TmpUserDataFixture() { RTTRCONFIG.overridePathMapping("USERDATA", oldUserData); }
+
+    /// Return the files in the logs folder
+    std::vector<bfs::path> getLogFiles() const
+    {
+        std::vector<bfs::path> files;
+        for(const auto& entry : bfs::directory_iterator(RTTRCONFIG.ExpandPath(s25::folders::logs)))
+            files.push_back(entry.path());
+        return files;
+    }
+};
+
+/// Server with the clients writing its logs to the temporary user data
+struct ServerWithTmpUserDataFixture : TmpUserDataFixture, GameServerTestFixture
+{};
+
+std::string readFile(const bfs::path& filePath)
+{
+    boost::nowide::ifstream file(filePath);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(AsyncLogTests, TmpUserDataFixture)
+
+BOOST_FIXTURE_TEST_CASE(FakeDesyncIsLoggedByServerInBackground, ServerWithTmpUserDataFixture)
+{
+    rttr::test::LogAccessor logAcc;
+    BOOST_TEST_REQUIRE(startServer());
+
+    GameServerTestClient host("Host"), client("Client");
+    const std::vector<GameServerTestClient*> clients{&host, &client};
+    BOOST_TEST_REQUIRE(join(clients));
+    BOOST_TEST_REQUIRE(host.getId() == 0u);
+    BOOST_TEST_REQUIRE(client.getId() == 1u);
+    for(GameServerTestClient* curClient : clients)
+        curClient->player.sendMsgAsync(new GameMessage_Player_Ready(curClient->getId(), true));
+    BOOST_TEST_REQUIRE(waitFor([&]() {
+        runAll(clients);
+        return host.readyPlayers.size() == 2u;
+    }));
+    host.player.sendMsgAsync(new GameMessage_Countdown(0));
+    BOOST_TEST_REQUIRE(waitFor([&]() {
+        runAll(clients);
+        return host.isStarted && client.isStarted;
+    }));
+
+    // The client is out of sync from the start
+    const AsyncChecksum hostChecksum(1, 2, 3, 4, 5), clientChecksum(6, 2, 3, 4, 5);
+    host.player.sendMsgAsync(new GameMessage_GameCommand(host.getId(), hostChecksum, {}));
+    client.player.sendMsgAsync(new GameMessage_GameCommand(client.getId(), clientChecksum, {}));
+    BOOST_TEST_REQUIRE(waitFor([&]() {
+        runAll(clients);
+        return host.isLogRequested && client.isLogRequested;
+    }));
+    const std::vector<unsigned> expectedChecksums{hostChecksum.getHash(), clientChecksum.getHash()};
+    BOOST_TEST(host.asyncChecksums == expectedChecksums, boost::test_tools::per_element());
+
+    // The client gets out of sync after 15 RNG calls
+    constexpr unsigned numIdentical = 15;
+    const std::vector<RandomEntry> hostLog = createRandomLog(numEntries);
+    const std::vector<RandomEntry> clientLog = createRandomLog(numIdentical);
+    sendAsyncLog(host.player, "Host system", hostLog);
+    sendAsyncLog(client.player, "Client system", clientLog);
+
+    // The server keeps running while the log is written and kicks the client
+    unsigned numRuns = 0;
+    BOOST_TEST_REQUIRE(waitFor([&]() {
+        runAll(clients);
+        ++numRuns;
+        return !host.kicks.empty() && logAcc.getLog(false).find("Async log saved") != std::string::npos;
+    }));
+    BOOST_TEST(numRuns > 0u);
+    BOOST_TEST_REQUIRE(host.kicks.size() == 1u);
+    BOOST_TEST(host.kicks[0].first == client.getId());
+    BOOST_TEST((host.kicks[0].second == KickReason::Async));
+
+    const std::vector<bfs::path> logFiles = getLogFiles();
+    BOOST_TEST_REQUIRE(logFiles.size() == 1u);
+    // Same contents as written by the server before
+    const std::string written = readFile(logFiles[0]);
+    BOOST_TEST_REQUIRE(written.substr(0, 5) == "Map: ");
+    std::stringstream expected;
+    expected << "Player  0#\t\"Host\"\nSystem info: Host system\n\tChecksum: " << hostChecksum << "\n"
+             << "Player  1 \t\"Client\"\nSystem info: Client system\n\tChecksum: " << clientChecksum << "\n"
+             << "Checksum  0: " << hostChecksum << "\nChecksum  1: " << clientChecksum << "\n";
+    for(unsigned i = 0; i < numIdentical; i++)
+        expected << "[ I ]: " << hostLog[i] << "\n";
+    for(unsigned i = numIdentical; i < numEntries; i++)
+        expected << "[C 0]: " << hostLog[i] << "\n[C 1]: " << clientLog[i] << "\n";
+    BOOST_TEST(written.substr(written.find('\n') + 1) == expected.str());
+}
+
+BOOST_AUTO_TEST_CASE(ClientLogAndSavegameAreWrittenInBackground)
+{
+    const std::vector<RandomEntry> randomLog = createRandomLog(numEntries);
+    const auto logFilePath = RTTRCONFIG.ExpandPath(s25::folders::logs) / "async_Player.log";
+    const auto saveFilePath = RTTRCONFIG.ExpandPath(s25::folders::save) / "async.sav";
+    AsyncLogWriter writer;
+    bool isFinished = false, isSuccess = false;
+    addClientAsyncLogJob(writer, logFilePath, randomLog, saveFilePath, std::make_shared<Savegame>(), "Fake map",
+                         [&isFinished, &isSuccess](bool success) {
+                             isFinished = true;
+                             isSuccess = success;
+                         });
+    // The main thread keeps running and gets the result when the files were written
+    unsigned numPolls = 0;
+    BOOST_TEST_REQUIRE(waitFor([&]() {
+        writer.poll();
+        ++numPolls;
+        return isFinished;
+    }));
+    BOOST_TEST(numPolls > 0u);
+    BOOST_TEST(isSuccess);
+    BOOST_TEST(writer.isIdle());
+
+    std::stringstream expected;
+    for(const RandomEntry& entry : randomLog)
+        expected << entry << "\n";
+    BOOST_TEST(readFile(logFilePath) == expected.str());
+    Savegame save;
+    BOOST_TEST_REQUIRE(save.Load(saveFilePath, SaveGameDataToLoad::Header));
+    BOOST_TEST(save.GetMapName() == "Fake map");
+
+    // Without a savegame only the log is written
+    isFinished = false;
+    bfs::remove(logFilePath);
+    addClientAsyncLogJob(writer, logFilePath, randomLog, saveFilePath, nullptr, "Fake map",
+                         [&isFinished, &isSuccess](bool success) {
+                             isFinished = true;
+                             isSuccess = success;
+                         });
+    writer.waitForAll();
+    BOOST_TEST(isFinished);
+    BOOST_TEST(!isSuccess);
+    BOOST_TEST(bfs::exists(logFilePath));
+}
+
+BOOST_AUTO_TEST_CASE(PendingJobsAreFinishedOnDestruction)
+{
+    unsigned numJobsRun = 0;
+    {
+        AsyncLogWriter writer;
+        for(unsigned i = 0; i < 3; i++)
+        {
+            writer.addJob([&numJobsRun]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                ++numJobsRun;
+                return true;
+            });
+        }
+    }
+    BOOST_TEST(numJobsRun == 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
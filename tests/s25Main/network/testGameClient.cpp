@@ -22,6 +22,8 @@
 #include <boost/pointer_cast.hpp>
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace bfs = boost::filesystem;
 
@@ -184,6 +186,75 @@ BOOST_DATA_TEST_CASE(ClientFollowsConnectProtocol, usesLuaScriptValues, usesLuaS
     }
 }
 
+static constexpr std::array<bool, 2> partsInOrderValues{true, false};
+BOOST_DATA_TEST_CASE(ClientDecompressesMapWhileReceiving, partsInOrderValues, partsInOrder)
+{
+    GameClient client;
+    GameMessageInterface& clientMsgInterface = client;
+    MockClientInterface callbacks;
+    client.SetInterface(&callbacks);
+    TestServer server;
+    const auto serverPort = server.tryListen();
+    BOOST_TEST_REQUIRE(serverPort >= 0);
+    mock::sequence s;
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::Initiated).once();
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::VerifyServer).once();
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::QueryPw).once();
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::QueryMapInfo).once();
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::ReceiveMap).once();
+    MOCK_EXPECT(callbacks.CI_MapPartReceived);
+
+    BOOST_TEST_REQUIRE(client.Connect("localhost", "", ServerType::Local, serverPort, false, false));
+    clientMsgInterface.OnGameMessage(GameMessage_Player_Id(1));
+    clientMsgInterface.OnGameMessage(GameMessage_Server_TypeOK(GameMessage_Server_TypeOK::StatusCode::Ok, ""));
+    clientMsgInterface.OnGameMessage(GameMessage_Server_Password("true"));
+    client.GetMainPlayer().sendQueue.clear();
+
+    const boost::filesystem::path testMapPath =
+      rttr::test::rttrBaseDir / "tests" / "testData" / "maps" / "LuaFunctions.SWD";
+    const boost::filesystem::path testLuaPath = boost::filesystem::path(testMapPath).replace_extension("lua");
+    MapInfo mapInfo;
+    mapInfo.mapData.CompressFromFile(testMapPath, &mapInfo.mapChecksum);
+    mapInfo.luaData.CompressFromFile(testLuaPath, &mapInfo.luaChecksum);
+    const auto mapDataSize = mapInfo.mapData.data.size();
+    const auto luaDataSize = mapInfo.luaData.data.size();
+    clientMsgInterface.OnGameMessage(GameMessage_Map_Info(testMapPath.filename().string(), MapType::OldMap,
+                                                          mapInfo.mapData.uncompressedLength, mapDataSize,
+                                                          mapInfo.luaData.uncompressedLength, luaDataSize));
+    client.GetMainPlayer().sendQueue.clear();
+
+    // Map in 4 parts. Out of order only the first part can be decompressed while receiving
+    constexpr unsigned numParts = 4;
+    const unsigned partSize = mapDataSize / numParts + 1;
+    std::vector<unsigned> partOrder{0, 1, 2, 3};
+    if(!partsInOrder)
+        std::swap(partOrder[1], partOrder[2]);
+    for(unsigned part : partOrder)
+    {
+        const unsigned offset = part * partSize;
+        const unsigned size = std::min<unsigned>(partSize, mapDataSize - offset);
+        clientMsgInterface.OnGameMessage(GameMessage_Map_Data(true, offset, &mapInfo.mapData.data[offset], size));
+        BOOST_TEST_REQUIRE(client.GetState() == ClientState::Connect);
+    }
+    BOOST_TEST(client.GetMainPlayer().sendQueue.empty());
+    const bfs::path playedMapPath = RTTRCONFIG.ExpandPath(s25::folders::mapsPlayed) / testMapPath.filename();
+    BOOST_TEST_REQUIRE(bfs::exists(playedMapPath));
+    // The map is already written before the lua data is received, unless it has to be decompressed at the end
+    if(partsInOrder)
+        BOOST_TEST(bfs::file_size(playedMapPath) == bfs::file_size(testMapPath));
+    else
+        BOOST_TEST(bfs::file_size(playedMapPath) < bfs::file_size(testMapPath));
+
+    MOCK_EXPECT(callbacks.CI_NextConnectState).in(s).with(ConnectState::VerifyMap).once();
+    clientMsgInterface.OnGameMessage(GameMessage_Map_Data(false, 0, mapInfo.luaData.data.data(), luaDataSize));
+    const auto msg = boost::dynamic_pointer_cast<GameMessage_Map_Checksum>(client.GetMainPlayer().sendQueue.pop());
+    BOOST_TEST_REQUIRE(msg);
+    BOOST_TEST(msg->mapChecksum == mapInfo.mapChecksum);
+    BOOST_TEST(msg->luaChecksum == mapInfo.luaChecksum);
+    BOOST_TEST(bfs::file_size(playedMapPath) == bfs::file_size(testMapPath));
+    BOOST_TEST(client.GetState() == ClientState::Connect);
+}
+
 BOOST_AUTO_TEST_CASE(ClientDetectsMapBufferOverflow)
 {
     rttr::test::LogAccessor _suppressLogOutput;
@@ -0,0 +1,79 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "FileChecksum.h"
+#include "gameTypes/CompressedData.h"
+#include "rttr/test/TmpFolder.hpp"
+#include <boost/nowide/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace {
+/// Uncompressed data of the size of a map with 1024x1024 nodes. Like the terrain layers it has runs of few values
+std::vector<char> createMapData()
+{
+    constexpr unsigned mapSize = 1024;
+    constexpr unsigned numLayers = 14;
+    std::vector<char> data(numLayers * mapSize * mapSize);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> valueDist(0, 15);
+    std::geometric_distribution<unsigned> runLengthDist(0.05);
+    for(size_t i = 0; i < data.size();)
+    {
+        const auto runEnd = std::min(data.size(), i + 1 + runLengthDist(rng));
+        std::fill(data.begin() + i, data.begin() + runEnd, static_cast<char>(valueDist(rng)));
+        i = runEnd;
+    }
+    return data;
+}
+
+std::vector<char> readFile(const boost::filesystem::path& filePath)
+{
+    boost::nowide::ifstream file(filePath, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(MapTransferTests)
+
+BOOST_AUTO_TEST_CASE(IncrementalDecompressionOfParts)
+{
+    const std::vector<char> data = createMapData();
+    const std::vector<char> compressedData = CompressedData::compress(data);
+    rttr::test::TmpFolder tmpFolder;
+    const auto filePath = tmpFolder.get() / "map.wld";
+    {
+        IncrementalDecompressor decompressor(filePath, data.size());
+        // Parts of different sizes
+        for(size_t curPos = 0, partSize = 1; curPos < compressedData.size(); partSize = partSize * 3 + 1)
+        {
+            const size_t curSize = std::min(partSize, compressedData.size() - curPos);
+            BOOST_TEST_REQUIRE(!decompressor.isFinished());
+            decompressor.add(&compressedData[curPos], curSize);
+            curPos += curSize;
+        }
+        BOOST_TEST_REQUIRE(decompressor.isFinished());
+        BOOST_TEST(decompressor.getNumBytesAdded() == compressedData.size());
+        BOOST_TEST(decompressor.getChecksum() == CalcChecksumOfBuffer(data));
+    }
+    BOOST_TEST((readFile(filePath) == data));
+
+    {
+        // Wrong uncompressed size
+        IncrementalDecompressor decompressor(filePath, data.size() - 1);
+        BOOST_CHECK_THROW(decompressor.add(compressedData.data(), compressedData.size()), std::runtime_error);
+    }
+    {
+        // Corrupted data
+        std::vector<char> corruptedData = compressedData;
+        corruptedData[corruptedData.size() / 2] ^= 0x55;
+        IncrementalDecompressor decompressor(filePath, data.size());
+        BOOST_CHECK_THROW(decompressor.add(corruptedData.data(), corruptedData.size()), std::runtime_error);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,176 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameMsgTestServer.h"
+#include "GameServerTestClient.h"
+#include "network/GameMessageInterface.h"
+#include "network/GameMessage_Chat.h"
+#include "network/GameMessages.h"
+#include "network/GameProtocol.h"
+#include "network/GameServerPlayer.h"
+#include "network/NetworkIOThread.h"
+#include "network/NetworkPlayer.h"
+#include "gameTypes/ChatDestination.h"
+#include "rttr/test/LogAccessor.hpp"
+#include "s25util/ProxySettings.h"
+#include <rttr/test/MockClock.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+struct ChatCollector : public GameMessageInterface
+{
+    std::vector<std::string> texts;
+    bool OnGameMessage(const GameMessage_Chat& msg) override
+    {
+        texts.push_back(msg.text);
+        return true;
+    }
+};
+
+/// A client connected to a player on the server side
+struct FloodFixture
+{
+    GameMsgTestServer server;
+    NetworkPlayer client;
+    std::unique_ptr<GameServerPlayer> serverPlayer;
+
+    FloodFixture() : client(1) {}
+
+    void connect(const PlayerMsgLimits& msgLimits)
+    {
+        const auto serverPort = server.tryListen();
+        BOOST_TEST_REQUIRE(serverPort >= 0);
+        BOOST_TEST_REQUIRE(
+          client.socket.Connect("localhost", static_cast<unsigned short>(serverPort), false, ProxySettings()));
+        BOOST_TEST_REQUIRE(server.run(true));
+        BOOST_TEST_REQUIRE(server.connections.size() == 1u);
+        // Only accept the connection, the player does the receiving
+        serverPlayer = std::make_unique<GameServerPlayer>(1, server.connections.front().so, msgLimits);
+        serverPlayer->startIOThread();
+    }
+
+    void sendChatMsgs(unsigned firstIdx, unsigned numMsgs)
+    {
+        for(unsigned i = firstIdx; i < firstIdx + numMsgs; i++)
+            client.sendMsgAsync(new GameMessage_Chat(1, ChatDestination::All, std::to_string(i)));
+        BOOST_TEST_REQUIRE(client.sendMsgs(-1));
+    }
+
+    /// Wait till the I/O thread received numMsgs messages in total. Returns false on timeout
+    bool waitForReceivedMsgs(unsigned numMsgs)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        while(std::chrono::steady_clock::now() - startTime < std::chrono::seconds(5))
+        {
+            if(serverPlayer->ioThread->getNumReceivedMsgs() >= numMsgs)
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(MsgFloodTests)
+
+BOOST_FIXTURE_TEST_CASE(FloodedMessagesAreQueuedBounded, FloodFixture)
+{
+    PlayerMsgLimits msgLimits;
+    msgLimits.maxQueuedMsgs = 50;
+    msgLimits.maxMsgsPerSecond = 100000;
+    connect(msgLimits);
+
+    constexpr unsigned numMsgs = 2000;
+    sendChatMsgs(0, numMsgs);
+
+    ChatCollector collector;
+    while(collector.texts.size() < numMsgs)
+    {
+        const auto numExecuted = static_cast<unsigned>(collector.texts.size());
+        BOOST_TEST_REQUIRE(waitForReceivedMsgs(std::min(numMsgs, numExecuted + msgLimits.maxQueuedMsgs)));
+        // Never more than the limit even though much more is waiting in the socket
+        BOOST_TEST_REQUIRE(serverPlayer->ioThread->getNumReceivedMsgs() - numExecuted <= msgLimits.maxQueuedMsgs);
+        // Execute the messages as the server would
+        serverPlayer->executeMsgs(collector);
+    }
+    // Nothing is lost and the order is kept
+    for(unsigned i = 0; i < numMsgs; i++)
+        BOOST_TEST_REQUIRE(collector.texts[i] == std::to_string(i));
+    BOOST_TEST(serverPlayer->countReceivedMsgs());
+    BOOST_TEST(!serverPlayer->exceedsMsgRate());
+}
+
+BOOST_FIXTURE_TEST_CASE(FloodingExceedsMsgRate, FloodFixture)
+{
+    rttr::test::MockClockFixture mockClock;
+    PlayerMsgLimits msgLimits;
+    msgLimits.maxQueuedMsgs = 1000;
+    msgLimits.maxMsgsPerSecond = 100;
+    connect(msgLimits);
+
+    ChatCollector collector;
+    // Steady rate at the limit is fine
+    unsigned numSent = 0;
+    for(unsigned i = 0; i < 3; i++)
+    {
+        sendChatMsgs(numSent, msgLimits.maxMsgsPerSecond);
+        numSent += msgLimits.maxMsgsPerSecond;
+        BOOST_TEST_REQUIRE(waitForReceivedMsgs(numSent));
+        BOOST_TEST_REQUIRE(serverPlayer->countReceivedMsgs());
+        BOOST_TEST(!serverPlayer->exceedsMsgRate());
+        serverPlayer->executeMsgs(collector);
+        mockClock.currentTime += std::chrono::seconds(1);
+    }
+
+    // Flood in one second
+    sendChatMsgs(numSent, msgLimits.maxMsgsPerSecond + 1);
+    numSent += msgLimits.maxMsgsPerSecond + 1;
+    BOOST_TEST_REQUIRE(waitForReceivedMsgs(numSent));
+    BOOST_TEST_REQUIRE(serverPlayer->countReceivedMsgs());
+    BOOST_TEST(serverPlayer->exceedsMsgRate());
+}
+
+BOOST_FIXTURE_TEST_CASE(FloodingPlayerIsKickedWhileOthersAreServed, GameServerTestFixture)
+{
+    rttr::test::LogAccessor logAcc;
+    PlayerMsgLimits msgLimits;
+    msgLimits.maxQueuedMsgs = 50;
+    msgLimits.maxMsgsPerSecond = 200;
+    BOOST_TEST_REQUIRE(startServer(msgLimits));
+    GameServerTestClient host("Host"), flooder("Flooder");
+    const std::vector<GameServerTestClient*> clients{&host, &flooder};
+    BOOST_TEST_REQUIRE(join(clients));
+
+    // Far more than allowed in one second
+    for(unsigned i = 0; i < 20 * msgLimits.maxMsgsPerSecond; i++)
+        flooder.player.sendMsgAsync(new GameMessage_Pong());
+    // Messages of the other player are still handled during the flood
+    host.player.sendMsgAsync(new GameMessage_Chat(host.getId(), ChatDestination::All, "During flood"));
+    BOOST_TEST_REQUIRE(waitFor([&]() {
+        runAll(clients);
+        return !host.kicks.empty() && !host.chatTexts.empty();
+    }));
+    BOOST_TEST_REQUIRE(host.kicks.size() == 1u);
+    BOOST_TEST(host.kicks[0].first == flooder.getId());
+    BOOST_TEST((host.kicks[0].second == KickReason::InvalidMsg));
+    BOOST_TEST(host.chatTexts.front() == "During flood");
+
+    // And afterwards
+    host.player.sendMsgAsync(new GameMessage_Chat(host.getId(), ChatDestination::All, "After flood"));
+    BOOST_TEST_REQUIRE(waitFor([&]() {
+        runAll(clients);
+        return host.chatTexts.size() == 2u;
+    }));
+    BOOST_TEST(host.chatTexts.back() == "After flood");
+    BOOST_TEST(host.kicks.size() == 1u);
+    BOOST_TEST(host.player.receiveMsgs());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
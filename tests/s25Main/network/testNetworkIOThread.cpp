@@ -0,0 +1,180 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameMsgTestServer.h"
+#include "GameServerTestClient.h"
+#include "network/GameMessageInterface.h"
+#include "network/GameMessages.h"
+#include "network/NetworkIOThread.h"
+#include "network/NetworkPlayer.h"
+#include "s25util/ProxySettings.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+struct PongCounter : public GameMessageInterface
+{
+    unsigned numPongs = 0;
+    bool OnGameMessage(const GameMessage_Pong& /*msg*/) override
+    {
+        ++numPongs;
+        return true;
+    }
+};
+
+struct ConnectedPlayerFixture
+{
+    GameMsgTestServer server;
+    NetworkPlayer player;
+
+    ConnectedPlayerFixture() : player(0)
+    {
+        const auto serverPort = server.tryListen();
+        BOOST_TEST_REQUIRE(serverPort >= 0);
+        BOOST_TEST_REQUIRE(
+          player.socket.Connect("localhost", static_cast<unsigned short>(serverPort), false, ProxySettings()));
+        BOOST_TEST_REQUIRE(server.run(true));
+        BOOST_TEST_REQUIRE(server.connections.size() == 1u);
+    }
+
+    /// Run the server till it received a message and return it
+    std::unique_ptr<Message> waitForServerMsg()
+    {
+        std::unique_ptr<Message> msg;
+        waitFor([this, &msg]() {
+            server.run();
+            if(server.connections.empty() || server.connections.front().recvQueue.empty())
+                return false;
+            msg = server.connections.front().recvQueue.pop();
+            return true;
+        });
+        return msg;
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(NetworkIOThreadTests, ConnectedPlayerFixture)
+
+BOOST_AUTO_TEST_CASE(MessagesAreTransferredWithoutOwner)
+{
+    // Queued before the start
+    player.sendMsgAsync(new GameMessage_Ping(0));
+    player.startIOThread();
+    BOOST_TEST_REQUIRE(player.ioThread);
+    NetworkIOThread& ioThread = *player.ioThread;
+    PongCounter handler;
+
+    for(unsigned i = 0; i < 3; i++)
+    {
+        if(i > 0)
+            player.sendMsgAsync(new GameMessage_Ping(0));
+        // The owner does nothing ("renders") till the reply is received
+        BOOST_TEST_REQUIRE(dynamic_cast<GameMessage_Ping*>(waitForServerMsg().get()));
+        Connection& con = server.connections.front();
+        con.sendQueue.push(new GameMessage_Pong());
+        BOOST_TEST_REQUIRE(waitFor([this, &ioThread, i]() {
+            server.run();
+            return ioThread.getNumReceivedMsgs() == i + 1u;
+        }));
+        // Executed only when the owner wants to
+        BOOST_TEST(handler.numPongs == i);
+        player.executeMsgs(handler);
+        BOOST_TEST(handler.numPongs == i + 1u);
+    }
+    BOOST_TEST(player.receiveMsgs());
+    BOOST_TEST(!ioThread.hasError());
+
+    // Closing the connection stops the thread
+    player.closeConnection();
+    BOOST_TEST(!player.ioThread);
+}
+
+BOOST_AUTO_TEST_CASE(ReceivingStopsWhenQueueIsFull)
+{
+    constexpr unsigned maxQueuedMsgs = 10;
+    constexpr unsigned numMsgs = 3 * maxQueuedMsgs;
+    player.startIOThread(maxQueuedMsgs);
+    NetworkIOThread& ioThread = *player.ioThread;
+    for(unsigned i = 0; i < numMsgs; i++)
+        server.connections.front().sendQueue.push(new GameMessage_Pong());
+    BOOST_TEST_REQUIRE(server.connections.front().sendQueue.send(server.connections.front().so, -1));
+
+    PongCounter handler;
+    for(unsigned i = 1; i <= numMsgs / maxQueuedMsgs; i++)
+    {
+        BOOST_TEST_REQUIRE(waitFor([&ioThread, i]() { return ioThread.getNumReceivedMsgs() >= i * maxQueuedMsgs; }));
+        // Does not receive more till the owner executes the messages
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        BOOST_TEST_REQUIRE(ioThread.getNumReceivedMsgs() == i * maxQueuedMsgs);
+        player.executeMsgs(handler);
+        BOOST_TEST_REQUIRE(handler.numPongs == i * maxQueuedMsgs);
+    }
+    BOOST_TEST(!ioThread.hasError());
+}
+
+BOOST_AUTO_TEST_CASE(StopFromMessageHandler)
+{
+    struct Closer : public GameMessageInterface
+    {
+        NetworkPlayer& player;
+        unsigned numPongs = 0;
+        explicit Closer(NetworkPlayer& player) : player(player) {}
+        bool OnGameMessage(const GameMessage_Pong& /*msg*/) override
+        {
+            ++numPongs;
+            player.closeConnection();
+            return true;
+        }
+    };
+    player.startIOThread();
+    const NetworkIOThread& ioThread = *player.ioThread;
+    for(unsigned i = 0; i < 2; i++)
+        server.connections.front().sendQueue.push(new GameMessage_Pong());
+    BOOST_TEST_REQUIRE(waitFor([this, &ioThread]() {
+        server.run();
+        return ioThread.getNumReceivedMsgs() == 2u;
+    }));
+    Closer handler(player);
+    player.executeMsgs(handler);
+    // Remaining messages are dropped
+    BOOST_TEST(handler.numPongs == 1u);
+    BOOST_TEST(!player.ioThread);
+}
+
+BOOST_AUTO_TEST_CASE(ConnectionLossIsReported)
+{
+    player.startIOThread();
+    const NetworkIOThread& ioThread = *player.ioThread;
+    BOOST_TEST(player.receiveMsgs());
+
+    server.connections.front().so.Close();
+    server.stop();
+    BOOST_TEST(waitFor([&ioThread]() { return ioThread.hasError(); }));
+    BOOST_TEST(!player.receiveMsgs());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_CASE(KickedPlayerReceivesMsgSentBeforeKick, GameServerTestFixture)
+{
+    BOOST_TEST_REQUIRE(startServer());
+    GameServerTestClient client("Player");
+    const std::vector<GameServerTestClient*> clients{&client};
+    BOOST_TEST_REQUIRE(client.connect(port));
+    BOOST_TEST_REQUIRE(waitFor([this, &clients, &client]() {
+        runAll(clients);
+        return client.hasId();
+    }));
+    // The server replies with the status and kicks the player right after
+    client.player.sendMsgAsync(new GameMessage_Server_Type(ServerType::Local, "InvalidRevision"));
+    BOOST_TEST_REQUIRE(waitFor([this, &clients, &client]() {
+        runAll(clients);
+        return !client.player.receiveMsgs();
+    }));
+    client.player.executeMsgs(client);
+    BOOST_TEST_REQUIRE(client.typeStatusCodes.size() == 1u);
+    BOOST_TEST((client.typeStatusCodes.front() == GameMessage_Server_TypeOK::StatusCode::WrongVersion));
+}
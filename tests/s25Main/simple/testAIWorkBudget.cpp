@@ -0,0 +1,114 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ai/aijh/AIWorkBudget.h"
+#include <boost/test/unit_test.hpp>
+#include <numeric>
+
+using AIJH::AIWorkBudget;
+
+BOOST_AUTO_TEST_SUITE(AIWorkBudgetSuite)
+
+BOOST_AUTO_TEST_CASE(BudgetIsSavedUpToMax)
+{
+    AIWorkBudget budget(10, 35);
+    BOOST_TEST(!budget.HasBudget());
+    budget.StartGF();
+    BOOST_TEST(budget.HasBudget());
+    BOOST_TEST(budget.GetAvailable() == 10u);
+    budget.AddWork(4);
+    BOOST_TEST(budget.GetAvailable() == 6u);
+    budget.StartGF();
+    BOOST_TEST(budget.GetAvailable() == 16u);
+    budget.StartGF();
+    budget.StartGF();
+    BOOST_TEST(budget.GetAvailable() == 35u);
+    budget.StartGF();
+    BOOST_TEST(budget.GetAvailable() == 35u);
+}
+
+BOOST_AUTO_TEST_CASE(ExceededBudgetIsPaidBack)
+{
+    AIWorkBudget budget(10, 20);
+    budget.StartGF();
+    budget.AddWork(9);
+    BOOST_TEST(budget.HasBudget());
+    // Work started with budget left may exceed it
+    budget.AddWork(26);
+    BOOST_TEST(!budget.HasBudget());
+    BOOST_TEST(budget.GetAvailable() == 0u);
+    BOOST_TEST(budget.GetWorkInCurrentGF() == 35u);
+    // 25 units are owed which takes 3 GFs
+    budget.StartGF();
+    BOOST_TEST(!budget.HasBudget());
+    budget.StartGF();
+    BOOST_TEST(!budget.HasBudget());
+    budget.StartGF();
+    BOOST_TEST(budget.HasBudget());
+    BOOST_TEST(budget.GetAvailable() == 5u);
+}
+
+BOOST_AUTO_TEST_CASE(MaxIsAtLeastBudgetPerGF)
+{
+    AIWorkBudget budget(10, 5);
+    BOOST_TEST(budget.GetMaxBudget() == 10u);
+    budget.StartGF();
+    BOOST_TEST(budget.GetAvailable() == 10u);
+}
+
+BOOST_AUTO_TEST_CASE(TestedNodesAreCarriedOver)
+{
+    AIWorkBudget budget(10, 20);
+    budget.StartGF();
+    // Less than a unit each time
+    for(unsigned i = 0; i < 4; i++)
+        budget.AddTestedNodes(AIWorkBudget::NODES_PER_WORK_UNIT - 1);
+    BOOST_TEST(budget.GetWorkInCurrentGF() == 3u);
+    budget.AddTestedNodes(3);
+    BOOST_TEST(budget.GetWorkInCurrentGF() == 3u);
+    budget.AddTestedNodes(1);
+    BOOST_TEST(budget.GetWorkInCurrentGF() == 4u);
+    budget.AddTestedNodes(2 * AIWorkBudget::NODES_PER_WORK_UNIT);
+    BOOST_TEST(budget.GetWorkInCurrentGF() == 6u);
+    BOOST_TEST(budget.GetAvailable() == 4u);
+}
+
+BOOST_AUTO_TEST_CASE(Buckets)
+{
+    BOOST_TEST(AIWorkBudget::GetBucket(0) == 0u);
+    BOOST_TEST(AIWorkBudget::GetBucket(1) == 1u);
+    BOOST_TEST(AIWorkBudget::GetBucket(2) == 2u);
+    BOOST_TEST(AIWorkBudget::GetBucket(3) == 2u);
+    BOOST_TEST(AIWorkBudget::GetBucket(4) == 3u);
+    BOOST_TEST(AIWorkBudget::GetBucket(7) == 3u);
+    BOOST_TEST(AIWorkBudget::GetBucket(8) == 4u);
+    BOOST_TEST(AIWorkBudget::GetBucket(100000) == AIWorkBudget::NUM_BUCKETS - 1u);
+    for(unsigned bucket = 0; bucket < AIWorkBudget::NUM_BUCKETS; bucket++)
+    {
+        const unsigned start = AIWorkBudget::GetBucketStart(bucket);
+        BOOST_TEST(AIWorkBudget::GetBucket(start) == bucket);
+        if(start > 0)
+            BOOST_TEST(AIWorkBudget::GetBucket(start - 1) == bucket - 1u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(HistogramCountsCompletedGFs)
+{
+    AIWorkBudget budget(10, 20);
+    const AIWorkBudget::Histogram& histogram = budget.GetHistogram();
+    budget.StartGF();
+    budget.AddWork(5);
+    // Current GF is not counted yet
+    BOOST_TEST(std::accumulate(histogram.begin(), histogram.end(), 0u) == 0u);
+    budget.StartGF();
+    BOOST_TEST(histogram[AIWorkBudget::GetBucket(5)] == 1u);
+    budget.StartGF();
+    budget.AddWork(1);
+    budget.StartGF();
+    BOOST_TEST(histogram[0] == 1u);
+    BOOST_TEST(histogram[1] == 1u);
+    BOOST_TEST(std::accumulate(histogram.begin(), histogram.end(), 0u) == 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GFTimeBudget.h"
+#include <rttr/test/MockClock.hpp>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <vector>
+
+using std::chrono::milliseconds;
+
+namespace {
+constexpr milliseconds maxTimePerCall(40);
+
+/// Execute at most numDueGFs GFs each taking gfTime as the client would and return the number executed
+unsigned runDueGFs(rttr::test::MockClockFixture& clock, unsigned numDueGFs, milliseconds gfTime)
+{
+    const auto startTime = clock.currentTime;
+    GFTimeBudget budget(maxTimePerCall);
+    unsigned numGFs = 0;
+    while(numGFs < numDueGFs && budget.startGF())
+    {
+        clock.currentTime += gfTime;
+        ++numGFs;
+    }
+    BOOST_TEST(budget.getNumGFs() == numGFs);
+    // Never more than the budget, except for a single GF taking longer than that
+    if(numGFs > 1u)
+        BOOST_TEST((clock.currentTime - startTime <= maxTimePerCall));
+    return numGFs;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(GFTimeBudgetSuite)
+
+BOOST_FIXTURE_TEST_CASE(CallNeverExceedsBudget, rttr::test::MockClockFixture)
+{
+    for(const milliseconds gfTime : {milliseconds(0), milliseconds(1), milliseconds(3), milliseconds(7),
+                                     milliseconds(20), milliseconds(39), milliseconds(40)})
+    {
+        BOOST_TEST_CONTEXT("GF time: " << gfTime.count() << "ms")
+        {
+            const unsigned numGFs = runDueGFs(*this, 1000, gfTime);
+            BOOST_TEST(numGFs >= 1u);
+            if(gfTime.count() > 0)
+                BOOST_TEST(numGFs == static_cast<unsigned>(maxTimePerCall / gfTime));
+            else
+                BOOST_TEST(numGFs == 1000u);
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(FirstGFIsAlwaysExecuted, rttr::test::MockClockFixture)
+{
+    BOOST_TEST(runDueGFs(*this, 10, milliseconds(100)) == 1u);
+    // Time spent before the first GF does not matter
+    GFTimeBudget budget(maxTimePerCall);
+    currentTime += milliseconds(50);
+    BOOST_TEST(budget.startGF());
+    BOOST_TEST(!budget.startGF());
+}
+
+BOOST_FIXTURE_TEST_CASE(LongestGFIsUsedAsEstimate, rttr::test::MockClockFixture)
+{
+    GFTimeBudget budget(maxTimePerCall);
+    const std::vector<unsigned> gfTimes = {5, 15, 2, 4};
+    // After 22ms the next GF might take 15ms again which is fine, after 26ms it is not
+    for(const unsigned gfTime : gfTimes)
+    {
+        BOOST_TEST_REQUIRE(budget.startGF());
+        currentTime += milliseconds(gfTime);
+    }
+    BOOST_TEST((budget.getMaxGFTime() == milliseconds(15)));
+    BOOST_TEST(!budget.startGF());
+    BOOST_TEST(budget.getNumGFs() == gfTimes.size());
+}
+
+BOOST_FIXTURE_TEST_CASE(CatchingUpRunsAllGFs, rttr::test::MockClockFixture)
+{
+    // 200 GFs are due at once (e.g. after loading) and each takes 3ms -> 13 GFs per call
+    constexpr unsigned numDueGFs = 200;
+    const milliseconds gfTime(3);
+    unsigned numGFs = 0, numCalls = 0;
+    while(numGFs < numDueGFs)
+    {
+        numGFs += runDueGFs(*this, numDueGFs - numGFs, gfTime);
+        ++numCalls;
+    }
+    BOOST_TEST(numGFs == numDueGFs);
+    BOOST_TEST(numCalls == (numDueGFs + 12u) / 13u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
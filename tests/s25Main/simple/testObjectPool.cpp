@@ -0,0 +1,91 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ObjectPool.h"
+#include "helpers/LSANUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace {
+struct PooledBase : PoolAllocated
+{
+    uint32_t value;
+    explicit PooledBase(uint32_t value) : value(value) {}
+    virtual ~PooledBase() = default;
+};
+struct PooledDerived : PooledBase
+{
+    std::array<uint32_t, 50> data;
+    explicit PooledDerived(uint32_t value) : PooledBase(value) { data.fill(value); }
+};
+
+ObjectPool::SizeClassStats getStats(size_t size)
+{
+    const size_t sizeClass = (size + ObjectPool::GRANULARITY - 1) / ObjectPool::GRANULARITY * ObjectPool::GRANULARITY;
+    const auto stats = ObjectPool::getStats();
+    const auto it = std::find_if(stats.begin(), stats.end(),
+                                 [sizeClass](const ObjectPool::SizeClassStats& cur) { return cur.size == sizeClass; });
+    return it == stats.end() ? ObjectPool::SizeClassStats{sizeClass, 0, 0, 0, 0, 0} : *it;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ObjectPoolSuite)
+
+BOOST_AUTO_TEST_CASE(AllocateAndFree)
+{
+    const auto baseStatsBefore = getStats(sizeof(PooledBase));
+    const auto derivedStatsBefore = getStats(sizeof(PooledDerived));
+    std::vector<std::unique_ptr<PooledBase>> objs;
+    std::set<const void*> addresses;
+    for(unsigned i = 0; i < 1000; i++)
+    {
+        if(i % 3 == 0)
+            objs.push_back(std::make_unique<PooledDerived>(i));
+        else
+            objs.push_back(std::make_unique<PooledBase>(i));
+        // Suitable for any type and not overlapping
+        BOOST_TEST(reinterpret_cast<uintptr_t>(objs.back().get()) % alignof(std::max_align_t) == 0u);
+        BOOST_TEST(addresses.insert(objs.back().get()).second);
+    }
+    for(unsigned i = 0; i < objs.size(); i++)
+    {
+        BOOST_TEST(objs[i]->value == i);
+        if(i % 3 == 0)
+            BOOST_TEST(static_cast<const PooledDerived&>(*objs[i]).data.back() == i);
+    }
+#if !RTTR_HAS_ASAN
+    BOOST_TEST(getStats(sizeof(PooledBase)).numLive == baseStatsBefore.numLive + 666u);
+    BOOST_TEST(getStats(sizeof(PooledDerived)).numLive == derivedStatsBefore.numLive + 334u);
+#endif
+    // Delete through base pointer
+    objs.clear();
+    const auto baseStats = getStats(sizeof(PooledBase));
+    const auto derivedStats = getStats(sizeof(PooledDerived));
+    BOOST_TEST(baseStats.numLive == baseStatsBefore.numLive);
+    BOOST_TEST(derivedStats.numLive == derivedStatsBefore.numLive);
+#if !RTTR_HAS_ASAN
+    BOOST_TEST(baseStats.numFrees == baseStatsBefore.numFrees + 666u);
+    BOOST_TEST(baseStats.maxLive >= 666u);
+
+    // Memory is reused
+    const auto slabsBefore = getStats(sizeof(PooledBase)).numSlabs;
+    for(unsigned i = 0; i < 500; i++)
+        objs.push_back(std::make_unique<PooledBase>(i));
+    BOOST_TEST(getStats(sizeof(PooledBase)).numSlabs == slabsBefore);
+    objs.clear();
+#endif
+
+    std::stringstream s;
+    ObjectPool::printStats(s);
+    BOOST_TEST(!s.str().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,7 @@
 #include "world/GameWorld.h"
 #include "world/MapLoader.h"
 #include "gameData/TerrainDesc.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -82,3 +83,28 @@ void setLeftTerrain(GameWorld& world, const MapPoint& pt, Direction dir, DescIdx
 {
     setRightTerrain(world, pt, dir - 1u, t);
 }
+
+bool setWaterStripes(GameWorld& world, const std::vector<std::pair<MapCoord, MapCoord>>& xRanges)
+{
+    const WorldDescription& desc = world.GetDescription();
+    DescIdx<TerrainDesc> tWater(0);
+    for(; tWater.value < desc.terrain.size(); tWater.value++)
+    {
+        if(desc.get(tWater).kind == TerrainKind::Water && !desc.get(tWater).Is(ETerrain::Walkable))
+            break;
+    }
+    if(tWater.value >= desc.terrain.size())
+        return false;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        const bool isWater = std::any_of(xRanges.begin(), xRanges.end(), [pt](const auto& range) {
+            return pt.x >= range.first && pt.x <= range.second;
+        });
+        if(isWater)
+        {
+            MapNode& node = world.GetNodeWriteable(pt);
+            node.t1 = node.t2 = tWater;
+        }
+    }
+    return true;
+}
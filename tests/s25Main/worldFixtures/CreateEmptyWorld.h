@@ -7,6 +7,8 @@
 #include "gameTypes/Direction.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameData/DescIdx.h"
+#include <utility>
+#include <vector>
 
 class GameWorld;
 struct TerrainDesc;
@@ -23,3 +25,6 @@ private:
 
 void setRightTerrain(GameWorld& world, const MapPoint& pt, Direction dir, DescIdx<TerrainDesc> t);
 void setLeftTerrain(GameWorld& world, const MapPoint& pt, Direction dir, DescIdx<TerrainDesc> t);
+/// Set the terrain of all nodes with x in one of the given [first, last] ranges to water which can't be walked on.
+/// Return false if there is no such terrain
+bool setWaterStripes(GameWorld& world, const std::vector<std::pair<MapCoord, MapCoord>>& xRanges);
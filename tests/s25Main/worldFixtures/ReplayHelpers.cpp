@@ -0,0 +1,59 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ReplayHelpers.h"
+#include "Replay.h"
+#include "network/PlayerGameCommands.h"
+#include "gameTypes/MapInfo.h"
+
+void readReplayCommands(Replay& replay, const OnReplayChatCmd& onChatCmd, const OnReplayGameCmd& onGameCmd)
+{
+    unsigned gf;
+    while(replay.ReadGF(&gf))
+    {
+        uint8_t player;
+        if(replay.ReadRCType() == ReplayCommand::Chat)
+        {
+            uint8_t dest;
+            std::string msg;
+            replay.ReadChatCommand(player, dest, msg);
+            if(onChatCmd)
+                onChatCmd(gf, player, ChatDestination(dest), msg);
+        } else
+        {
+            PlayerGameCommands cmds;
+            replay.ReadGameCommand(player, cmds);
+            if(onGameCmd)
+                onGameCmd(gf, player, cmds);
+        }
+    }
+}
+
+bool convertReplay(const boost::filesystem::path& oldPath, Replay& newReplay, const boost::filesystem::path& newPath,
+                   const OnReplayGameCmd& addGameCmd)
+{
+    Replay oldReplay;
+    MapInfo mapInfo;
+    if(!oldReplay.LoadHeader(oldPath) || !oldReplay.LoadGameData(mapInfo))
+        return false;
+    for(unsigned i = 0; i < oldReplay.GetNumPlayers(); i++)
+        newReplay.AddPlayer(oldReplay.GetPlayer(i));
+    newReplay.ggs = oldReplay.ggs;
+    newReplay.random_init = oldReplay.random_init;
+    if(!newReplay.StartRecording(newPath, mapInfo))
+        return false;
+    readReplayCommands(
+      oldReplay,
+      [&newReplay](unsigned gf, uint8_t player, ChatDestination dest, const std::string& msg) {
+          newReplay.AddChatCommand(gf, player, dest, msg);
+      },
+      [&newReplay, &addGameCmd](unsigned gf, uint8_t player, const PlayerGameCommands& cmds) {
+          if(addGameCmd)
+              addGameCmd(gf, player, cmds);
+          else
+              newReplay.AddGameCommand(gf, player, cmds);
+      });
+    newReplay.UpdateLastGF(oldReplay.GetLastGF());
+    return newReplay.StopRecording();
+}
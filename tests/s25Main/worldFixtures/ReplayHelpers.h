@@ -0,0 +1,25 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/ChatDestination.h"
+#include <boost/filesystem/path.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+class Replay;
+struct PlayerGameCommands;
+
+using OnReplayChatCmd = std::function<void(unsigned gf, uint8_t player, ChatDestination dest, const std::string& msg)>;
+using OnReplayGameCmd = std::function<void(unsigned gf, uint8_t player, const PlayerGameCommands& cmds)>;
+
+/// Read all remaining commands of a replay whose game data is loaded and pass them to the callbacks (if set)
+void readReplayCommands(Replay& replay, const OnReplayChatCmd& onChatCmd, const OnReplayGameCmd& onGameCmd);
+
+/// Record all commands of the replay at oldPath with its players, settings and map into newReplay at newPath.
+/// If addGameCmd is set it is used to add the game commands to newReplay. Return false on error
+bool convertReplay(const boost::filesystem::path& oldPath, Replay& newReplay, const boost::filesystem::path& newPath,
+                   const OnReplayGameCmd& addGameCmd = nullptr);